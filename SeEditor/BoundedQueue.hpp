@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <semaphore>
+#include <thread>
+#include <utility>
+
+namespace SeEditor {
+
+// Fixed-capacity multi-producer/multi-consumer FIFO. Slots are claimed with a CAS on a ring of
+// sequence-numbered cells, so producers and consumers never share a lock. Push blocks while the queue is
+// full, which is what throttles fast producers down to the speed of the consumers.
+template <typename T>
+class BoundedQueue
+{
+public:
+    // `capacity` is rounded up to a power of two (minimum 2).
+    explicit BoundedQueue(std::size_t capacity)
+        : _capacity(RoundUpPow2(capacity)),
+          _mask(_capacity - 1),
+          _cells(std::make_unique<Cell[]>(_capacity)),
+          _free(static_cast<std::ptrdiff_t>(_capacity)),
+          _filled(0)
+    {
+        for (std::size_t i = 0; i < _capacity; ++i)
+            _cells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedQueue(BoundedQueue const&) = delete;
+    BoundedQueue& operator=(BoundedQueue const&) = delete;
+
+    std::size_t Capacity() const { return _capacity; }
+
+    void Push(T value)
+    {
+        _free.acquire();
+        // A free slot is guaranteed, but the cell at the head may still be finishing a pop that started
+        // before the one that released it.
+        while (!TryEnqueue(value))
+            std::this_thread::yield();
+        _filled.release();
+    }
+
+    T Pop()
+    {
+        _filled.acquire();
+        T value;
+        while (!TryDequeue(value))
+            std::this_thread::yield();
+        _free.release();
+        return value;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> Sequence{0};
+        T Value{};
+    };
+
+    static std::size_t RoundUpPow2(std::size_t value)
+    {
+        std::size_t result = 2;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    bool TryEnqueue(T& value)
+    {
+        std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = _cells[pos & _mask];
+            const std::size_t seq = cell.Sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0)
+            {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.Value = std::move(value);
+                    cell.Sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool TryDequeue(T& value)
+    {
+        std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = _cells[pos & _mask];
+            const std::size_t seq = cell.Sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    value = std::move(cell.Value);
+                    cell.Value = T{};
+                    cell.Sequence.store(pos + _capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    const std::size_t _capacity;
+    const std::size_t _mask;
+    std::unique_ptr<Cell[]> _cells;
+    alignas(64) std::atomic<std::size_t> _enqueuePos{0};
+    alignas(64) std::atomic<std::size_t> _dequeuePos{0};
+    std::counting_semaphore<> _free;
+    std::counting_semaphore<> _filled;
+};
+
+} // namespace SeEditor
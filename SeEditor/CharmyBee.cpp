@@ -18,6 +18,7 @@
 #include "SlLib/Resources/Database/SlPlatform.hpp"
 #include "SlLib/Utilities/SlUtil.hpp"
 #include "Forest/ForestArchive.hpp"
+#include "Forest/PrimitiveIndices.hpp"
 
 #include <SlLib/Excel/ExcelData.hpp>
 #include <SlLib/Enums/TriggerPhantomHashInfo.hpp>
@@ -991,233 +992,20 @@ void BuildForestTreeMeshMaps(SeEditor::Forest::ForestLibrary const& library,
                         cpu.Vertices.push_back(0.0f);
                     }
 
-                    std::size_t availableIndices = primitive->IndexData.size() / 2;
-                    std::size_t indexCount = availableIndices;
-                    if (primitive->NumIndices > 0)
-                        indexCount = std::min(static_cast<std::size_t>(primitive->NumIndices), availableIndices);
-
-                    if (indexCount == 0)
-                        continue;
-
-                    std::size_t vertexLimit = verts.size();
-                    struct IndexMode
-                    {
-                        bool Use32 = false;
-                        bool Swap = false;
-                        std::size_t Count = 0;
-                        std::size_t Droppable = 0;
-                        std::size_t Restart = 0;
-                        std::uint32_t MaxIndex = 0;
-                    };
-
-                    auto eval16 = [&](bool swap) {
-                        IndexMode mode;
-                        mode.Use32 = false;
-                        mode.Swap = swap;
-                        mode.Count = indexCount;
-                        for (std::size_t i = 0; i < indexCount; ++i)
-                        {
-                            std::uint16_t a = primitive->IndexData[i * 2];
-                            std::uint16_t b = primitive->IndexData[i * 2 + 1];
-                            std::uint16_t idx = swap ? static_cast<std::uint16_t>((a << 8) | b)
-                                                     : static_cast<std::uint16_t>(a | (b << 8));
-                            if (idx == 0xFFFFu)
-                            {
-                                ++mode.Restart;
-                                continue;
-                            }
-                            if (idx > mode.MaxIndex)
-                                mode.MaxIndex = idx;
-                            if (static_cast<std::size_t>(idx) >= vertexLimit)
-                                ++mode.Droppable;
-                        }
-                        return mode;
-                    };
-
-                    auto eval32 = [&](bool swap) {
-                        IndexMode mode;
-                        mode.Use32 = true;
-                        mode.Swap = swap;
-                        if (primitive->IndexData.size() % 4 != 0)
-                            return mode;
-                        mode.Count = primitive->IndexData.size() / 4;
-                        if (primitive->NumIndices > 0)
-                            mode.Count = std::min<std::size_t>(mode.Count,
-                                static_cast<std::size_t>(primitive->NumIndices));
-                        for (std::size_t i = 0; i < mode.Count; ++i)
-                        {
-                            std::size_t off = i * 4;
-                            std::uint32_t idx = static_cast<std::uint32_t>(primitive->IndexData[off + 0] |
-                                (primitive->IndexData[off + 1] << 8) |
-                                (primitive->IndexData[off + 2] << 16) |
-                                (primitive->IndexData[off + 3] << 24));
-                            if (swap)
-                            {
-                                idx = ((idx & 0x000000FFu) << 24) |
-                                      ((idx & 0x0000FF00u) << 8) |
-                                      ((idx & 0x00FF0000u) >> 8) |
-                                      ((idx & 0xFF000000u) >> 24);
-                            }
-                            if (idx == 0xFFFFFFFFu)
-                            {
-                                ++mode.Restart;
-                                continue;
-                            }
-                            if (idx > mode.MaxIndex)
-                                mode.MaxIndex = idx;
-                            if (idx >= vertexLimit)
-                                ++mode.Droppable;
-                        }
-                        return mode;
-                    };
-
-                    IndexMode mode16le = eval16(false);
-                    IndexMode mode16be = eval16(true);
-                    IndexMode mode32le = eval32(false);
-                    IndexMode mode32be = eval32(true);
-
-                    IndexMode best = mode16le;
-                    if (mode16be.Droppable < best.Droppable)
-                        best = mode16be;
-                    if (mode32le.Count > 0 && mode32le.Droppable < best.Droppable)
-                        best = mode32le;
-                    if (mode32be.Count > 0 && mode32be.Droppable < best.Droppable)
-                        best = mode32be;
-
-                    bool use32Bit = best.Use32;
-                    bool swapIndices = best.Swap;
-                    std::size_t indexCount32 = best.Use32 ? best.Count : 0;
-                    std::size_t droppable = 0;
-                    std::size_t restart = 0;
-                    std::vector<std::uint32_t> rawIndices;
-                    rawIndices.reserve(best.Count);
-
-                    if (use32Bit)
-                    {
-                        for (std::size_t i = 0; i < indexCount32; ++i)
-                        {
-                            std::size_t off = i * 4;
-                            std::uint32_t idx = static_cast<std::uint32_t>(primitive->IndexData[off + 0] |
-                                (primitive->IndexData[off + 1] << 8) |
-                                (primitive->IndexData[off + 2] << 16) |
-                                (primitive->IndexData[off + 3] << 24));
-                            if (swapIndices)
-                            {
-                                idx = ((idx & 0x000000FFu) << 24) |
-                                      ((idx & 0x0000FF00u) << 8) |
-                                      ((idx & 0x00FF0000u) >> 8) |
-                                      ((idx & 0xFF000000u) >> 24);
-                            }
-                            if (idx == 0xFFFFFFFFu)
-                            {
-                                ++restart;
-                                rawIndices.push_back(idx);
-                                continue;
-                            }
-                            if (idx >= vertexLimit)
-                            {
-                                ++droppable;
-                                continue;
-                            }
-                            rawIndices.push_back(idx);
-                        }
-                    }
-                    else
-                    {
-                        for (std::size_t i = 0; i < best.Count; ++i)
-                        {
-                            std::uint16_t a = primitive->IndexData[i * 2];
-                            std::uint16_t b = primitive->IndexData[i * 2 + 1];
-                            std::uint16_t idx = swapIndices ? static_cast<std::uint16_t>((a << 8) | b)
-                                                            : static_cast<std::uint16_t>(a | (b << 8));
-                            if (idx == 0xFFFFu)
-                            {
-                                ++restart;
-                                rawIndices.push_back(idx);
-                                continue;
-                            }
-                            if (static_cast<std::size_t>(idx) >= vertexLimit)
-                            {
-                                ++droppable;
-                                continue;
-                            }
-                            rawIndices.push_back(static_cast<std::uint32_t>(idx));
-                        }
-                    }
+                    const std::size_t vertexLimit = verts.size();
+                    auto decoded = SeEditor::Forest::GetDecodedPrimitiveIndices(*primitive, vertexLimit);
+                    auto const& layout = decoded->Layout;
+                    cpu.Indices = decoded->Triangles;
 
-                    int primitiveType = primitive->Unknown_0x9c;
-                    bool isStrip = primitiveType == 5 || (primitiveType != 4 && restart > 0);
-                    if (isStrip)
-                    {
-                        cpu.Indices.reserve(rawIndices.size());
-                        bool have0 = false;
-                        bool have1 = false;
-                        std::uint32_t i0 = 0;
-                        std::uint32_t i1 = 0;
-                        bool flip = false;
-                        for (std::size_t i = 0; i < rawIndices.size(); ++i)
-                        {
-                            std::uint32_t idx = rawIndices[i];
-                            if ((use32Bit && idx == 0xFFFFFFFFu) || (!use32Bit && idx == 0xFFFFu))
-                            {
-                                have0 = false;
-                                have1 = false;
-                                flip = false;
-                                continue;
-                            }
-                            if (!have0)
-                            {
-                                i0 = idx;
-                                have0 = true;
-                                continue;
-                            }
-                            if (!have1)
-                            {
-                                i1 = idx;
-                                have1 = true;
-                                continue;
-                            }
-
-                            if (i0 != i1 && i1 != idx && i0 != idx)
-                            {
-                                if (flip)
-                                {
-                                    cpu.Indices.push_back(i1);
-                                    cpu.Indices.push_back(i0);
-                                    cpu.Indices.push_back(idx);
-                                }
-                                else
-                                {
-                                    cpu.Indices.push_back(i0);
-                                    cpu.Indices.push_back(i1);
-                                    cpu.Indices.push_back(idx);
-                                }
-                            }
-                            i0 = i1;
-                            i1 = idx;
-                            flip = !flip;
-                        }
-                    }
-                    else
-                    {
-                        cpu.Indices.reserve(rawIndices.size());
-                        for (std::uint32_t idx : rawIndices)
-                        {
-                            if ((use32Bit && idx == 0xFFFFFFFFu) || (!use32Bit && idx == 0xFFFFu))
-                                continue;
-                            cpu.Indices.push_back(idx);
-                        }
-                    }
-
-                    if (droppable > 0 || restart > 0)
+                    if (layout.Droppable > 0 || layout.Restart > 0)
                     {
                         if (debugDroppedLogged < 2 && primitive->VertexStream)
                         {
                             ++debugDroppedLogged;
-                            std::cerr << "[Forest] Dropped " << droppable << " indices for item mesh ("
-                                      << vertexLimit << " verts), restart=" << restart
+                            std::cerr << "[Forest] Dropped " << layout.Droppable << " indices for item mesh ("
+                                      << vertexLimit << " verts), restart=" << layout.Restart
                                       << " endian=" << (isBigEndian ? "BE" : "LE")
-                                      << " primType=" << primitiveType << '\n';
+                                      << " primType=" << primitive->Unknown_0x9c << '\n';
                         }
                     }
 
@@ -1951,6 +1739,14 @@ void CharmyBee::RenderSifViewer()
                                     if (ImGui::DragFloat("Size", &_navigationWaypointBoxSize, 0.1f, 0.2f, 50.0f, "%.1f"))
                                         UpdateDebugLines();
                                 }
+                                if (ImGui::Checkbox("Distance ticks", &_drawRacingLineTicks))
+                                    UpdateDebugLines();
+                                if (_drawRacingLineTicks)
+                                {
+                                    ImGui::SetNextItemWidth(80.0f);
+                                    if (ImGui::DragFloat("Spacing", &_racingLineTickSpacing, 1.0f, 5.0f, 1000.0f, "%.0f"))
+                                        UpdateDebugLines();
+                                }
                             }
                         }
                         else if (chunk.TypeValue == MakeTypeCode('L', 'O', 'G', 'C'))
@@ -2043,7 +1839,10 @@ void CharmyBee::RenderSifViewer()
                                 changed = true;
                         }
                         if (changed)
+                        {
                             UpdateNavigationLineVisibility();
+                            UpdateDebugLines();
+                        }
                     }
                 }
                 else if (chunk.TypeValue == MakeTypeCode('L', 'O', 'G', 'C'))
@@ -2126,6 +1925,30 @@ void CharmyBee::RenderSifViewer()
                                     changed = true;
                             }
 
+                            if (!_logicSpatialIndex.Empty() &&
+                                ImGui::TreeNodeEx("Near Camera Target", ImGuiTreeNodeFlags_SpanAvailWidth))
+                            {
+                                for (auto const& hit : _logicSpatialIndex.Nearest(_orbitTarget, 8))
+                                {
+                                    const bool isLocator = hit.Type == Editor::LogicSpatialIndex::Kind::Locator;
+                                    ImGui::Text("%s %zu (%.1f)", isLocator ? "Locator" : "Trigger", hit.Index, hit.Distance);
+                                    if (!isLocator)
+                                        continue;
+                                    ImGui::SameLine();
+                                    ImGui::PushID(static_cast<int>(hit.Index));
+                                    if (ImGui::SmallButton("Focus"))
+                                    {
+                                        auto const& loc = _sifLogic->Locators[hit.Index];
+                                        _orbitTarget = {loc->PositionAsFloats.X,
+                                                        loc->PositionAsFloats.Y,
+                                                        loc->PositionAsFloats.Z};
+                                        _orbitOffset = {0.0f, 0.0f, 0.0f};
+                                    }
+                                    ImGui::PopID();
+                                }
+                                ImGui::TreePop();
+                            }
+
                             ImGui::SeparatorText("Groups");
                             std::unordered_map<int, std::vector<int>> groups;
                             for (int i = 0; i < static_cast<int>(_sifLogic->Locators.size()); ++i)
@@ -2180,6 +2003,7 @@ void CharmyBee::RenderSifViewer()
                                             loc->PositionAsFloats.X = pos[0];
                                             loc->PositionAsFloats.Y = pos[1];
                                             loc->PositionAsFloats.Z = pos[2];
+                                            _logicSpatialIndex.UpdateLocator(*_sifLogic, static_cast<std::size_t>(idx));
                                             BuildLogicLocatorMeshes();
                                             UpdateForestMeshRendering();
                                             UpdateDebugLines();
@@ -3016,6 +2840,7 @@ void CharmyBee::UnpackXpac()
         unpackOptions.OutputRoot = GetStuffRoot();
         unpackOptions.MappingPath = Xpac::FindDefaultMappingPath(unpackOptions.XpacPath, unpackOptions.OutputRoot);
         unpackOptions.ConvertToSifSig = true;
+        unpackOptions.ConvertMode = Xpac::XpacConvertMode::InWorkers;
         unpackOptions.Progress = [this](std::size_t current, std::size_t total) {
             _xpacProgress = current;
             _xpacTotal = total;
@@ -3230,10 +3055,12 @@ void CharmyBee::LoadSifFile(std::filesystem::path const& path)
         _forestLibrary.reset();
         _sifNavigation.reset();
         _sifNavigationTool.reset();
+        _racingLineTables.clear();
         _navigationLineEntries.clear();
         _showNavigationHierarchyWindow = false;
         _drawNavigation = false;
         _sifLogic.reset();
+        _logicSpatialIndex.Clear();
         _drawLogic = false;
         _itemsForestLibrary.reset();
         _itemsForestMeshesByForestTree.clear();
@@ -3803,216 +3630,13 @@ void CharmyBee::LoadForestResources()
                     if (indexCount == 0)
                         continue;
 
-                    std::size_t vertexLimit = verts.size();
-                    struct IndexMode
-                    {
-                        bool Use32 = false;
-                        bool Swap = false;
-                        std::size_t Count = 0;
-                        std::size_t Droppable = 0;
-                        std::size_t Restart = 0;
-                        std::uint32_t MaxIndex = 0;
-                    };
-
-                    auto eval16 = [&](bool swap) {
-                        IndexMode mode;
-                        mode.Use32 = false;
-                        mode.Swap = swap;
-                        mode.Count = indexCount;
-                        for (std::size_t i = 0; i < indexCount; ++i)
-                        {
-                            std::uint16_t a = primitive->IndexData[i * 2];
-                            std::uint16_t b = primitive->IndexData[i * 2 + 1];
-                            std::uint16_t idx = swap ? static_cast<std::uint16_t>((a << 8) | b)
-                                                     : static_cast<std::uint16_t>(a | (b << 8));
-                            if (idx == 0xFFFFu)
-                            {
-                                ++mode.Restart;
-                                continue;
-                            }
-                            if (idx > mode.MaxIndex)
-                                mode.MaxIndex = idx;
-                            if (static_cast<std::size_t>(idx) >= vertexLimit)
-                                ++mode.Droppable;
-                        }
-                        return mode;
-                    };
-
-                    auto eval32 = [&](bool swap) {
-                        IndexMode mode;
-                        mode.Use32 = true;
-                        mode.Swap = swap;
-                        if (primitive->IndexData.size() % 4 != 0)
-                            return mode;
-                        mode.Count = primitive->IndexData.size() / 4;
-                        if (primitive->NumIndices > 0)
-                            mode.Count = std::min<std::size_t>(mode.Count,
-                                static_cast<std::size_t>(primitive->NumIndices));
-                        for (std::size_t i = 0; i < mode.Count; ++i)
-                        {
-                            std::size_t off = i * 4;
-                            std::uint32_t idx = static_cast<std::uint32_t>(primitive->IndexData[off + 0] |
-                                (primitive->IndexData[off + 1] << 8) |
-                                (primitive->IndexData[off + 2] << 16) |
-                                (primitive->IndexData[off + 3] << 24));
-                            if (swap)
-                            {
-                                idx = ((idx & 0x000000FFu) << 24) |
-                                      ((idx & 0x0000FF00u) << 8) |
-                                      ((idx & 0x00FF0000u) >> 8) |
-                                      ((idx & 0xFF000000u) >> 24);
-                            }
-                            if (idx == 0xFFFFFFFFu)
-                            {
-                                ++mode.Restart;
-                                continue;
-                            }
-                            if (idx > mode.MaxIndex)
-                                mode.MaxIndex = idx;
-                            if (idx >= vertexLimit)
-                                ++mode.Droppable;
-                        }
-                        return mode;
-                    };
-
-                    IndexMode mode16le = eval16(false);
-                    IndexMode mode16be = eval16(true);
-                    IndexMode mode32le = eval32(false);
-                    IndexMode mode32be = eval32(true);
-
-                    IndexMode best = mode16le;
-                    if (mode16be.Droppable < best.Droppable)
-                        best = mode16be;
-                    if (mode32le.Count > 0 && mode32le.Droppable < best.Droppable)
-                        best = mode32le;
-                    if (mode32be.Count > 0 && mode32be.Droppable < best.Droppable)
-                        best = mode32be;
-
-                    bool use32Bit = best.Use32;
-                    bool swapIndices = best.Swap;
-                    std::size_t indexCount32 = best.Use32 ? best.Count : 0;
-                    std::size_t droppable = 0;
-                    std::size_t restart = 0;
-                    std::vector<std::uint32_t> rawIndices;
-                    rawIndices.reserve(best.Count);
-
-                    if (use32Bit)
-                    {
-                        for (std::size_t i = 0; i < indexCount32; ++i)
-                        {
-                            std::size_t off = i * 4;
-                            std::uint32_t idx = static_cast<std::uint32_t>(primitive->IndexData[off + 0] |
-                                (primitive->IndexData[off + 1] << 8) |
-                                (primitive->IndexData[off + 2] << 16) |
-                                (primitive->IndexData[off + 3] << 24));
-                            if (swapIndices)
-                            {
-                                idx = ((idx & 0x000000FFu) << 24) |
-                                      ((idx & 0x0000FF00u) << 8) |
-                                      ((idx & 0x00FF0000u) >> 8) |
-                                      ((idx & 0xFF000000u) >> 24);
-                            }
-                            if (idx == 0xFFFFFFFFu)
-                            {
-                                ++restart;
-                                rawIndices.push_back(idx);
-                                continue;
-                            }
-                            if (idx >= vertexLimit)
-                            {
-                                ++droppable;
-                                continue;
-                            }
-                            rawIndices.push_back(idx);
-                        }
-                    }
-                    else
-                    {
-                        for (std::size_t i = 0; i < best.Count; ++i)
-                        {
-                            std::uint16_t a = primitive->IndexData[i * 2];
-                            std::uint16_t b = primitive->IndexData[i * 2 + 1];
-                            std::uint16_t idx = swapIndices ? static_cast<std::uint16_t>((a << 8) | b)
-                                                            : static_cast<std::uint16_t>(a | (b << 8));
-                            if (idx == 0xFFFFu)
-                            {
-                                ++restart;
-                                rawIndices.push_back(idx);
-                                continue;
-                            }
-                            if (static_cast<std::size_t>(idx) >= vertexLimit)
-                            {
-                                ++droppable;
-                                continue;
-                            }
-                            rawIndices.push_back(static_cast<std::uint32_t>(idx));
-                        }
-                    }
-
-                    int primitiveType = primitive->Unknown_0x9c;
-                    bool isStrip = primitiveType == 5 || (primitiveType != 4 && restart > 0);
-                    if (isStrip)
-                    {
-                        cpu.Indices.reserve(rawIndices.size());
-                        bool have0 = false;
-                        bool have1 = false;
-                        std::uint32_t i0 = 0;
-                        std::uint32_t i1 = 0;
-                        bool flip = false;
-                        for (std::size_t i = 0; i < rawIndices.size(); ++i)
-                        {
-                            std::uint32_t idx = rawIndices[i];
-                            if ((use32Bit && idx == 0xFFFFFFFFu) || (!use32Bit && idx == 0xFFFFu))
-                            {
-                                have0 = false;
-                                have1 = false;
-                                flip = false;
-                                continue;
-                            }
-                            if (!have0)
-                            {
-                                i0 = idx;
-                                have0 = true;
-                                continue;
-                            }
-                            if (!have1)
-                            {
-                                i1 = idx;
-                                have1 = true;
-                                continue;
-                            }
-
-                            if (i0 != i1 && i1 != idx && i0 != idx)
-                            {
-                                if (flip)
-                                {
-                                    cpu.Indices.push_back(i1);
-                                    cpu.Indices.push_back(i0);
-                                    cpu.Indices.push_back(idx);
-                                }
-                                else
-                                {
-                                    cpu.Indices.push_back(i0);
-                                    cpu.Indices.push_back(i1);
-                                    cpu.Indices.push_back(idx);
-                                }
-                            }
-                            i0 = i1;
-                            i1 = idx;
-                            flip = !flip;
-                        }
-                    }
-                    else
-                    {
-                        cpu.Indices.reserve(rawIndices.size());
-                        for (std::uint32_t idx : rawIndices)
-                        {
-                            if ((use32Bit && idx == 0xFFFFFFFFu) || (!use32Bit && idx == 0xFFFFu))
-                                continue;
-                            cpu.Indices.push_back(idx);
-                        }
-                    }
+                    const std::size_t vertexLimit = verts.size();
+                    auto decoded = SeEditor::Forest::GetDecodedPrimitiveIndices(*primitive, vertexLimit);
+                    auto const& layout = decoded->Layout;
+                    cpu.Indices = decoded->Triangles;
 
+                    const std::size_t droppable = layout.Droppable;
+                    const std::size_t restart = layout.Restart;
                     if (droppable > 0 || restart > 0)
                     {
                         if (droppable > 0)
@@ -4043,19 +3667,20 @@ void CharmyBee::LoadForestResources()
                         if (debugDroppedLogged < 5 && primitive->VertexStream)
                         {
                             ++debugDroppedLogged;
-                            std::cerr << "[Forest] Debug: indices16 max=" << mode16le.MaxIndex
-                                      << " dropped16=" << mode16le.Droppable
-                                      << " restart16=" << mode16le.Restart
-                                      << " indices32 max=" << mode32le.MaxIndex
-                                      << " dropped32=" << mode32le.Droppable
-                                      << " restart32=" << mode32le.Restart
-                                      << " use32=" << (use32Bit ? "true" : "false")
-                                      << " swap=" << (swapIndices ? "true" : "false")
+                            std::cerr << "[Forest] Debug: count=" << layout.Count
+                                      << " dropped=" << droppable
+                                      << " restart=" << restart
+                                      << " use32=" << (layout.Is32Bit() ? "true" : "false")
+                                      << " swap=" << ((layout.Format == SeEditor::Forest::PrimitiveIndexFormat::U16BE ||
+                                                       layout.Format == SeEditor::Forest::PrimitiveIndexFormat::U32BE)
+                                                          ? "true"
+                                                          : "false")
+                                      << " strip=" << (layout.IsStrip ? "true" : "false")
                                       << " vtxCount=" << primitive->VertexStream->VertexCount
                                       << " stride=" << primitive->VertexStream->VertexStride
                                       << " streamBias=" << primitive->VertexStream->StreamBias
                                       << " endian=" << (isBigEndian ? "BE" : "LE")
-                                      << " primType=" << primitiveType
+                                      << " primType=" << primitive->Unknown_0x9c
                                       << " forest=" << forestIdx
                                       << " name=" << forestEntry.Name
                                       << " tree=" << treeIdx
@@ -4195,10 +3820,15 @@ void CharmyBee::LoadNavigationResources()
     _sifNavigationTool = std::make_unique<Editor::Tools::NavigationTool>(_sifNavigation.get());
 
     _navigationLineEntries.clear();
+    _racingLineTables.clear();
     if (_sifNavigation)
     {
+        _racingLineTables.resize(_sifNavigation->RacingLines.size());
         for (std::size_t i = 0; i < _sifNavigation->RacingLines.size(); ++i)
         {
+            if (_sifNavigation->RacingLines[i])
+                _racingLineTables[i].Build(*_sifNavigation->RacingLines[i]);
+
             std::string label = "Racing Line " + std::to_string(i);
             auto const& line = _sifNavigation->RacingLines[i];
             if (line)
@@ -4334,6 +3964,7 @@ void CharmyBee::LoadLogicResources()
               << std::endl;
 
     _sifLogic = std::move(logic);
+    _logicSpatialIndex.Build(*_sifLogic);
     _drawLogic = true;
     LoadItemsForestResources();
     BuildLogicLocatorMeshes();
@@ -4989,6 +4620,33 @@ void CharmyBee::UpdateDebugLines()
             }
         }
 
+        if (_drawRacingLineTicks)
+        {
+            // Cross ticks at even distances along each visible racing line.
+            const SlLib::Math::Vector3 color{1.0f, 0.85f, 0.2f};
+            const SlLib::Math::Vector3 up{0.0f, 1.0f, 0.0f};
+            std::vector<SlLib::SumoTool::Siff::NavData::NavRacingLineSample> samples;
+            for (std::size_t i = 0; i < _racingLineTables.size(); ++i)
+            {
+                bool visible = true;
+                for (auto const& entry : _navigationLineEntries)
+                {
+                    if (entry.LineIndex == static_cast<int>(i))
+                        visible = entry.Visible;
+                }
+                if (!visible)
+                    continue;
+
+                _racingLineTables[i].SampleEvery(std::max(1.0f, _racingLineTickSpacing), samples);
+                for (auto const& sample : samples)
+                {
+                    SlLib::Math::Vector3 side = SlLib::Math::cross(up, sample.Tangent) * 2.0f;
+                    navLines.push_back({sample.Position - side, sample.Position + side, color});
+                    navLines.push_back({sample.Position, sample.Position + up * 2.0f, color});
+                }
+            }
+        }
+
         combined.insert(combined.end(), navLines.begin(), navLines.end());
     }
 
@@ -5247,7 +4905,8 @@ void CharmyBee::UpdateTriggerPhantomBoxes()
                 sz = sx;
 
             SlLib::Math::Vector3 scale{sx, sy, sz};
-            addBox(phantom->Translation, scale);
+            auto const& world = phantom->GetWorldMatrix();
+            addBox({world(0, 3), world(1, 3), world(2, 3)}, scale);
         }
 
         for (auto* child = node->FirstChild; child != nullptr; child = child->NextSibling)
@@ -5258,7 +4917,10 @@ void CharmyBee::UpdateTriggerPhantomBoxes()
     };
 
     for (auto* root : _database->RootDefinitions)
+    {
+        SlLib::Resources::Scene::SeGraphNode::UpdateWorldTransforms(root);
         walk(root);
+    }
 
     _renderer.SetTriggerBoxes(std::move(boxes));
     _renderer.SetDrawTriggerBoxes(_drawTriggerBoxes);
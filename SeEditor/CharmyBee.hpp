@@ -20,6 +20,7 @@
 #include "Editor/Panel/InspectorPanel.hpp"
 #include "Editor/Panel/ScenePanel.hpp"
 #include "Editor/Panel/IEditorPanel.hpp"
+#include "Editor/LogicSpatialIndex.hpp"
 #include "Editor/Scene.hpp"
 #include "Editor/Tools/NavTool/NavRoute.hpp"
 #include "Editor/Tools/NavTool/NavRenderMode.hpp"
@@ -33,6 +34,7 @@
 #include "SlLib/Resources/Database/SlResourceDatabase.hpp"
 #include "SlLib/Resources/Scene/SeDefinitionNode.hpp"
 #include "SlLib/Resources/Scene/SeGraphNode.hpp"
+#include "SlLib/SumoTool/Siff/NavData/NavRacingLineTable.hpp"
 #include "SlLib/SumoTool/Siff/NavData/NavWaypoint.hpp"
 #include "SlLib/SumoTool/Siff/Navigation.hpp"
 #include "SlLib/SumoTool/Siff/LogicData.hpp"
@@ -114,6 +116,8 @@ private:
     bool _drawNavigation = false;
     bool _drawNavigationWaypoints = true;
     float _navigationWaypointBoxSize = 2.0f;
+    bool _drawRacingLineTicks = false;
+    float _racingLineTickSpacing = 50.0f;
     bool _drawLogic = false;
     bool _drawLogicTriggers = true;
     bool _drawLogicLocators = true;
@@ -269,7 +273,9 @@ private:
     std::unique_ptr<Editor::Tools::NavigationTool> _navigationTool;
     std::unique_ptr<SlLib::SumoTool::Siff::Navigation> _sifNavigation;
     std::unique_ptr<Editor::Tools::NavigationTool> _sifNavigationTool;
+    std::vector<SlLib::SumoTool::Siff::NavData::NavRacingLineTable> _racingLineTables;
     std::unique_ptr<SlLib::SumoTool::Siff::LogicData> _sifLogic;
+    Editor::LogicSpatialIndex _logicSpatialIndex;
     std::vector<Editor::Tools::NavTool::NavRoute> _routes;
     Editor::Tools::NavTool::NavRoute* _selectedRoute = nullptr;
     SlLib::SumoTool::Siff::NavData::NavWaypoint* _selectedWaypoint = nullptr;
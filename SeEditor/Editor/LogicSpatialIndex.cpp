@@ -0,0 +1,141 @@
+#include "LogicSpatialIndex.hpp"
+
+#include "SlLib/SumoTool/Siff/LogicData.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SeEditor::Editor {
+
+namespace {
+
+using SlLib::Math::Aabb;
+using SlLib::Math::Vector3;
+using SlLib::Math::Vector4;
+
+// User data packs the object kind into the top bit and its list index below it.
+constexpr std::uint32_t kLocatorBit = 0x80000000u;
+// Locators are points; give them a small box so rays can hit them.
+constexpr float kLocatorPickRadius = 0.5f;
+
+std::uint32_t Pack(LogicSpatialIndex::Kind kind, std::size_t index)
+{
+    return static_cast<std::uint32_t>(index) | (kind == LogicSpatialIndex::Kind::Locator ? kLocatorBit : 0u);
+}
+
+LogicSpatialIndex::Hit Unpack(std::uint32_t userData, float distance)
+{
+    LogicSpatialIndex::Hit hit;
+    hit.Type = (userData & kLocatorBit) != 0 ? LogicSpatialIndex::Kind::Locator : LogicSpatialIndex::Kind::Trigger;
+    hit.Index = userData & ~kLocatorBit;
+    hit.Distance = distance;
+    return hit;
+}
+
+void Expand(Aabb& box, Vector4 const& point)
+{
+    box.Min = {std::min(box.Min.X, point.X), std::min(box.Min.Y, point.Y), std::min(box.Min.Z, point.Z)};
+    box.Max = {std::max(box.Max.X, point.X), std::max(box.Max.Y, point.Y), std::max(box.Max.Z, point.Z)};
+}
+
+Aabb TriggerBounds(SlLib::SumoTool::Siff::Logic::Trigger const& trigger)
+{
+    Aabb box{{trigger.Position.X, trigger.Position.Y, trigger.Position.Z},
+             {trigger.Position.X, trigger.Position.Y, trigger.Position.Z}};
+    for (Vector4 const* vertex : {&trigger.Vertex0, &trigger.Vertex1, &trigger.Vertex2, &trigger.Vertex3})
+        Expand(box, *vertex);
+    return box;
+}
+
+Aabb LocatorBounds(SlLib::SumoTool::Siff::Logic::Locator const& locator)
+{
+    Vector3 p{locator.PositionAsFloats.X, locator.PositionAsFloats.Y, locator.PositionAsFloats.Z};
+    Vector3 r{kLocatorPickRadius, kLocatorPickRadius, kLocatorPickRadius};
+    return {p - r, p + r};
+}
+
+} // namespace
+
+void LogicSpatialIndex::Build(SlLib::SumoTool::Siff::LogicData const& logic)
+{
+    std::vector<std::pair<Aabb, std::uint32_t>> items;
+    items.reserve(logic.Triggers.size() + logic.Locators.size());
+    for (std::size_t i = 0; i < logic.Triggers.size(); ++i)
+    {
+        if (logic.Triggers[i])
+            items.emplace_back(TriggerBounds(*logic.Triggers[i]), Pack(Kind::Trigger, i));
+    }
+    for (std::size_t i = 0; i < logic.Locators.size(); ++i)
+    {
+        if (logic.Locators[i])
+            items.emplace_back(LocatorBounds(*logic.Locators[i]), Pack(Kind::Locator, i));
+    }
+
+    Aabb world{};
+    if (!items.empty())
+    {
+        world = items.front().first;
+        for (auto const& item : items)
+        {
+            Expand(world, {item.first.Min.X, item.first.Min.Y, item.first.Min.Z, 0.0f});
+            Expand(world, {item.first.Max.X, item.first.Max.Y, item.first.Max.Z, 0.0f});
+        }
+    }
+
+    _tree = SlLib::Math::LooseOctree::FromBounds(world);
+    _locatorHandles.assign(logic.Locators.size(), SlLib::Math::LooseOctree::InvalidHandle);
+    for (auto const& [bounds, userData] : items)
+    {
+        auto handle = _tree.Insert(bounds, userData);
+        if ((userData & kLocatorBit) != 0)
+            _locatorHandles[userData & ~kLocatorBit] = handle;
+    }
+}
+
+void LogicSpatialIndex::Clear()
+{
+    _tree.Clear();
+    _locatorHandles.clear();
+}
+
+void LogicSpatialIndex::UpdateLocator(SlLib::SumoTool::Siff::LogicData const& logic, std::size_t index)
+{
+    if (index >= _locatorHandles.size() || index >= logic.Locators.size() || !logic.Locators[index])
+        return;
+    auto handle = _locatorHandles[index];
+    if (handle != SlLib::Math::LooseOctree::InvalidHandle)
+        _tree.Move(handle, LocatorBounds(*logic.Locators[index]));
+}
+
+std::vector<LogicSpatialIndex::Hit> LogicSpatialIndex::Nearest(Vector3 point, std::size_t count) const
+{
+    std::vector<SlLib::Math::LooseOctree::NearestHit> found;
+    _tree.QueryNearest(point, count, found);
+    std::vector<Hit> hits;
+    hits.reserve(found.size());
+    for (auto const& entry : found)
+        hits.push_back(Unpack(entry.UserData, std::sqrt(entry.DistanceSquared)));
+    return hits;
+}
+
+std::vector<LogicSpatialIndex::Hit> LogicSpatialIndex::WithinRadius(Vector3 point, float radius) const
+{
+    std::vector<SlLib::Math::LooseOctree::NearestHit> found;
+    _tree.QueryNearest(point, _tree.Size(), found, radius);
+    std::vector<Hit> hits;
+    hits.reserve(found.size());
+    for (auto const& entry : found)
+        hits.push_back(Unpack(entry.UserData, std::sqrt(entry.DistanceSquared)));
+    return hits;
+}
+
+bool LogicSpatialIndex::Raycast(Vector3 origin, Vector3 direction, float maxDistance, Hit& hit) const
+{
+    SlLib::Math::LooseOctree::RayHit found;
+    if (!_tree.Raycast(origin, direction, maxDistance, found))
+        return false;
+    hit = Unpack(found.UserData, found.Distance);
+    return true;
+}
+
+} // namespace SeEditor::Editor
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "SlLib/Math/LooseOctree.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SlLib::SumoTool::Siff {
+class LogicData;
+}
+
+namespace SeEditor::Editor {
+
+// Spatial index over the logic triggers and locators of the loaded SIF, so picking and proximity lookups do
+// not scan every object.
+class LogicSpatialIndex
+{
+public:
+    enum class Kind : std::uint8_t
+    {
+        Trigger,
+        Locator,
+    };
+
+    struct Hit
+    {
+        Kind Type = Kind::Trigger;
+        std::size_t Index = 0;
+        float Distance = 0.0f;
+    };
+
+    void Build(SlLib::SumoTool::Siff::LogicData const& logic);
+    void Clear();
+    // Call after editing a locator's position.
+    void UpdateLocator(SlLib::SumoTool::Siff::LogicData const& logic, std::size_t index);
+
+    [[nodiscard]] bool Empty() const { return _tree.Size() == 0; }
+    // Closest first; distances are to the object's bounds.
+    std::vector<Hit> Nearest(SlLib::Math::Vector3 point, std::size_t count) const;
+    std::vector<Hit> WithinRadius(SlLib::Math::Vector3 point, float radius) const;
+    bool Raycast(SlLib::Math::Vector3 origin, SlLib::Math::Vector3 direction, float maxDistance, Hit& hit) const;
+
+private:
+    SlLib::Math::LooseOctree _tree{{0.0f, 0.0f, 0.0f}, 1.0f};
+    std::vector<SlLib::Math::LooseOctree::Handle> _locatorHandles;
+};
+
+} // namespace SeEditor::Editor
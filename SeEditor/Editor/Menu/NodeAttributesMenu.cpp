@@ -30,17 +30,20 @@ void DrawTransform(NodeT* node, std::string_view header)
     if (!StartPropertyTable(header))
         return;
 
-    DrawDragFloat3("Translation", node->Translation);
+    bool changed = DrawDragFloat3("Translation", node->Translation);
 
     SlLib::Math::Vector4 rotation = ToVector4(node->Rotation);
-    DrawDragFloat4("Rotation", rotation);
+    changed |= DrawDragFloat4("Rotation", rotation);
     node->Rotation.X = rotation.X;
     node->Rotation.Y = rotation.Y;
     node->Rotation.Z = rotation.Z;
     node->Rotation.W = rotation.W;
 
-    DrawDragFloat3("Scale", node->Scale);
+    changed |= DrawDragFloat3("Scale", node->Scale);
+    const int inheritTransforms = node->InheritTransforms;
     DrawCheckboxFlags("Inherit Transforms", node->InheritTransforms, 1);
+    if (changed || inheritTransforms != node->InheritTransforms)
+        node->MarkTransformDirty();
 
     EndPropertyTable();
 }
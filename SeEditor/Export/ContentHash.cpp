@@ -0,0 +1,139 @@
+#include "ContentHash.hpp"
+
+#include "SeEditor/MappedFile.hpp"
+
+#include <string>
+
+namespace SeEditor::Export {
+
+namespace {
+
+constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr std::uint64_t kPrime3 = 0x165667B19E3779F9ull;
+constexpr std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+constexpr std::uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+std::uint64_t Rotl(std::uint64_t v, int r)
+{
+    return (v << r) | (v >> (64 - r));
+}
+
+std::uint64_t Read64(const std::uint8_t* p)
+{
+    std::uint64_t v = 0;
+    for (int i = 7; i >= 0; --i)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+std::uint32_t Read32(const std::uint8_t* p)
+{
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+std::uint64_t Round(std::uint64_t acc, std::uint64_t input)
+{
+    acc += input * kPrime2;
+    acc = Rotl(acc, 31);
+    return acc * kPrime1;
+}
+
+std::uint64_t MergeRound(std::uint64_t acc, std::uint64_t val)
+{
+    acc ^= Round(0, val);
+    return acc * kPrime1 + kPrime4;
+}
+
+} // namespace
+
+std::uint64_t HashContent64(std::span<const std::uint8_t> bytes, std::uint64_t seed)
+{
+    const std::uint8_t* p = bytes.data();
+    const std::uint8_t* end = p + bytes.size();
+    std::uint64_t h = 0;
+
+    if (bytes.size() >= 32)
+    {
+        std::uint64_t v1 = seed + kPrime1 + kPrime2;
+        std::uint64_t v2 = seed + kPrime2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - kPrime1;
+        const std::uint8_t* limit = end - 32;
+        do
+        {
+            v1 = Round(v1, Read64(p));
+            v2 = Round(v2, Read64(p + 8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        h = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+        h = MergeRound(h, v1);
+        h = MergeRound(h, v2);
+        h = MergeRound(h, v3);
+        h = MergeRound(h, v4);
+    }
+    else
+    {
+        h = seed + kPrime5;
+    }
+
+    h += static_cast<std::uint64_t>(bytes.size());
+    for (; p + 8 <= end; p += 8)
+    {
+        h ^= Round(0, Read64(p));
+        h = Rotl(h, 27) * kPrime1 + kPrime4;
+    }
+    if (p + 4 <= end)
+    {
+        h ^= static_cast<std::uint64_t>(Read32(p)) * kPrime1;
+        h = Rotl(h, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    for (; p < end; ++p)
+    {
+        h ^= static_cast<std::uint64_t>(*p) * kPrime5;
+        h = Rotl(h, 11) * kPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::uint64_t HashBytes(std::span<const std::uint8_t> bytes, std::uint64_t seed)
+{
+    return HashContent64(bytes, seed);
+}
+
+std::uint64_t HashString(std::string_view text, std::uint64_t seed)
+{
+    return HashContent64(
+        std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t*>(text.data()), text.size()), seed);
+}
+
+std::uint64_t HashValue(std::uint64_t value, std::uint64_t seed)
+{
+    std::uint8_t bytes[8];
+    for (int i = 0; i < 8; ++i)
+        bytes[i] = static_cast<std::uint8_t>(value >> (i * 8));
+    return HashContent64(bytes, seed);
+}
+
+bool HashFile(std::filesystem::path const& path, std::uint64_t& hash)
+{
+    SeEditor::MappedFile file;
+    std::string error;
+    if (!file.Open(path, error, SeEditor::MappedFile::AccessHint::Sequential))
+        return false;
+    hash = HashContent64(file.Bytes());
+    return true;
+}
+
+} // namespace SeEditor::Export
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace SeEditor::Export {
+
+// XXH64 of `bytes`. Fast enough to run over every texture payload and exported file.
+std::uint64_t HashContent64(std::span<const std::uint8_t> bytes, std::uint64_t seed = 0);
+
+// Chained XXH64 for building cache keys: each call continues from `seed`, so several inputs combine into one.
+std::uint64_t HashBytes(std::span<const std::uint8_t> bytes, std::uint64_t seed = 0);
+std::uint64_t HashString(std::string_view text, std::uint64_t seed = 0);
+std::uint64_t HashValue(std::uint64_t value, std::uint64_t seed = 0);
+
+// XXH64 of a file's contents; false when it cannot be read.
+bool HashFile(std::filesystem::path const& path, std::uint64_t& hash);
+
+} // namespace SeEditor::Export
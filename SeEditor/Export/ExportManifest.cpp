@@ -0,0 +1,219 @@
+#include "ExportManifest.hpp"
+
+#include "SlLib/Utilities/ParallelFor.hpp"
+
+#include <atomic>
+#include <charconv>
+#include <fstream>
+#include <set>
+
+namespace SeEditor::Export {
+
+namespace {
+
+constexpr std::string_view kManifestHeader = "SeEditorExportManifest 2";
+
+std::string ToHex64(std::uint64_t value)
+{
+    char chars[16];
+    for (int i = 15; i >= 0; --i)
+    {
+        chars[i] = "0123456789abcdef"[value & 0xF];
+        value >>= 4;
+    }
+    return std::string(chars, sizeof(chars));
+}
+
+bool ParseHex64(std::string_view text, std::uint64_t& value)
+{
+    auto res = std::from_chars(text.data(), text.data() + text.size(), value, 16);
+    return res.ec == std::errc{} && res.ptr == text.data() + text.size();
+}
+
+// Only plain relative paths below the export root are accepted; anything else in a manifest is ignored so a
+// damaged file can never point the orphan cleanup outside the export.
+bool IsSafeRelativePath(std::string_view path)
+{
+    if (path.empty())
+        return false;
+    std::filesystem::path p(path);
+    if (p.is_absolute() || p.has_root_name())
+        return false;
+    for (auto const& part : p)
+    {
+        if (part == "..")
+            return false;
+    }
+    return true;
+}
+
+bool OutputMatches(ManifestOutput const& output, std::filesystem::path const& root)
+{
+    std::uint64_t hash = 0;
+    return output.Hash != 0 && HashFile(root / output.Path, hash) && hash == output.Hash;
+}
+
+} // namespace
+
+bool ExportManifest::Load(std::filesystem::path const& path)
+{
+    SourceKey = 0;
+    Tasks.clear();
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return false;
+
+    std::string line;
+    if (!std::getline(in, line) || line != kManifestHeader)
+        return false;
+
+    ManifestTask* current = nullptr;
+    while (std::getline(in, line))
+    {
+        std::string_view view(line);
+        if (view.starts_with("source "))
+        {
+            ParseHex64(view.substr(7), SourceKey);
+        }
+        else if (view.starts_with("task "))
+        {
+            // "task <16 hex digits> <id>"
+            current = nullptr;
+            if (view.size() < 5 + 16 + 2 || view[5 + 16] != ' ')
+                continue;
+            std::uint64_t key = 0;
+            if (!ParseHex64(view.substr(5, 16), key))
+                continue;
+            ManifestTask& task = Tasks[std::string(view.substr(5 + 17))];
+            task.Key = key;
+            task.Outputs.clear();
+            current = &task;
+        }
+        else if (view.starts_with("out ") && current)
+        {
+            // "out <16 hex digits> <path>"
+            if (view.size() < 4 + 16 + 2 || view[4 + 16] != ' ')
+                continue;
+            ManifestOutput output;
+            output.Path = std::string(view.substr(4 + 17));
+            if (ParseHex64(view.substr(4, 16), output.Hash) && IsSafeRelativePath(output.Path))
+                current->Outputs.push_back(std::move(output));
+        }
+    }
+    return true;
+}
+
+bool ExportManifest::Save(std::filesystem::path const& path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+    out << kManifestHeader << '\n';
+    out << "source " << ToHex64(SourceKey) << '\n';
+    for (auto const& [id, task] : Tasks)
+    {
+        out << "task " << ToHex64(task.Key) << ' ' << id << '\n';
+        for (auto const& output : task.Outputs)
+            out << "out " << ToHex64(output.Hash) << ' ' << output.Path << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+ManifestTask const* ExportManifest::Find(std::string const& id) const
+{
+    auto it = Tasks.find(id);
+    return it != Tasks.end() ? &it->second : nullptr;
+}
+
+bool ExportManifest::IsUpToDate(std::string const& id, std::uint64_t key, std::filesystem::path const& root) const
+{
+    ManifestTask const* task = Find(id);
+    if (!task || task->Key != key)
+        return false;
+    for (auto const& output : task->Outputs)
+    {
+        if (!OutputMatches(output, root))
+            return false;
+    }
+    return true;
+}
+
+bool ExportManifest::AllOutputsMatch(std::filesystem::path const& root, std::size_t threadCount) const
+{
+    std::vector<ManifestOutput const*> outputs;
+    for (auto const& [id, task] : Tasks)
+        for (auto const& output : task.Outputs)
+            outputs.push_back(&output);
+
+    std::atomic<bool> match{true};
+    SlLib::Utilities::ParallelFor(outputs.size(), threadCount, [&](std::size_t i) {
+        if (match.load(std::memory_order_relaxed) && !OutputMatches(*outputs[i], root))
+            match.store(false, std::memory_order_relaxed);
+    });
+    return match.load();
+}
+
+void ExportManifest::HashOutputs(std::filesystem::path const& root, std::size_t threadCount)
+{
+    std::vector<ManifestOutput*> pending;
+    for (auto& [id, task] : Tasks)
+        for (auto& output : task.Outputs)
+            if (output.Hash == 0)
+                pending.push_back(&output);
+
+    SlLib::Utilities::ParallelFor(pending.size(), threadCount, [&](std::size_t i) {
+        std::uint64_t hash = 0;
+        if (HashFile(root / pending[i]->Path, hash))
+            pending[i]->Hash = hash;
+    });
+}
+
+void AddManifestOutput(std::vector<ManifestOutput>& outputs,
+                       std::filesystem::path const& root,
+                       std::filesystem::path const& path)
+{
+    outputs.push_back({path.lexically_relative(root).generic_string(), 0});
+}
+
+std::size_t RemoveOrphanedOutputs(ExportManifest const& previous,
+                                  ExportManifest const& current,
+                                  std::filesystem::path const& root)
+{
+    std::set<std::string> kept;
+    for (auto const& [id, task] : current.Tasks)
+        for (auto const& output : task.Outputs)
+            kept.insert(output.Path);
+
+    std::set<std::filesystem::path> touchedDirs;
+    std::size_t removed = 0;
+    std::error_code ec;
+    for (auto const& [id, task] : previous.Tasks)
+    {
+        for (auto const& output : task.Outputs)
+        {
+            if (kept.count(output.Path) != 0 || !IsSafeRelativePath(output.Path))
+                continue;
+            const std::filesystem::path path = root / output.Path;
+            if (std::filesystem::remove(path, ec))
+                ++removed;
+            std::filesystem::remove(path.string() + ".meta", ec);
+            touchedDirs.insert(path.parent_path());
+        }
+    }
+
+    // Deepest directories first so nested empty folders collapse in one pass.
+    for (auto it = touchedDirs.rbegin(); it != touchedDirs.rend(); ++it)
+    {
+        std::filesystem::path dir = *it;
+        while (dir != root && dir.has_relative_path() && std::filesystem::is_empty(dir, ec) && !ec)
+        {
+            std::filesystem::remove(dir, ec);
+            std::filesystem::remove(dir.string() + ".meta", ec);
+            dir = dir.parent_path();
+        }
+    }
+    return removed;
+}
+
+} // namespace SeEditor::Export
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ContentHash.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SeEditor::Export {
+
+// A file written by a task: its generic path relative to the export root and the XXH64 of its contents
+// (0 until HashOutputs has run).
+struct ManifestOutput
+{
+    std::string Path;
+    std::uint64_t Hash = 0;
+};
+
+// One unit of export work: the hash of everything it was generated from and the files it produced.
+struct ManifestTask
+{
+    std::uint64_t Key = 0;
+    std::vector<ManifestOutput> Outputs;
+};
+
+// Records what an export run produced so the next run can skip unchanged tasks and remove outputs that are
+// no longer generated. Stored as a line-based text file next to the exported assets.
+class ExportManifest
+{
+public:
+    bool Load(std::filesystem::path const& path);
+    bool Save(std::filesystem::path const& path) const;
+
+    // True when `id` was recorded with `key` and every one of its outputs under `root` still has the recorded
+    // content hash, so a truncated or hand-edited file is exported again.
+    bool IsUpToDate(std::string const& id, std::uint64_t key, std::filesystem::path const& root) const;
+    ManifestTask const* Find(std::string const& id) const;
+
+    // True when every recorded output of every task is unchanged under `root`.
+    bool AllOutputsMatch(std::filesystem::path const& root, std::size_t threadCount = 0) const;
+
+    // Hashes every output that has no hash yet (outputs carried over from an up-to-date task keep theirs).
+    // An output that cannot be read keeps hash 0 and so never matches on the next run.
+    void HashOutputs(std::filesystem::path const& root, std::size_t threadCount = 0);
+
+    std::uint64_t SourceKey = 0;
+    std::map<std::string, ManifestTask> Tasks; // ordered so the file is stable between runs
+};
+
+// Appends `path` (relative to `root`) to `outputs` in the manifest's generic form.
+void AddManifestOutput(std::vector<ManifestOutput>& outputs,
+                       std::filesystem::path const& root,
+                       std::filesystem::path const& path);
+
+// Deletes files listed in `previous` but not in `current`, including their Unity .meta sidecars, and prunes
+// directories left empty below `root`. Returns the number of files removed.
+std::size_t RemoveOrphanedOutputs(ExportManifest const& previous,
+                                  ExportManifest const& current,
+                                  std::filesystem::path const& root);
+
+} // namespace SeEditor::Export
@@ -0,0 +1,476 @@
+#include "GlbWriter.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string_view>
+
+namespace SeEditor::Export {
+
+namespace {
+
+constexpr std::uint32_t kGlbMagic = 0x46546C67;     // 'glTF'
+constexpr std::uint32_t kGlbVersion = 2;
+constexpr std::uint32_t kChunkJson = 0x4E4F534A;    // 'JSON'
+constexpr std::uint32_t kChunkBin = 0x004E4942;     // 'BIN\0'
+
+constexpr int kComponentUnsignedShort = 5123;
+constexpr int kComponentUnsignedInt = 5125;
+constexpr int kComponentFloat = 5126;
+constexpr int kTargetArrayBuffer = 34962;
+constexpr int kTargetElementArrayBuffer = 34963;
+
+void AppendJsonString(std::string& out, std::string_view s)
+{
+    out.push_back('"');
+    for (char c : s)
+    {
+        switch (c)
+        {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                static const char* hex = "0123456789abcdef";
+                out += "\\u00";
+                out.push_back(hex[(c >> 4) & 0xF]);
+                out.push_back(hex[c & 0xF]);
+            }
+            else
+            {
+                out.push_back(c);
+            }
+            break;
+        }
+    }
+    out.push_back('"');
+}
+
+void AppendNumber(std::string& out, float value)
+{
+    // JSON has no NaN/Inf.
+    if (!std::isfinite(value))
+        value = 0.0f;
+    char chars[64];
+    auto res = std::to_chars(chars, chars + sizeof(chars), value);
+    out.append(chars, res.ptr);
+}
+
+void AppendNumber(std::string& out, std::uint64_t value)
+{
+    char chars[24];
+    auto res = std::to_chars(chars, chars + sizeof(chars), value);
+    out.append(chars, res.ptr);
+}
+
+void AppendNumber(std::string& out, int value)
+{
+    char chars[16];
+    auto res = std::to_chars(chars, chars + sizeof(chars), value);
+    out.append(chars, res.ptr);
+}
+
+template <typename T>
+void AppendNumberArray(std::string& out, T const* values, std::size_t count)
+{
+    out.push_back('[');
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (i > 0)
+            out.push_back(',');
+        AppendNumber(out, values[i]);
+    }
+    out.push_back(']');
+}
+
+void AppendU32(std::vector<std::uint8_t>& out, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        out.push_back(static_cast<std::uint8_t>((value >> (i * 8)) & 0xFFu));
+}
+
+// Accumulates the BIN chunk plus the bufferViews/accessors describing it.
+class BinaryBuilder
+{
+public:
+    std::vector<std::uint8_t> Data;
+    std::string BufferViews;
+    std::string Accessors;
+    int BufferViewCount = 0;
+    int AccessorCount = 0;
+
+    int AddView(void const* bytes, std::size_t size, int target)
+    {
+        while (Data.size() % 4 != 0)
+            Data.push_back(0);
+        const std::size_t offset = Data.size();
+        Data.resize(offset + size);
+        if (size != 0)
+            std::memcpy(Data.data() + offset, bytes, size);
+
+        if (BufferViewCount > 0)
+            BufferViews.push_back(',');
+        BufferViews += "{\"buffer\":0,\"byteOffset\":";
+        AppendNumber(BufferViews, static_cast<std::uint64_t>(offset));
+        BufferViews += ",\"byteLength\":";
+        AppendNumber(BufferViews, static_cast<std::uint64_t>(size));
+        if (target != 0)
+        {
+            BufferViews += ",\"target\":";
+            AppendNumber(BufferViews, target);
+        }
+        BufferViews.push_back('}');
+        return BufferViewCount++;
+    }
+
+    // `min`/`max` (`components` floats each) are required by glTF for POSITION only.
+    int AddAccessor(int view, int componentType, std::size_t count, std::string_view type,
+                    float const* min = nullptr, float const* max = nullptr, std::size_t components = 0)
+    {
+        if (AccessorCount > 0)
+            Accessors.push_back(',');
+        Accessors += "{\"bufferView\":";
+        AppendNumber(Accessors, view);
+        Accessors += ",\"componentType\":";
+        AppendNumber(Accessors, componentType);
+        Accessors += ",\"count\":";
+        AppendNumber(Accessors, static_cast<std::uint64_t>(count));
+        Accessors += ",\"type\":";
+        AppendJsonString(Accessors, type);
+        if (min && max)
+        {
+            Accessors += ",\"min\":";
+            AppendNumberArray(Accessors, min, components);
+            Accessors += ",\"max\":";
+            AppendNumberArray(Accessors, max, components);
+        }
+        Accessors.push_back('}');
+        return AccessorCount++;
+    }
+};
+
+bool EndsWithNoCase(std::string_view s, std::string_view suffix)
+{
+    if (s.size() < suffix.size())
+        return false;
+    for (std::size_t i = 0; i < suffix.size(); ++i)
+    {
+        char a = s[s.size() - suffix.size() + i];
+        char b = suffix[i];
+        if (a >= 'A' && a <= 'Z')
+            a = static_cast<char>(a - 'A' + 'a');
+        if (a != b)
+            return false;
+    }
+    return true;
+}
+
+void AppendPrimitive(std::string& json, BinaryBuilder& bin, GlbPrimitive const& prim)
+{
+    const std::size_t count = prim.Positions.size();
+
+    float minPos[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                       std::numeric_limits<float>::max()};
+    float maxPos[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                       std::numeric_limits<float>::lowest()};
+    for (auto const& p : prim.Positions)
+    {
+        const float v[3] = {p.X, p.Y, p.Z};
+        for (int k = 0; k < 3; ++k)
+        {
+            minPos[k] = std::min(minPos[k], v[k]);
+            maxPos[k] = std::max(maxPos[k], v[k]);
+        }
+    }
+    if (count == 0)
+    {
+        std::fill(minPos, minPos + 3, 0.0f);
+        std::fill(maxPos, maxPos + 3, 0.0f);
+    }
+
+    json += "{\"attributes\":{\"POSITION\":";
+    int view = bin.AddView(prim.Positions.data(), count * sizeof(SlLib::Math::Vector3), kTargetArrayBuffer);
+    AppendNumber(json, bin.AddAccessor(view, kComponentFloat, count, "VEC3", minPos, maxPos, 3));
+    if (prim.Normals.size() == count && count != 0)
+    {
+        json += ",\"NORMAL\":";
+        view = bin.AddView(prim.Normals.data(), count * sizeof(SlLib::Math::Vector3), kTargetArrayBuffer);
+        AppendNumber(json, bin.AddAccessor(view, kComponentFloat, count, "VEC3"));
+    }
+    if (prim.Uvs.size() == count && count != 0)
+    {
+        json += ",\"TEXCOORD_0\":";
+        view = bin.AddView(prim.Uvs.data(), count * sizeof(SlLib::Math::Vector2), kTargetArrayBuffer);
+        AppendNumber(json, bin.AddAccessor(view, kComponentFloat, count, "VEC2"));
+    }
+    if (prim.Joints.size() == count && prim.Weights.size() == count && count != 0)
+    {
+        json += ",\"JOINTS_0\":";
+        view = bin.AddView(prim.Joints.data(), count * sizeof(prim.Joints[0]), kTargetArrayBuffer);
+        AppendNumber(json, bin.AddAccessor(view, kComponentUnsignedShort, count, "VEC4"));
+        json += ",\"WEIGHTS_0\":";
+        view = bin.AddView(prim.Weights.data(), count * sizeof(prim.Weights[0]), kTargetArrayBuffer);
+        AppendNumber(json, bin.AddAccessor(view, kComponentFloat, count, "VEC4"));
+    }
+    json.push_back('}');
+
+    if (!prim.Indices.empty())
+    {
+        const std::uint32_t maxIndex = *std::max_element(prim.Indices.begin(), prim.Indices.end());
+        int accessor = 0;
+        if (maxIndex < 0xFFFFu)
+        {
+            std::vector<std::uint16_t> narrow(prim.Indices.begin(), prim.Indices.end());
+            view = bin.AddView(narrow.data(), narrow.size() * sizeof(std::uint16_t), kTargetElementArrayBuffer);
+            accessor = bin.AddAccessor(view, kComponentUnsignedShort, narrow.size(), "SCALAR");
+        }
+        else
+        {
+            view = bin.AddView(prim.Indices.data(), prim.Indices.size() * sizeof(std::uint32_t), kTargetElementArrayBuffer);
+            accessor = bin.AddAccessor(view, kComponentUnsignedInt, prim.Indices.size(), "SCALAR");
+        }
+        json += ",\"indices\":";
+        AppendNumber(json, accessor);
+    }
+    if (prim.Material >= 0)
+    {
+        json += ",\"material\":";
+        AppendNumber(json, prim.Material);
+    }
+    json += ",\"mode\":4}";
+}
+
+} // namespace
+
+std::vector<std::uint8_t> BuildGlb(GlbDocument const& doc)
+{
+    static_assert(sizeof(SlLib::Math::Vector3) == 12 && sizeof(SlLib::Math::Vector2) == 8,
+                  "vertex arrays are copied into the BIN chunk as-is");
+    static_assert(std::endian::native == std::endian::little, "GLB buffers are little-endian");
+
+    BinaryBuilder bin;
+    std::string json;
+    json.reserve(4096);
+    json += "{\"asset\":{\"version\":\"2.0\",\"generator\":\"SeEditor\"}";
+
+    bool usesDds = false;
+    for (auto const& tex : doc.Textures)
+        usesDds = usesDds || EndsWithNoCase(tex.Uri, ".dds");
+    // DDS images have no PNG/JPEG fallback source, so loaders without the extension must refuse the file
+    // rather than silently render it untextured.
+    if (usesDds)
+        json += ",\"extensionsUsed\":[\"MSFT_texture_dds\"],\"extensionsRequired\":[\"MSFT_texture_dds\"]";
+
+    json += ",\"scene\":0,\"scenes\":[{\"nodes\":";
+    AppendNumberArray(json, doc.SceneNodes.data(), doc.SceneNodes.size());
+    json += "}]";
+
+    if (!doc.Nodes.empty())
+    {
+        json += ",\"nodes\":[";
+        for (std::size_t i = 0; i < doc.Nodes.size(); ++i)
+        {
+            auto const& node = doc.Nodes[i];
+            if (i > 0)
+                json.push_back(',');
+            json += "{\"name\":";
+            AppendJsonString(json, node.Name);
+            const float t[3] = {node.Translation.X, node.Translation.Y, node.Translation.Z};
+            const float r[4] = {node.Rotation.X, node.Rotation.Y, node.Rotation.Z, node.Rotation.W};
+            const float s[3] = {node.Scale.X, node.Scale.Y, node.Scale.Z};
+            json += ",\"translation\":";
+            AppendNumberArray(json, t, 3);
+            json += ",\"rotation\":";
+            AppendNumberArray(json, r, 4);
+            json += ",\"scale\":";
+            AppendNumberArray(json, s, 3);
+            if (!node.Children.empty())
+            {
+                json += ",\"children\":";
+                AppendNumberArray(json, node.Children.data(), node.Children.size());
+            }
+            if (node.Mesh >= 0)
+            {
+                json += ",\"mesh\":";
+                AppendNumber(json, node.Mesh);
+            }
+            if (node.Skin >= 0)
+            {
+                json += ",\"skin\":";
+                AppendNumber(json, node.Skin);
+            }
+            json.push_back('}');
+        }
+        json.push_back(']');
+    }
+
+    // Meshes append to the binary builder; their JSON is assembled separately and emitted after.
+    std::string meshesJson;
+    for (std::size_t i = 0; i < doc.Meshes.size(); ++i)
+    {
+        auto const& mesh = doc.Meshes[i];
+        if (i > 0)
+            meshesJson.push_back(',');
+        meshesJson += "{\"name\":";
+        AppendJsonString(meshesJson, mesh.Name);
+        meshesJson += ",\"primitives\":[";
+        for (std::size_t p = 0; p < mesh.Primitives.size(); ++p)
+        {
+            if (p > 0)
+                meshesJson.push_back(',');
+            AppendPrimitive(meshesJson, bin, mesh.Primitives[p]);
+        }
+        meshesJson += "]}";
+    }
+    if (!doc.Meshes.empty())
+    {
+        json += ",\"meshes\":[";
+        json += meshesJson;
+        json.push_back(']');
+    }
+
+    if (!doc.Skins.empty())
+    {
+        json += ",\"skins\":[";
+        for (std::size_t i = 0; i < doc.Skins.size(); ++i)
+        {
+            auto const& skin = doc.Skins[i];
+            if (i > 0)
+                json.push_back(',');
+            json += "{\"name\":";
+            AppendJsonString(json, skin.Name);
+            json += ",\"joints\":";
+            AppendNumberArray(json, skin.Joints.data(), skin.Joints.size());
+            if (skin.InverseBindMatrices.size() == skin.Joints.size() && !skin.Joints.empty())
+            {
+                // glTF matrices are column-major.
+                std::vector<float> columnMajor;
+                columnMajor.reserve(skin.InverseBindMatrices.size() * 16);
+                for (auto const& m : skin.InverseBindMatrices)
+                    for (std::size_t c = 0; c < 4; ++c)
+                        for (std::size_t r = 0; r < 4; ++r)
+                            columnMajor.push_back(m(r, c));
+                int view = bin.AddView(columnMajor.data(), columnMajor.size() * sizeof(float), 0);
+                json += ",\"inverseBindMatrices\":";
+                AppendNumber(json, bin.AddAccessor(view, kComponentFloat, skin.Joints.size(), "MAT4"));
+            }
+            if (skin.Skeleton >= 0)
+            {
+                json += ",\"skeleton\":";
+                AppendNumber(json, skin.Skeleton);
+            }
+            json.push_back('}');
+        }
+        json.push_back(']');
+    }
+
+    if (!doc.Materials.empty())
+    {
+        json += ",\"materials\":[";
+        for (std::size_t i = 0; i < doc.Materials.size(); ++i)
+        {
+            auto const& mat = doc.Materials[i];
+            if (i > 0)
+                json.push_back(',');
+            json += "{\"name\":";
+            AppendJsonString(json, mat.Name);
+            json += ",\"pbrMetallicRoughness\":{\"metallicFactor\":0";
+            if (mat.Texture >= 0)
+            {
+                json += ",\"baseColorTexture\":{\"index\":";
+                AppendNumber(json, mat.Texture);
+                json.push_back('}');
+            }
+            json += "}}";
+        }
+        json.push_back(']');
+    }
+
+    if (!doc.Textures.empty())
+    {
+        json += ",\"images\":[";
+        for (std::size_t i = 0; i < doc.Textures.size(); ++i)
+        {
+            if (i > 0)
+                json.push_back(',');
+            json += "{\"uri\":";
+            AppendJsonString(json, doc.Textures[i].Uri);
+            json.push_back('}');
+        }
+        json += "],\"textures\":[";
+        for (std::size_t i = 0; i < doc.Textures.size(); ++i)
+        {
+            if (i > 0)
+                json.push_back(',');
+            if (EndsWithNoCase(doc.Textures[i].Uri, ".dds"))
+                json += "{\"extensions\":{\"MSFT_texture_dds\":{\"source\":";
+            else
+                json += "{\"source\":";
+            AppendNumber(json, static_cast<int>(i));
+            json += EndsWithNoCase(doc.Textures[i].Uri, ".dds") ? "}}}" : "}";
+        }
+        json.push_back(']');
+    }
+
+    if (!bin.Data.empty())
+    {
+        json += ",\"buffers\":[{\"byteLength\":";
+        AppendNumber(json, static_cast<std::uint64_t>(bin.Data.size()));
+        json += "}],\"bufferViews\":[";
+        json += bin.BufferViews;
+        json += "],\"accessors\":[";
+        json += bin.Accessors;
+        json.push_back(']');
+    }
+    json.push_back('}');
+
+    while (json.size() % 4 != 0)
+        json.push_back(' ');
+    while (bin.Data.size() % 4 != 0)
+        bin.Data.push_back(0);
+
+    const std::size_t total = 12 + 8 + json.size() + (bin.Data.empty() ? 0 : 8 + bin.Data.size());
+    std::vector<std::uint8_t> out;
+    out.reserve(total);
+    AppendU32(out, kGlbMagic);
+    AppendU32(out, kGlbVersion);
+    AppendU32(out, static_cast<std::uint32_t>(total));
+    AppendU32(out, static_cast<std::uint32_t>(json.size()));
+    AppendU32(out, kChunkJson);
+    out.insert(out.end(), json.begin(), json.end());
+    if (!bin.Data.empty())
+    {
+        AppendU32(out, static_cast<std::uint32_t>(bin.Data.size()));
+        AppendU32(out, kChunkBin);
+        out.insert(out.end(), bin.Data.begin(), bin.Data.end());
+    }
+    return out;
+}
+
+bool WriteGlb(std::filesystem::path const& path, GlbDocument const& doc, std::string& error)
+{
+    const std::vector<std::uint8_t> bytes = BuildGlb(doc);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        error = "Failed to open " + path.string();
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!out)
+    {
+        error = "Failed to write " + path.string();
+        return false;
+    }
+    return true;
+}
+
+} // namespace SeEditor::Export
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SlLib/Math/Vector.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace SeEditor::Export {
+
+// In-memory description of a binary glTF 2.0 file. Indices into the other arrays are plain ints; -1 = none.
+struct GlbPrimitive
+{
+    std::vector<SlLib::Math::Vector3> Positions;
+    std::vector<SlLib::Math::Vector3> Normals; // empty or one per position
+    std::vector<SlLib::Math::Vector2> Uvs;     // empty or one per position
+    std::vector<std::array<std::uint16_t, 4>> Joints; // skin palette indices; empty unless skinned
+    std::vector<std::array<float, 4>> Weights;        // one per position when Joints is set
+    std::vector<std::uint32_t> Indices;                // triangle list
+    int Material = -1;
+};
+
+struct GlbMesh
+{
+    std::string Name;
+    std::vector<GlbPrimitive> Primitives;
+};
+
+struct GlbMaterial
+{
+    std::string Name;
+    int Texture = -1;
+};
+
+// Texture image referenced by URI (relative to the .glb). DDS images are emitted through MSFT_texture_dds.
+struct GlbTexture
+{
+    std::string Uri;
+};
+
+struct GlbNode
+{
+    std::string Name;
+    SlLib::Math::Vector3 Translation{};
+    SlLib::Math::Vector4 Rotation{0.0f, 0.0f, 0.0f, 1.0f}; // quaternion xyzw
+    SlLib::Math::Vector3 Scale{1.0f, 1.0f, 1.0f};
+    std::vector<int> Children;
+    int Mesh = -1;
+    int Skin = -1;
+};
+
+struct GlbSkin
+{
+    std::string Name;
+    std::vector<int> Joints;                                  // node per palette entry
+    std::vector<SlLib::Math::Matrix4x4> InverseBindMatrices; // one per joint (row-major, column vectors)
+    int Skeleton = -1;
+};
+
+struct GlbDocument
+{
+    std::vector<GlbMesh> Meshes;
+    std::vector<GlbMaterial> Materials;
+    std::vector<GlbTexture> Textures;
+    std::vector<GlbNode> Nodes;
+    std::vector<GlbSkin> Skins;
+    std::vector<int> SceneNodes; // roots of the default scene
+};
+
+// Serializes `doc` as a GLB container (JSON chunk + one BIN chunk). Index buffers use 16-bit indices when
+// every index fits.
+std::vector<std::uint8_t> BuildGlb(GlbDocument const& doc);
+
+bool WriteGlb(std::filesystem::path const& path, GlbDocument const& doc, std::string& error);
+
+} // namespace SeEditor::Export
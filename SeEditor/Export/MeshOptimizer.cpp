@@ -0,0 +1,355 @@
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace SeEditor::Export {
+
+namespace {
+
+using SlLib::Math::Vector3;
+
+std::uint64_t HashBytes(const std::uint8_t* data, std::size_t size)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Forsyth's "Linear-Speed Vertex Cache Optimisation" scoring.
+constexpr float kLastTriScore = 0.75f;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+constexpr std::uint32_t kMaxValenceScored = 32;
+constexpr std::uint32_t kMaxCacheSize = 64;
+
+struct ScoreTables
+{
+    std::array<float, kMaxCacheSize + 1> Cache{}; // [0, cacheSize) by position, [cacheSize] = not cached
+    std::array<float, kMaxValenceScored + 1> Valence{};
+};
+
+ScoreTables BuildScoreTables(std::uint32_t cacheSize)
+{
+    ScoreTables tables;
+    for (std::uint32_t pos = 0; pos < cacheSize; ++pos)
+    {
+        if (pos < 3)
+        {
+            tables.Cache[pos] = kLastTriScore;
+        }
+        else
+        {
+            const float scale = 1.0f / static_cast<float>(cacheSize - 3);
+            tables.Cache[pos] = std::pow(1.0f - static_cast<float>(pos - 3) * scale, kCacheDecayPower);
+        }
+    }
+    tables.Cache[cacheSize] = 0.0f;
+    tables.Valence[0] = 0.0f;
+    for (std::uint32_t valence = 1; valence <= kMaxValenceScored; ++valence)
+        tables.Valence[valence] =
+            kValenceBoostScale * std::pow(static_cast<float>(valence), -kValenceBoostPower);
+    return tables;
+}
+
+float VertexScore(ScoreTables const& tables, std::uint32_t cachePos, std::uint32_t remaining)
+{
+    if (remaining == 0)
+        return -1.0f;
+    return tables.Cache[cachePos] + tables.Valence[std::min(remaining, kMaxValenceScored)];
+}
+
+} // namespace
+
+std::size_t BuildWeldRemap(std::span<const std::uint8_t> vertexBytes,
+                           std::size_t vertexCount,
+                           std::size_t stride,
+                           std::vector<std::uint32_t>& remap)
+{
+    remap.assign(vertexCount, kUnusedVertex);
+    if (vertexCount == 0 || stride == 0 || vertexBytes.size() < vertexCount * stride)
+        return 0;
+
+    std::size_t tableSize = 16;
+    while (tableSize < vertexCount * 2)
+        tableSize <<= 1;
+    const std::size_t mask = tableSize - 1;
+    std::vector<std::uint32_t> table(tableSize, kUnusedVertex); // first-occurrence source index per slot
+
+    std::size_t unique = 0;
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        const std::uint8_t* vertex = vertexBytes.data() + i * stride;
+        std::size_t slot = static_cast<std::size_t>(HashBytes(vertex, stride)) & mask;
+        for (;;)
+        {
+            const std::uint32_t existing = table[slot];
+            if (existing == kUnusedVertex)
+            {
+                table[slot] = static_cast<std::uint32_t>(i);
+                remap[i] = static_cast<std::uint32_t>(unique++);
+                break;
+            }
+            if (std::memcmp(vertexBytes.data() + existing * stride, vertex, stride) == 0)
+            {
+                remap[i] = remap[existing];
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+    return unique;
+}
+
+std::size_t BuildFetchRemap(std::span<const std::uint32_t> indices,
+                            std::size_t vertexCount,
+                            std::vector<std::uint32_t>& remap)
+{
+    remap.assign(vertexCount, kUnusedVertex);
+    std::size_t next = 0;
+    for (std::uint32_t idx : indices)
+    {
+        if (remap[idx] == kUnusedVertex)
+            remap[idx] = static_cast<std::uint32_t>(next++);
+    }
+    return next;
+}
+
+void OptimizeVertexCache(std::vector<std::uint32_t>& indices, std::size_t vertexCount, std::uint32_t cacheSize)
+{
+    const std::size_t triCount = indices.size() / 3;
+    if (triCount < 2 || vertexCount == 0)
+        return;
+    cacheSize = std::clamp<std::uint32_t>(cacheSize, 4, kMaxCacheSize);
+    const ScoreTables tables = BuildScoreTables(cacheSize);
+
+    // Vertex -> triangle adjacency (CSR). The live prefix of each list shrinks as triangles are emitted.
+    std::vector<std::uint32_t> remaining(vertexCount, 0);
+    for (std::size_t i = 0; i < triCount * 3; ++i)
+        ++remaining[indices[i]];
+    std::vector<std::uint32_t> offsets(vertexCount + 1, 0);
+    for (std::size_t v = 0; v < vertexCount; ++v)
+        offsets[v + 1] = offsets[v] + remaining[v];
+    std::vector<std::uint32_t> adjacency(triCount * 3);
+    {
+        std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::size_t t = 0; t < triCount; ++t)
+            for (int k = 0; k < 3; ++k)
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<std::uint32_t>(t);
+    }
+
+    std::vector<float> vertexScore(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; ++v)
+        vertexScore[v] = VertexScore(tables, cacheSize, remaining[v]);
+
+    auto triangleScore = [&](std::size_t t) {
+        return vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+    };
+
+    std::vector<std::uint8_t> emitted(triCount, 0);
+    std::size_t best = 0;
+    float bestScore = triangleScore(0);
+    for (std::size_t t = 1; t < triCount; ++t)
+    {
+        const float score = triangleScore(t);
+        if (score > bestScore)
+        {
+            bestScore = score;
+            best = t;
+        }
+    }
+
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<std::uint32_t> cache;
+    std::vector<std::uint32_t> nextCache;
+    cache.reserve(cacheSize + 3);
+    nextCache.reserve(cacheSize + 3);
+    std::size_t fallbackCursor = 0;
+    constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+    for (std::size_t emittedCount = 0; emittedCount < triCount; ++emittedCount)
+    {
+        if (best == kNone)
+        {
+            // Nothing in the cache touches unemitted work; resume with the next triangle in input order.
+            while (emitted[fallbackCursor])
+                ++fallbackCursor;
+            best = fallbackCursor;
+        }
+
+        const std::uint32_t tri[3] = {indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2]};
+        output.insert(output.end(), tri, tri + 3);
+        emitted[best] = 1;
+
+        for (std::uint32_t v : tri)
+        {
+            std::uint32_t* list = adjacency.data() + offsets[v];
+            std::uint32_t& live = remaining[v];
+            for (std::uint32_t i = 0; i < live; ++i)
+            {
+                if (list[i] == best)
+                {
+                    // Keep the live prefix ordered so later scans stay deterministic.
+                    std::copy(list + i + 1, list + live, list + i);
+                    --live;
+                    break;
+                }
+            }
+        }
+
+        // New LRU state: the emitted triangle first, then the previous entries.
+        nextCache.clear();
+        for (std::uint32_t v : tri)
+            if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end())
+                nextCache.push_back(v);
+        for (std::uint32_t v : cache)
+            if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end())
+                nextCache.push_back(v);
+
+        for (std::size_t i = cacheSize; i < nextCache.size(); ++i)
+        {
+            const std::uint32_t v = nextCache[i];
+            vertexScore[v] = VertexScore(tables, cacheSize, remaining[v]);
+        }
+        if (nextCache.size() > cacheSize)
+            nextCache.resize(cacheSize);
+        for (std::size_t i = 0; i < nextCache.size(); ++i)
+        {
+            const std::uint32_t v = nextCache[i];
+            vertexScore[v] = VertexScore(tables, static_cast<std::uint32_t>(i), remaining[v]);
+        }
+
+        // Only triangles touching the cache changed score; the best of them is the next candidate.
+        best = kNone;
+        bestScore = -1.0f;
+        for (std::uint32_t v : nextCache)
+        {
+            const std::uint32_t* list = adjacency.data() + offsets[v];
+            for (std::uint32_t i = 0; i < remaining[v]; ++i)
+            {
+                const std::uint32_t t = list[i];
+                const float score = triangleScore(t);
+                if (score > bestScore || (score == bestScore && t < best))
+                {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+        cache.swap(nextCache);
+    }
+
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void OptimizeOverdraw(std::vector<std::uint32_t>& indices,
+                      std::span<const Vector3> positions,
+                      std::uint32_t cacheSize)
+{
+    const std::size_t triCount = indices.size() / 3;
+    if (triCount < 2 || positions.empty())
+        return;
+    cacheSize = std::clamp<std::uint32_t>(cacheSize, 4, kMaxCacheSize);
+
+    // Cluster boundaries: triangles that miss the FIFO cache on all three vertices.
+    std::vector<std::size_t> clusterStarts;
+    {
+        std::vector<std::uint32_t> fifo(cacheSize, kUnusedVertex);
+        std::size_t head = 0;
+        for (std::size_t t = 0; t < triCount; ++t)
+        {
+            int misses = 0;
+            for (int k = 0; k < 3; ++k)
+            {
+                const std::uint32_t v = indices[t * 3 + k];
+                if (std::find(fifo.begin(), fifo.end(), v) == fifo.end())
+                {
+                    fifo[head] = v;
+                    head = (head + 1) % cacheSize;
+                    ++misses;
+                }
+            }
+            if (t == 0 || misses == 3)
+                clusterStarts.push_back(t);
+        }
+    }
+    if (clusterStarts.size() < 2)
+        return;
+
+    Vector3 meshCenter{};
+    double area = 0.0;
+    std::vector<Vector3> clusterCenter(clusterStarts.size());
+    std::vector<Vector3> clusterNormal(clusterStarts.size());
+    for (std::size_t c = 0; c < clusterStarts.size(); ++c)
+    {
+        const std::size_t begin = clusterStarts[c];
+        const std::size_t end = c + 1 < clusterStarts.size() ? clusterStarts[c + 1] : triCount;
+        Vector3 center{};
+        Vector3 normal{};
+        float clusterArea = 0.0f;
+        for (std::size_t t = begin; t < end; ++t)
+        {
+            Vector3 const& a = positions[indices[t * 3]];
+            Vector3 const& b = positions[indices[t * 3 + 1]];
+            Vector3 const& c0 = positions[indices[t * 3 + 2]];
+            const Vector3 n = cross(b - a, c0 - a); // length is twice the triangle area
+            const float w = length(n);
+            center = center + (a + b + c0) * (w / 3.0f);
+            normal = normal + n;
+            clusterArea += w;
+        }
+        meshCenter = meshCenter + center;
+        area += clusterArea;
+        clusterCenter[c] = clusterArea > 0.0f ? center / clusterArea : positions[indices[begin * 3]];
+        const float normalLength = length(normal);
+        clusterNormal[c] = normalLength > 0.0f ? normal / normalLength : Vector3{};
+    }
+    if (area > 0.0)
+        meshCenter = meshCenter / static_cast<float>(area);
+
+    std::vector<float> key(clusterStarts.size());
+    for (std::size_t c = 0; c < clusterStarts.size(); ++c)
+        key[c] = dot(clusterCenter[c] - meshCenter, clusterNormal[c]);
+
+    std::vector<std::size_t> order(clusterStarts.size());
+    for (std::size_t c = 0; c < order.size(); ++c)
+        order[c] = c;
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return key[a] > key[b]; });
+
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+    for (std::size_t c : order)
+    {
+        const std::size_t begin = clusterStarts[c];
+        const std::size_t end = c + 1 < clusterStarts.size() ? clusterStarts[c + 1] : triCount;
+        output.insert(output.end(), indices.begin() + begin * 3, indices.begin() + end * 3);
+    }
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+bool ParseMeshOptimizeArg(std::string_view arg, MeshOptimizeOptions& options)
+{
+    if (arg == "--no-weld")
+        options.WeldVertices = false;
+    else if (arg == "--no-vertex-cache")
+        options.OptimizeVertexCache = false;
+    else if (arg == "--no-vertex-fetch")
+        options.OptimizeVertexFetch = false;
+    else if (arg == "--overdraw")
+        options.OptimizeOverdraw = true;
+    else if (arg == "--no-mesh-opt")
+        options = MeshOptimizeOptions{false, false, false, false, options.CacheSize};
+    else
+        return false;
+    return true;
+}
+
+} // namespace SeEditor::Export
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <SlLib/Math/Vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace SeEditor::Export {
+
+// Per-submesh optimization applied before meshes are written out. Every pass is deterministic: the same
+// input always produces the same vertex and index order, independent of platform or thread count.
+struct MeshOptimizeOptions
+{
+    bool WeldVertices = true;        // merge bit-identical vertices
+    bool OptimizeVertexCache = true; // reorder triangles for post-transform cache hits (Forsyth)
+    bool OptimizeOverdraw = false;   // sort cache-friendly clusters front-to-back; needs OptimizeVertexCache
+    bool OptimizeVertexFetch = true; // renumber vertices in first-use order, drop unreferenced ones
+    std::uint32_t CacheSize = 32;
+
+    bool Any() const { return WeldVertices || OptimizeVertexCache || OptimizeOverdraw || OptimizeVertexFetch; }
+};
+
+inline constexpr std::uint32_t kUnusedVertex = 0xFFFFFFFFu;
+
+// Fills `remap[i]` with the welded index of vertex i; duplicates map to their first occurrence and unique
+// vertices keep first-occurrence order. Vertices are compared by their raw bytes. Returns the unique count.
+std::size_t BuildWeldRemap(std::span<const std::uint8_t> vertexBytes,
+                           std::size_t vertexCount,
+                           std::size_t stride,
+                           std::vector<std::uint32_t>& remap);
+
+// Fills `remap[i]` with the position of vertex i in first-use order of `indices`; unreferenced vertices get
+// kUnusedVertex. Returns the number of referenced vertices.
+std::size_t BuildFetchRemap(std::span<const std::uint32_t> indices,
+                            std::size_t vertexCount,
+                            std::vector<std::uint32_t>& remap);
+
+// Reorders whole triangles in place for an LRU cache of `cacheSize` entries. Ties are broken by the lowest
+// input triangle, so the result is stable. A trailing partial triangle is left at the end untouched.
+void OptimizeVertexCache(std::vector<std::uint32_t>& indices, std::size_t vertexCount, std::uint32_t cacheSize);
+
+// Splits an already cache-optimized list into clusters at cache restarts and orders the clusters so the
+// most outward-facing ones draw first. Triangle order inside a cluster is preserved.
+void OptimizeOverdraw(std::vector<std::uint32_t>& indices,
+                      std::span<const SlLib::Math::Vector3> positions,
+                      std::uint32_t cacheSize);
+
+// Applies `remap` to both streams. `remap` must map every referenced vertex below `newVertexCount`.
+template <typename Vertex>
+void ApplyVertexRemap(std::vector<Vertex>& vertices,
+                      std::vector<std::uint32_t>& indices,
+                      std::vector<std::uint32_t> const& remap,
+                      std::size_t newVertexCount)
+{
+    std::vector<Vertex> remapped(newVertexCount);
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+        if (remap[i] != kUnusedVertex)
+            remapped[remap[i]] = vertices[i];
+    }
+    vertices.swap(remapped);
+    for (auto& idx : indices)
+        idx = remap[idx];
+}
+
+// Runs the enabled passes in order: weld, vertex cache, overdraw, vertex fetch.
+// `Vertex` must be trivially copyable with a `Vector3 Pos` member; indices must be in range.
+template <typename Vertex>
+void OptimizeMesh(std::vector<Vertex>& vertices, std::vector<std::uint32_t>& indices, MeshOptimizeOptions const& options)
+{
+    static_assert(std::is_trivially_copyable_v<Vertex>, "vertices are welded by their bytes");
+    if (vertices.empty() || indices.empty() || !options.Any())
+        return;
+
+    std::vector<std::uint32_t> remap;
+    if (options.WeldVertices)
+    {
+        std::span<const std::uint8_t> bytes(reinterpret_cast<const std::uint8_t*>(vertices.data()),
+                                            vertices.size() * sizeof(Vertex));
+        std::size_t unique = BuildWeldRemap(bytes, vertices.size(), sizeof(Vertex), remap);
+        if (unique != vertices.size())
+            ApplyVertexRemap(vertices, indices, remap, unique);
+    }
+
+    if (options.OptimizeVertexCache)
+    {
+        OptimizeVertexCache(indices, vertices.size(), options.CacheSize);
+        if (options.OptimizeOverdraw)
+        {
+            std::vector<SlLib::Math::Vector3> positions;
+            positions.reserve(vertices.size());
+            for (auto const& v : vertices)
+                positions.push_back(v.Pos);
+            OptimizeOverdraw(indices, positions, options.CacheSize);
+        }
+    }
+
+    if (options.OptimizeVertexFetch)
+    {
+        std::size_t used = BuildFetchRemap(indices, vertices.size(), remap);
+        ApplyVertexRemap(vertices, indices, remap, used);
+    }
+}
+
+// Parses one of the shared command-line switches (--no-weld, --no-vertex-cache, --no-vertex-fetch,
+// --overdraw, --no-mesh-opt). Returns false if `arg` is not a mesh optimization switch.
+bool ParseMeshOptimizeArg(std::string_view arg, MeshOptimizeOptions& options);
+
+} // namespace SeEditor::Export
@@ -0,0 +1,175 @@
+#include "TextMeshWriter.hpp"
+
+#include "SlLib/Utilities/ParallelFor.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+namespace SeEditor::Export {
+
+namespace {
+
+// Longest fixed-notation float: 39 integer digits, sign, point and the clamped precision.
+constexpr int kMaxFixedPrecision = 16;
+constexpr std::size_t kFloatCharsMax = 64;
+constexpr std::size_t kIntCharsMax = 24;
+
+std::FILE* OpenForWrite(std::filesystem::path const& path)
+{
+#ifdef _WIN32
+    return _wfopen(path.c_str(), L"wb");
+#else
+    return std::fopen(path.c_str(), "wb");
+#endif
+}
+
+} // namespace
+
+BufferedTextWriter::BufferedTextWriter(TextFormatOptions options, std::size_t bufferSize)
+    : _options(options), _bufferSize(std::max<std::size_t>(bufferSize, 4096))
+{
+    _options.Precision = std::clamp(_options.Precision, 0, kMaxFixedPrecision);
+    _buffer.reserve(_bufferSize);
+}
+
+BufferedTextWriter::~BufferedTextWriter()
+{
+    Close();
+}
+
+bool BufferedTextWriter::Open(std::filesystem::path const& path)
+{
+    Close();
+    _buffer.clear();
+    _failed = false;
+    _file = OpenForWrite(path);
+    if (!_file)
+        return false;
+    // The buffer here already batches everything; stdio buffering would only add a copy.
+    std::setvbuf(_file, nullptr, _IONBF, 0);
+    return true;
+}
+
+bool BufferedTextWriter::Close()
+{
+    if (!_file)
+        return !_failed;
+    Flush();
+    if (std::fclose(_file) != 0)
+        _failed = true;
+    _file = nullptr;
+    return !_failed;
+}
+
+void BufferedTextWriter::Flush()
+{
+    if (!_file || _buffer.empty())
+        return;
+    if (std::fwrite(_buffer.data(), 1, _buffer.size(), _file) != _buffer.size())
+        _failed = true;
+    _buffer.clear();
+}
+
+void BufferedTextWriter::Put(std::string_view text)
+{
+    if (_file && text.size() > _bufferSize)
+    {
+        Flush();
+        if (std::fwrite(text.data(), 1, text.size(), _file) != text.size())
+            _failed = true;
+        return;
+    }
+    Reserve(text.size());
+    _buffer.insert(_buffer.end(), text.begin(), text.end());
+}
+
+void BufferedTextWriter::PutFloat(float value)
+{
+    char chars[kFloatCharsMax];
+    std::to_chars_result res = _options.Floats == FloatFormat::Fixed
+                                   ? std::to_chars(chars, chars + sizeof(chars), value, std::chars_format::fixed,
+                                                   _options.Precision)
+                                   : std::to_chars(chars, chars + sizeof(chars), value);
+    Put(std::string_view(chars, static_cast<std::size_t>(res.ptr - chars)));
+}
+
+void BufferedTextWriter::PutUInt(std::uint64_t value)
+{
+    char chars[kIntCharsMax];
+    auto res = std::to_chars(chars, chars + sizeof(chars), value);
+    Put(std::string_view(chars, static_cast<std::size_t>(res.ptr - chars)));
+}
+
+void BufferedTextWriter::PutInt(std::int64_t value)
+{
+    char chars[kIntCharsMax];
+    auto res = std::to_chars(chars, chars + sizeof(chars), value);
+    Put(std::string_view(chars, static_cast<std::size_t>(res.ptr - chars)));
+}
+
+void BufferedTextWriter::PutVec3(std::string_view tag, float x, float y, float z)
+{
+    Reserve(tag.size() + 3 * (kFloatCharsMax + 1) + 1);
+    Put(tag);
+    Put(' ');
+    PutFloat(x);
+    Put(' ');
+    PutFloat(y);
+    Put(' ');
+    PutFloat(z);
+    Put('\n');
+}
+
+void BufferedTextWriter::PutVec2(std::string_view tag, float x, float y)
+{
+    Reserve(tag.size() + 2 * (kFloatCharsMax + 1) + 1);
+    Put(tag);
+    Put(' ');
+    PutFloat(x);
+    Put(' ');
+    PutFloat(y);
+    Put('\n');
+}
+
+void BufferedTextWriter::PutFace(std::uint64_t a, std::uint64_t b, std::uint64_t c)
+{
+    Put("f ");
+    PutUInt(a);
+    Put(' ');
+    PutUInt(b);
+    Put(' ');
+    PutUInt(c);
+    Put('\n');
+}
+
+void BufferedTextWriter::PutFaceVtn(std::uint64_t a, std::uint64_t b, std::uint64_t c)
+{
+    Put("f ");
+    const std::uint64_t corners[3] = {a, b, c};
+    for (int k = 0; k < 3; ++k)
+    {
+        PutUInt(corners[k]);
+        Put('/');
+        PutUInt(corners[k]);
+        Put('/');
+        PutUInt(corners[k]);
+        Put(k < 2 ? ' ' : '\n');
+    }
+}
+
+bool WriteTextFiles(std::span<TextFileJob> jobs, std::size_t threadCount, TextFormatOptions const& options)
+{
+    SlLib::Utilities::ParallelFor(jobs.size(), threadCount, [&](std::size_t i) {
+        TextFileJob& job = jobs[i];
+        BufferedTextWriter writer(options);
+        job.Success = writer.Open(job.Path);
+        if (!job.Success)
+            return;
+        if (job.Write)
+            job.Write(writer);
+        job.Success = writer.Close();
+    });
+    return std::all_of(jobs.begin(), jobs.end(), [](TextFileJob const& job) { return job.Success; });
+}
+
+} // namespace SeEditor::Export
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SeEditor::Export {
+
+enum class FloatFormat : std::uint8_t
+{
+    Shortest, // shortest text that parses back to the same float
+    Fixed     // fixed notation with TextFormatOptions::Precision decimals
+};
+
+struct TextFormatOptions
+{
+    FloatFormat Floats = FloatFormat::Shortest;
+    int Precision = 6;
+};
+
+// Text output for OBJ/MTL and similar formats. Numbers are formatted with std::to_chars (locale independent)
+// into a large buffer that is handed to the file in one write per buffer. Without a file the writer only
+// accumulates text, which lets callers format chunks on several threads and splice them with Put.
+class BufferedTextWriter
+{
+public:
+    static constexpr std::size_t kDefaultBufferSize = std::size_t{1} << 20;
+
+    explicit BufferedTextWriter(TextFormatOptions options = {}, std::size_t bufferSize = kDefaultBufferSize);
+    ~BufferedTextWriter();
+
+    BufferedTextWriter(BufferedTextWriter const&) = delete;
+    BufferedTextWriter& operator=(BufferedTextWriter const&) = delete;
+
+    bool Open(std::filesystem::path const& path);
+    // Flushes and closes the file. Returns false if any write since Open failed.
+    bool Close();
+    bool IsOpen() const { return _file != nullptr; }
+
+    // Accumulated text that has not been flushed yet (everything, in memory mode).
+    std::string_view Buffered() const { return {_buffer.data(), _buffer.size()}; }
+    void Clear() { _buffer.clear(); }
+
+    void Put(char c)
+    {
+        Reserve(1);
+        _buffer.push_back(c);
+    }
+    // Blocks larger than the buffer bypass it and go to the file directly.
+    void Put(std::string_view text);
+    void PutFloat(float value);
+    void PutUInt(std::uint64_t value);
+    void PutInt(std::int64_t value);
+
+    // "<tag> x y z\n" / "<tag> x y\n"
+    void PutVec3(std::string_view tag, float x, float y, float z);
+    void PutVec2(std::string_view tag, float x, float y);
+    // "f a b c\n" and "f a/a/a b/b/b c/c/c\n"; indices are written as given (OBJ indices are 1-based).
+    void PutFace(std::uint64_t a, std::uint64_t b, std::uint64_t c);
+    void PutFaceVtn(std::uint64_t a, std::uint64_t b, std::uint64_t c);
+
+private:
+    void Reserve(std::size_t bytes)
+    {
+        if (_file && _buffer.size() + bytes > _bufferSize)
+            Flush();
+    }
+    void Flush();
+
+    TextFormatOptions _options;
+    std::size_t _bufferSize;
+    std::vector<char> _buffer;
+    std::FILE* _file = nullptr;
+    bool _failed = false;
+};
+
+struct TextFileJob
+{
+    std::filesystem::path Path;
+    std::function<void(BufferedTextWriter&)> Write;
+    bool Success = false;
+};
+
+// Writes every job's file on up to `threadCount` workers (0 = hardware threads); sets each job's Success.
+// Returns true if all files were written.
+bool WriteTextFiles(std::span<TextFileJob> jobs, std::size_t threadCount, TextFormatOptions const& options = {});
+
+} // namespace SeEditor::Export
@@ -0,0 +1,87 @@
+#include "TextureStore.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+namespace SeEditor::Export {
+
+namespace {
+
+std::string ToHex64(std::uint64_t value)
+{
+    std::string out(16, '0');
+    for (int i = 15; i >= 0; --i)
+    {
+        out[static_cast<std::size_t>(i)] = "0123456789abcdef"[value & 0xF];
+        value >>= 4;
+    }
+    return out;
+}
+
+} // namespace
+
+TextureStore::TextureStore(std::filesystem::path root, bool contentNames)
+    : _root(std::move(root)), _contentNames(contentNames)
+{
+}
+
+std::size_t TextureStore::Intern(std::span<const std::uint8_t> bytes, std::string_view name, std::string_view extension)
+{
+    const std::uint64_t hash = HashContent64(bytes);
+    auto [first, last] = _byHash.equal_range(hash);
+    for (auto it = first; it != last; ++it)
+    {
+        Entry const& existing = _entries[it->second];
+        if (existing.Bytes.size() == bytes.size() &&
+            (bytes.empty() || std::memcmp(existing.Bytes.data(), bytes.data(), bytes.size()) == 0))
+        {
+            ++_stats.Duplicates;
+            _stats.DuplicateBytes += bytes.size();
+            return it->second;
+        }
+    }
+
+    // Names are compared case-insensitively since the exports are consumed on Windows.
+    auto nameKey = [&](std::string const& fileName) {
+        std::string key = fileName + std::string(extension);
+        for (char& c : key)
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return key;
+    };
+    const std::string base = _contentNames ? ToHex64(hash) : (name.empty() ? std::string("tex") : std::string(name));
+    std::string fileName = base;
+    // In content-named mode only a true 64-bit collision between different payloads gets a suffix.
+    for (std::size_t suffix = 1; _usedNames.count(nameKey(fileName)) != 0; ++suffix)
+        fileName = base + "_" + std::to_string(suffix);
+    _usedNames.insert(nameKey(fileName));
+
+    const std::size_t index = _entries.size();
+    _entries.push_back({hash, bytes, _root / (fileName + std::string(extension))});
+    _byHash.emplace(hash, index);
+    ++_stats.Unique;
+    return index;
+}
+
+bool TextureStore::Write(std::size_t index) const
+{
+    Entry const& entry = _entries[index];
+    if (entry.Bytes.empty())
+        return false;
+
+    std::error_code ec;
+    if (_contentNames && std::filesystem::file_size(entry.Path, ec) == entry.Bytes.size() && !ec)
+        return true;
+
+    std::filesystem::create_directories(entry.Path.parent_path(), ec);
+    if (ec)
+        return false;
+
+    std::ofstream out(entry.Path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+    out.write(reinterpret_cast<const char*>(entry.Bytes.data()), static_cast<std::streamsize>(entry.Bytes.size()));
+    return static_cast<bool>(out);
+}
+
+} // namespace SeEditor::Export
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ContentHash.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace SeEditor::Export {
+
+struct TextureStoreStats
+{
+    std::size_t Unique = 0;
+    std::size_t Duplicates = 0;
+    std::uint64_t DuplicateBytes = 0; // payload bytes that did not have to be written again
+};
+
+// Content-addressed texture registry for an export. Every payload is hashed; identical payloads resolve to
+// one canonical file no matter which resource, forest or SIF they came from. Hash matches are confirmed
+// byte for byte, so distinct payloads never share a file.
+//
+// By default files keep the first resource name seen (name clashes between different payloads get a
+// numeric suffix). With `contentNames` files are named after the payload hash instead, which makes a
+// directory shared by several exports deduplicate across them: an existing file of the right size is the
+// same texture and is not written again.
+class TextureStore
+{
+public:
+    TextureStore(std::filesystem::path root, bool contentNames = false);
+
+    // Registers a payload and returns its entry index. `bytes` must stay alive as long as the store.
+    // Not thread-safe; intern on one thread, then Write entries in parallel.
+    std::size_t Intern(std::span<const std::uint8_t> bytes, std::string_view name, std::string_view extension);
+
+    std::size_t Size() const { return _entries.size(); }
+    std::filesystem::path const& PathOf(std::size_t index) const { return _entries[index].Path; }
+    std::uint64_t HashOf(std::size_t index) const { return _entries[index].Hash; }
+
+    // Writes entry `index` to its path. In content-named mode an existing file of the same size is kept.
+    // Different indices may be written concurrently.
+    bool Write(std::size_t index) const;
+
+    TextureStoreStats const& Stats() const { return _stats; }
+
+private:
+    struct Entry
+    {
+        std::uint64_t Hash = 0;
+        std::span<const std::uint8_t> Bytes;
+        std::filesystem::path Path;
+    };
+
+    std::filesystem::path _root;
+    bool _contentNames = false;
+    std::vector<Entry> _entries;
+    std::unordered_multimap<std::uint64_t, std::size_t> _byHash;
+    std::unordered_set<std::string> _usedNames;
+    TextureStoreStats _stats;
+};
+
+} // namespace SeEditor::Export
@@ -147,6 +147,7 @@ struct SuRenderTexture;
 struct SuRenderMaterial;
 struct SuRenderVertexStream;
 struct SuRenderPrimitive;
+struct DecodedPrimitiveIndices;
 struct SuRenderMesh;
 struct SuLodThreshold;
 struct SuLodBranch;
@@ -293,6 +294,9 @@ struct SuRenderPrimitive
     int Unknown_0x9c = 0;
     int Unknown_0xa0 = 0;
 
+    // Triangle list cache filled by GetDecodedPrimitiveIndices (PrimitiveIndices.hpp).
+    mutable std::shared_ptr<const DecodedPrimitiveIndices> DecodedIndices;
+
     void Load(SlLib::Serialization::ResourceLoadContext& context);
     int GetSizeForSerialization() const;
 };
@@ -0,0 +1,306 @@
+#include "PrimitiveIndices.hpp"
+
+#include "ForestTypes.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+namespace SeEditor::Forest {
+
+namespace {
+
+// Guards SuRenderPrimitive::DecodedIndices; only held for the pointer swap, never while decoding.
+std::mutex& DecodedIndexCacheMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::size_t IndexCount16(SuRenderPrimitive const& primitive)
+{
+    std::size_t count = primitive.IndexData.size() / 2;
+    if (primitive.NumIndices > 0)
+        count = std::min<std::size_t>(count, static_cast<std::size_t>(primitive.NumIndices));
+    return count;
+}
+
+std::size_t IndexCount32(SuRenderPrimitive const& primitive)
+{
+    if (primitive.IndexData.size() % 4 != 0)
+        return 0;
+    std::size_t count = primitive.IndexData.size() / 4;
+    if (primitive.NumIndices > 0)
+        count = std::min<std::size_t>(count, static_cast<std::size_t>(primitive.NumIndices));
+    return count;
+}
+
+template <PrimitiveIndexFormat Format>
+constexpr bool kIs32Bit = Format == PrimitiveIndexFormat::U32LE || Format == PrimitiveIndexFormat::U32BE;
+
+template <PrimitiveIndexFormat Format>
+constexpr std::uint32_t kRestartIndex = kIs32Bit<Format> ? 0xFFFFFFFFu : 0xFFFFu;
+
+template <PrimitiveIndexFormat Format>
+std::uint32_t LoadIndex(const std::uint8_t* data, std::size_t i)
+{
+    if constexpr (Format == PrimitiveIndexFormat::U16LE)
+    {
+        const std::uint8_t* p = data + i * 2;
+        return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8);
+    }
+    else if constexpr (Format == PrimitiveIndexFormat::U16BE)
+    {
+        const std::uint8_t* p = data + i * 2;
+        return (static_cast<std::uint32_t>(p[0]) << 8) | static_cast<std::uint32_t>(p[1]);
+    }
+    else if constexpr (Format == PrimitiveIndexFormat::U32LE)
+    {
+        const std::uint8_t* p = data + i * 4;
+        return static_cast<std::uint32_t>(p[0]) |
+               (static_cast<std::uint32_t>(p[1]) << 8) |
+               (static_cast<std::uint32_t>(p[2]) << 16) |
+               (static_cast<std::uint32_t>(p[3]) << 24);
+    }
+    else
+    {
+        const std::uint8_t* p = data + i * 4;
+        return (static_cast<std::uint32_t>(p[0]) << 24) |
+               (static_cast<std::uint32_t>(p[1]) << 16) |
+               (static_cast<std::uint32_t>(p[2]) << 8) |
+               static_cast<std::uint32_t>(p[3]);
+    }
+}
+
+template <PrimitiveIndexFormat Format>
+void DecodeTriangles(std::uint8_t const* data,
+                     PrimitiveIndexLayout const& layout,
+                     std::size_t vertexLimit,
+                     std::vector<std::uint32_t>& out)
+{
+    constexpr std::uint32_t restartIndex = kRestartIndex<Format>;
+
+    if (!layout.IsStrip)
+    {
+        out.resize(layout.Count);
+        std::uint32_t* dst = out.data();
+        for (std::size_t i = 0; i < layout.Count; ++i)
+        {
+            const std::uint32_t idx = LoadIndex<Format>(data, i);
+            if (idx == restartIndex || static_cast<std::size_t>(idx) >= vertexLimit)
+                continue;
+            *dst++ = idx;
+        }
+        out.resize(static_cast<std::size_t>(dst - out.data()));
+        return;
+    }
+
+    // Every emitted triangle consumes at least one index past the first two.
+    out.resize(layout.Count >= 3 ? (layout.Count - 2) * 3 : 0);
+    std::uint32_t* dst = out.data();
+    bool have0 = false;
+    bool have1 = false;
+    std::uint32_t i0 = 0;
+    std::uint32_t i1 = 0;
+    bool flip = false;
+    for (std::size_t i = 0; i < layout.Count; ++i)
+    {
+        const std::uint32_t idx = LoadIndex<Format>(data, i);
+        if (idx == restartIndex)
+        {
+            have0 = false;
+            have1 = false;
+            flip = false;
+            continue;
+        }
+        if (static_cast<std::size_t>(idx) >= vertexLimit)
+            continue;
+        if (!have0)
+        {
+            i0 = idx;
+            have0 = true;
+            continue;
+        }
+        if (!have1)
+        {
+            i1 = idx;
+            have1 = true;
+            continue;
+        }
+        if (i0 != i1 && i1 != idx && i0 != idx)
+        {
+            dst[0] = flip ? i1 : i0;
+            dst[1] = flip ? i0 : i1;
+            dst[2] = idx;
+            dst += 3;
+        }
+        i0 = i1;
+        i1 = idx;
+        flip = !flip;
+    }
+    out.resize(static_cast<std::size_t>(dst - out.data()));
+}
+
+} // namespace
+
+PrimitiveIndexLayout ClassifyPrimitiveIndices(SuRenderPrimitive const& primitive, std::size_t vertexLimit)
+{
+    const std::size_t count16 = IndexCount16(primitive);
+    const std::size_t count32 = IndexCount32(primitive);
+    const std::uint8_t* data = primitive.IndexData.data();
+
+    // Indices are compared as 32-bit values; a clamped limit only ever matches the 32-bit restart marker,
+    // which is excluded below anyway.
+    const std::uint32_t limit = static_cast<std::uint32_t>(
+        std::min<std::size_t>(vertexLimit, std::numeric_limits<std::uint32_t>::max()));
+
+    // Restart markers are all-ones, so they read the same in either byte order.
+    std::size_t restart16 = 0, drop16le = 0, drop16be = 0;
+    std::size_t restart32 = 0, drop32le = 0, drop32be = 0;
+
+    // One sweep over 4-byte groups feeds all four candidate modes. When the buffer is 32-bit aligned the
+    // 32-bit count always covers these groups (it is clamped by the same NumIndices), so `in32` is invariant.
+    // The body is branch-free with 32-bit lanes so the compiler can vectorize the compares; totals are
+    // flushed per block so the lane counters cannot overflow.
+    constexpr std::size_t kTallyBlock = 1 << 16;
+    const std::size_t groups = count16 / 2;
+    const std::uint32_t in32 = count32 != 0 ? 1u : 0u;
+    const std::uint32_t limitHi = limit >> 16;
+    const std::uint32_t limitLo = limit & 0xFFFFu;
+    for (std::size_t blockStart = 0; blockStart < groups; blockStart += kTallyBlock)
+    {
+        const std::uint8_t* block = data + blockStart * 4;
+        const std::size_t blockGroups = std::min(kTallyBlock, groups - blockStart);
+
+        std::uint32_t r16 = 0, d16le = 0, d16be = 0;
+        std::uint32_t r32 = 0, d32le = 0, d32be = 0;
+        for (std::size_t g = 0; g < blockGroups; ++g)
+        {
+            std::uint32_t word = 0;
+            std::memcpy(&word, block + g * 4, sizeof(word));
+            if constexpr (std::endian::native == std::endian::big)
+                word = (word >> 24) | ((word >> 8) & 0xFF00u) | ((word << 8) & 0xFF0000u) | (word << 24);
+
+            const std::uint32_t le0 = word & 0xFFFFu;
+            const std::uint32_t le1 = word >> 16;
+            const std::uint32_t be0 = ((word & 0xFFu) << 8) | ((word >> 8) & 0xFFu);
+            const std::uint32_t be1 = ((word >> 8) & 0xFF00u) | (word >> 24);
+
+            const std::uint32_t rs0 = le0 == 0xFFFFu;
+            const std::uint32_t rs1 = le1 == 0xFFFFu;
+            r16 += rs0 + rs1;
+            d16le += ((le0 >= limit) & (rs0 ^ 1u)) + ((le1 >= limit) & (rs1 ^ 1u));
+            d16be += ((be0 >= limit) & (rs0 ^ 1u)) + ((be1 >= limit) & (rs1 ^ 1u));
+
+            const std::uint32_t rs32 = word == 0xFFFFFFFFu;
+            r32 += rs32 & in32;
+            d32le += (word >= limit) & (rs32 ^ 1u) & in32;
+            // be32 >= limit, compared by halves (a composed byte swap defeats the vectorizer).
+            const std::uint32_t be32Above = (be0 > limitHi) | ((be0 == limitHi) & (be1 >= limitLo));
+            d32be += be32Above & (rs32 ^ 1u) & in32;
+        }
+
+        restart16 += r16;
+        drop16le += d16le;
+        drop16be += d16be;
+        restart32 += r32;
+        drop32le += d32le;
+        drop32be += d32be;
+    }
+
+    // Odd trailing 16-bit index.
+    if (count16 % 2 != 0)
+    {
+        const std::uint32_t le = LoadIndex<PrimitiveIndexFormat::U16LE>(data, count16 - 1);
+        const std::uint32_t be = LoadIndex<PrimitiveIndexFormat::U16BE>(data, count16 - 1);
+        if (le == 0xFFFFu)
+            ++restart16;
+        else
+        {
+            drop16le += le >= limit;
+            drop16be += be >= limit;
+        }
+    }
+
+    // NumIndices clamps the count regardless of width, so 32-bit mode can read past the 16-bit range.
+    for (std::size_t g = groups; g < count32; ++g)
+    {
+        const std::uint32_t le = LoadIndex<PrimitiveIndexFormat::U32LE>(data, g);
+        const std::uint32_t be = LoadIndex<PrimitiveIndexFormat::U32BE>(data, g);
+        if (le == 0xFFFFFFFFu)
+            ++restart32;
+        else
+        {
+            drop32le += le >= limit;
+            drop32be += be >= limit;
+        }
+    }
+
+    PrimitiveIndexLayout best;
+    best.Format = PrimitiveIndexFormat::U16LE;
+    best.Count = count16;
+    best.Droppable = drop16le;
+    best.Restart = restart16;
+
+    auto consider = [&](PrimitiveIndexFormat format, std::size_t count, std::size_t droppable, std::size_t restart) {
+        if (count == 0 || droppable >= best.Droppable)
+            return;
+        best.Format = format;
+        best.Count = count;
+        best.Droppable = droppable;
+        best.Restart = restart;
+    };
+    consider(PrimitiveIndexFormat::U16BE, count16, drop16be, restart16);
+    consider(PrimitiveIndexFormat::U32LE, count32, drop32le, restart32);
+    consider(PrimitiveIndexFormat::U32BE, count32, drop32be, restart32);
+
+    const int primitiveType = primitive.Unknown_0x9c;
+    best.IsStrip = primitiveType == 5 || (primitiveType != 4 && best.Restart > 0);
+    return best;
+}
+
+void DecodePrimitiveTriangles(SuRenderPrimitive const& primitive,
+                              PrimitiveIndexLayout const& layout,
+                              std::size_t vertexLimit,
+                              std::vector<std::uint32_t>& out)
+{
+    const std::uint8_t* data = primitive.IndexData.data();
+    switch (layout.Format)
+    {
+    case PrimitiveIndexFormat::U16LE:
+        DecodeTriangles<PrimitiveIndexFormat::U16LE>(data, layout, vertexLimit, out);
+        break;
+    case PrimitiveIndexFormat::U16BE:
+        DecodeTriangles<PrimitiveIndexFormat::U16BE>(data, layout, vertexLimit, out);
+        break;
+    case PrimitiveIndexFormat::U32LE:
+        DecodeTriangles<PrimitiveIndexFormat::U32LE>(data, layout, vertexLimit, out);
+        break;
+    case PrimitiveIndexFormat::U32BE:
+        DecodeTriangles<PrimitiveIndexFormat::U32BE>(data, layout, vertexLimit, out);
+        break;
+    }
+}
+
+std::shared_ptr<const DecodedPrimitiveIndices> GetDecodedPrimitiveIndices(SuRenderPrimitive const& primitive,
+                                                                         std::size_t vertexLimit)
+{
+    {
+        std::lock_guard<std::mutex> lock(DecodedIndexCacheMutex());
+        if (primitive.DecodedIndices && primitive.DecodedIndices->VertexLimit == vertexLimit)
+            return primitive.DecodedIndices;
+    }
+
+    auto decoded = std::make_shared<DecodedPrimitiveIndices>();
+    decoded->VertexLimit = vertexLimit;
+    decoded->Layout = ClassifyPrimitiveIndices(primitive, vertexLimit);
+    DecodePrimitiveTriangles(primitive, decoded->Layout, vertexLimit, decoded->Triangles);
+
+    std::lock_guard<std::mutex> lock(DecodedIndexCacheMutex());
+    primitive.DecodedIndices = decoded;
+    return decoded;
+}
+
+} // namespace SeEditor::Forest
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SeEditor::Forest {
+
+struct SuRenderPrimitive;
+
+enum class PrimitiveIndexFormat : std::uint8_t
+{
+    U16LE,
+    U16BE,
+    U32LE,
+    U32BE
+};
+
+// Result of classifying a primitive's raw index buffer against a vertex count.
+struct PrimitiveIndexLayout
+{
+    PrimitiveIndexFormat Format = PrimitiveIndexFormat::U16LE;
+    bool IsStrip = false;
+    std::size_t Count = 0;     // indices of `Format` width to consume
+    std::size_t Droppable = 0; // indices >= vertexLimit (excluding restarts)
+    std::size_t Restart = 0;   // 0xFFFF / 0xFFFFFFFF markers
+
+    bool Is32Bit() const { return Format == PrimitiveIndexFormat::U32LE || Format == PrimitiveIndexFormat::U32BE; }
+};
+
+struct DecodedPrimitiveIndices
+{
+    std::size_t VertexLimit = 0;
+    PrimitiveIndexLayout Layout{};
+    std::vector<std::uint32_t> Triangles; // triangle list, strips already unrolled
+};
+
+// Picks index width/endianness and topology in one pass over IndexData.
+// The mode with the fewest out-of-range indices wins (16LE, 16BE, 32LE, 32BE on ties).
+PrimitiveIndexLayout ClassifyPrimitiveIndices(SuRenderPrimitive const& primitive, std::size_t vertexLimit);
+
+// Writes the triangle list for `layout` into `out` (resized to fit). Out-of-range indices are skipped,
+// restarts reset the strip and degenerate strip triangles are dropped.
+void DecodePrimitiveTriangles(SuRenderPrimitive const& primitive,
+                              PrimitiveIndexLayout const& layout,
+                              std::size_t vertexLimit,
+                              std::vector<std::uint32_t>& out);
+
+// Classify + decode, cached on the primitive per vertexLimit. Safe to call from multiple threads.
+std::shared_ptr<const DecodedPrimitiveIndices> GetDecodedPrimitiveIndices(SuRenderPrimitive const& primitive,
+                                                                         std::size_t vertexLimit);
+
+} // namespace SeEditor::Forest
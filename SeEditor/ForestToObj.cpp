@@ -1,5 +1,10 @@
 #include "SeEditor/Forest/ForestArchive.hpp"
 #include "Forest/ForestTypes.hpp"
+#include "Forest/PrimitiveIndices.hpp"
+#include "Export/GlbWriter.hpp"
+#include "Export/MeshOptimizer.hpp"
+#include "Export/TextMeshWriter.hpp"
+#include "SlLib/Utilities/ParallelFor.hpp"
 #include "SifParser.hpp"
 
 #include <SlLib/Math/Vector.hpp>
@@ -11,12 +16,14 @@
 #include <cctype>
 #include <cstdint>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -256,14 +263,39 @@ bool TryParseForestArchive(std::span<const std::uint8_t> input,
 
 int main(int argc, char** argv)
 {
-    if (argc != 3)
+    SeEditor::Export::MeshOptimizeOptions meshOptions;
+    SeEditor::Export::TextFormatOptions textOptions;
+    bool splitOutput = false;
+    bool glbOutput = false;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i)
     {
-        std::cout << "forest_to_obj <track.Forest> <output.obj>\n";
+        std::string arg = argv[i];
+        if (SeEditor::Export::ParseMeshOptimizeArg(arg, meshOptions))
+            continue;
+        if (arg == "--split")
+            splitOutput = true;
+        else if (arg == "--glb")
+            glbOutput = true;
+        else if (arg == "--fixed" && i + 1 < argc)
+        {
+            textOptions.Floats = SeEditor::Export::FloatFormat::Fixed;
+            textOptions.Precision = std::atoi(argv[++i]);
+        }
+        else
+            positional.push_back(std::move(arg));
+    }
+
+    if (positional.size() != 2)
+    {
+        std::cout << "forest_to_obj <track.Forest> <output.obj | output_dir with --split | output.glb with --glb> [options]\n";
+        std::cout << "Options: --split (one OBJ per mesh chunk) --glb (binary glTF, one node per chunk) --fixed <decimals>\n";
+        std::cout << "Mesh options: --no-weld --no-vertex-cache --no-vertex-fetch --overdraw --no-mesh-opt\n";
         return 1;
     }
 
-    std::filesystem::path inputPath(argv[1]);
-    std::filesystem::path outputPath(argv[2]);
+    std::filesystem::path inputPath(positional[0]);
+    std::filesystem::path outputPath(positional[1]);
 
     std::ifstream input(inputPath, std::ios::binary);
     if (!input)
@@ -358,201 +390,15 @@ int main(int argc, char** argv)
                     v.Normal = {0.0f, 1.0f, 0.0f};
             }
 
-            std::size_t indexCount = primitive->IndexData.size() / 2;
-            if (primitive->NumIndices > 0)
-                indexCount = std::min<std::size_t>(indexCount, static_cast<std::size_t>(primitive->NumIndices));
-            else if (indexCount == 0)
-                continue;
-
-            std::size_t vertexLimit = verts.size();
-            struct IndexMode
-            {
-                bool Use32 = false;
-                bool Swap = false;
-                std::size_t Count = 0;
-                std::size_t Droppable = 0;
-                std::size_t Restart = 0;
-            };
-
-            auto eval16 = [&](bool swap) {
-                IndexMode mode;
-                mode.Use32 = false;
-                mode.Swap = swap;
-                mode.Count = indexCount;
-                for (std::size_t i = 0; i < indexCount; ++i)
-                {
-                    std::uint16_t a = primitive->IndexData[i * 2];
-                    std::uint16_t b = primitive->IndexData[i * 2 + 1];
-                    std::uint16_t idx = swap ? static_cast<std::uint16_t>((a << 8) | b)
-                                             : static_cast<std::uint16_t>(a | (b << 8));
-                    if (idx == 0xFFFFu)
-                    {
-                        ++mode.Restart;
-                        continue;
-                    }
-                    if (static_cast<std::size_t>(idx) >= vertexLimit)
-                        ++mode.Droppable;
-                }
-                return mode;
-            };
-
-            auto eval32 = [&](bool swap) {
-                IndexMode mode;
-                mode.Use32 = true;
-                mode.Swap = swap;
-                if (primitive->IndexData.size() % 4 != 0)
-                    return mode;
-                mode.Count = primitive->IndexData.size() / 4;
-                if (primitive->NumIndices > 0)
-                    mode.Count = std::min<std::size_t>(mode.Count,
-                        static_cast<std::size_t>(primitive->NumIndices));
-                for (std::size_t i = 0; i < mode.Count; ++i)
-                {
-                    std::size_t off = i * 4;
-                    std::uint32_t idx = static_cast<std::uint32_t>(primitive->IndexData[off + 0] |
-                        (primitive->IndexData[off + 1] << 8) |
-                        (primitive->IndexData[off + 2] << 16) |
-                        (primitive->IndexData[off + 3] << 24));
-                    if (swap)
-                    {
-                        idx = ((idx & 0x000000FFu) << 24) |
-                              ((idx & 0x0000FF00u) << 8) |
-                              ((idx & 0x00FF0000u) >> 8) |
-                              ((idx & 0xFF000000u) >> 24);
-                    }
-                    if (idx == 0xFFFFFFFFu)
-                    {
-                        ++mode.Restart;
-                        continue;
-                    }
-                    if (idx >= vertexLimit)
-                        ++mode.Droppable;
-                }
-                return mode;
-            };
-
-            IndexMode best = eval16(false);
-            IndexMode cand16be = eval16(true);
-            if (cand16be.Droppable < best.Droppable)
-                best = cand16be;
-
-            IndexMode cand32le = eval32(false);
-            if (cand32le.Count > 0 && cand32le.Droppable < best.Droppable)
-                best = cand32le;
-
-            IndexMode cand32be = eval32(true);
-            if (cand32be.Count > 0 && cand32be.Droppable < best.Droppable)
-                best = cand32be;
-
-            bool use32Bit = best.Use32;
-            bool swapIndices = best.Swap;
-            std::vector<std::uint32_t> rawIndices;
-            rawIndices.reserve(best.Count);
-            if (use32Bit)
-            {
-                for (std::size_t i = 0; i < best.Count; ++i)
-                {
-                    std::size_t off = i * 4;
-                    std::uint32_t idx = static_cast<std::uint32_t>(primitive->IndexData[off + 0] |
-                        (primitive->IndexData[off + 1] << 8) |
-                        (primitive->IndexData[off + 2] << 16) |
-                        (primitive->IndexData[off + 3] << 24));
-                    if (swapIndices)
-                    {
-                        idx = ((idx & 0x000000FFu) << 24) |
-                              ((idx & 0x0000FF00u) << 8) |
-                              ((idx & 0x00FF0000u) >> 8) |
-                              ((idx & 0xFF000000u) >> 24);
-                    }
-                    rawIndices.push_back(idx);
-                }
-            }
-            else
-            {
-                for (std::size_t i = 0; i < best.Count; ++i)
-                {
-                    std::uint16_t a = primitive->IndexData[i * 2];
-                    std::uint16_t b = primitive->IndexData[i * 2 + 1];
-                    std::uint16_t idx = swapIndices ? static_cast<std::uint16_t>((a << 8) | b)
-                                                    : static_cast<std::uint16_t>(a | (b << 8));
-                    rawIndices.push_back(idx);
-                }
-            }
-
-            int primitiveType = primitive->Unknown_0x9c;
-            bool isStrip = primitiveType == 5 || (primitiveType != 4 && best.Restart > 0);
-            std::vector<std::uint32_t> validIndices;
-            if (isStrip)
-            {
-                validIndices.reserve(rawIndices.size());
-                bool have0 = false;
-                bool have1 = false;
-                std::uint32_t i0 = 0;
-                std::uint32_t i1 = 0;
-                bool flip = false;
-                for (std::uint32_t idx : rawIndices)
-                {
-                    if ((use32Bit && idx == 0xFFFFFFFFu) || (!use32Bit && idx == 0xFFFFu))
-                    {
-                        have0 = false;
-                        have1 = false;
-                        flip = false;
-                        continue;
-                    }
-                    if (idx >= vertexLimit)
-                        continue;
-                    if (!have0)
-                    {
-                        i0 = idx;
-                        have0 = true;
-                        continue;
-                    }
-                    if (!have1)
-                    {
-                        i1 = idx;
-                        have1 = true;
-                        continue;
-                    }
-                    if (i0 != i1 && i1 != idx && i0 != idx)
-                    {
-                        if (flip)
-                        {
-                            validIndices.push_back(i1);
-                            validIndices.push_back(i0);
-                            validIndices.push_back(idx);
-                        }
-                        else
-                        {
-                            validIndices.push_back(i0);
-                            validIndices.push_back(i1);
-                            validIndices.push_back(idx);
-                        }
-                    }
-                    i0 = i1;
-                    i1 = idx;
-                    flip = !flip;
-                }
-            }
-            else
-            {
-                validIndices.reserve(rawIndices.size());
-                for (std::uint32_t idx : rawIndices)
-                {
-                    if ((use32Bit && idx == 0xFFFFFFFFu) || (!use32Bit && idx == 0xFFFFu))
-                        continue;
-                    if (idx >= vertexLimit)
-                        continue;
-                    validIndices.push_back(idx);
-                }
-            }
-
-            if (validIndices.empty())
+            auto decoded = GetDecodedPrimitiveIndices(*primitive, verts.size());
+            if (decoded->Triangles.empty())
                 continue;
 
             MeshOutput meshOut;
             meshOut.Name = sourceName + "_prim" + std::to_string(primIdx);
             meshOut.Vertices = std::move(verts);
-            meshOut.Indices = std::move(validIndices);
+            meshOut.Indices = decoded->Triangles;
+            SeEditor::Export::OptimizeMesh(meshOut.Vertices, meshOut.Indices, meshOptions);
             outputs.emplace_back(std::move(meshOut));
         }
     };
@@ -636,38 +482,108 @@ int main(int argc, char** argv)
         return 5;
     }
 
-    std::ofstream obj(outputPath);
-    if (!obj)
-    {
-        std::cerr << "Failed to open " << outputPath << " for writing.\n";
-        return 6;
-    }
-
-    std::size_t vertexBase = 1;
-    for (auto const& mesh : outputs)
-    {
-        obj << "o " << SanitizeName(mesh.Name) << '\n';
+    auto writeMesh = [&](SeEditor::Export::BufferedTextWriter& obj, MeshOutput const& mesh, std::size_t vertexBase) {
+        obj.Put("o ");
+        obj.Put(SanitizeName(mesh.Name));
+        obj.Put('\n');
         for (auto const& v : mesh.Vertices)
-            obj << "v " << v.Pos.X << ' ' << v.Pos.Y << ' ' << v.Pos.Z << '\n';
+            obj.PutVec3("v", v.Pos.X, v.Pos.Y, v.Pos.Z);
         for (auto const& v : mesh.Vertices)
-            obj << "vn " << v.Normal.X << ' ' << v.Normal.Y << ' ' << v.Normal.Z << '\n';
+            obj.PutVec3("vn", v.Normal.X, v.Normal.Y, v.Normal.Z);
         for (auto const& v : mesh.Vertices)
-            obj << "vt " << v.Uv.X << ' ' << v.Uv.Y << '\n';
-
+            obj.PutVec2("vt", v.Uv.X, v.Uv.Y);
         for (std::size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+            obj.PutFaceVtn(vertexBase + mesh.Indices[i], vertexBase + mesh.Indices[i + 1], vertexBase + mesh.Indices[i + 2]);
+    };
+
+    if (glbOutput)
+    {
+        // Chunks are already in world space, so every node sits directly under the scene.
+        SeEditor::Export::GlbDocument doc;
+        for (auto const& mesh : outputs)
         {
-            obj << "f ";
-            for (int v = 0; v < 3; ++v)
+            SeEditor::Export::GlbPrimitive prim;
+            prim.Positions.reserve(mesh.Vertices.size());
+            prim.Normals.reserve(mesh.Vertices.size());
+            prim.Uvs.reserve(mesh.Vertices.size());
+            for (auto const& v : mesh.Vertices)
             {
-                std::size_t idx = mesh.Indices[i + v];
-                obj << vertexBase + idx << '/' << vertexBase + idx << '/' << vertexBase + idx;
-                if (v < 2)
-                    obj << ' ';
+                prim.Positions.push_back(v.Pos);
+                prim.Normals.push_back(v.Normal);
+                prim.Uvs.push_back(v.Uv);
             }
-            obj << '\n';
+            prim.Indices = mesh.Indices;
+
+            SeEditor::Export::GlbMesh glbMesh;
+            glbMesh.Name = SanitizeName(mesh.Name);
+            glbMesh.Primitives.push_back(std::move(prim));
+            SeEditor::Export::GlbNode node;
+            node.Name = glbMesh.Name;
+            node.Mesh = static_cast<int>(doc.Meshes.size());
+            doc.Meshes.push_back(std::move(glbMesh));
+            doc.SceneNodes.push_back(static_cast<int>(doc.Nodes.size()));
+            doc.Nodes.push_back(std::move(node));
+        }
+
+        std::string error;
+        if (!SeEditor::Export::WriteGlb(outputPath, doc, error))
+        {
+            std::cerr << error << '\n';
+            return 6;
+        }
+    }
+    else if (splitOutput)
+    {
+        // One OBJ per mesh chunk, written concurrently.
+        std::error_code ec;
+        std::filesystem::create_directories(outputPath, ec);
+        std::vector<SeEditor::Export::TextFileJob> jobs(outputs.size());
+        for (std::size_t i = 0; i < outputs.size(); ++i)
+        {
+            jobs[i].Path = outputPath / (std::to_string(i) + "_" + SanitizeName(outputs[i].Name) + ".obj");
+            jobs[i].Write = [&, i](SeEditor::Export::BufferedTextWriter& obj) { writeMesh(obj, outputs[i], 1); };
+        }
+        if (!SeEditor::Export::WriteTextFiles(jobs, 0, textOptions))
+        {
+            std::cerr << "Failed to write one or more OBJ files to " << outputPath << ".\n";
+            return 6;
+        }
+    }
+    else
+    {
+        SeEditor::Export::BufferedTextWriter obj(textOptions);
+        if (!obj.Open(outputPath))
+        {
+            std::cerr << "Failed to open " << outputPath << " for writing.\n";
+            return 6;
         }
 
-        vertexBase += mesh.Vertices.size();
+        // Chunks are formatted in parallel into memory and spliced in order, one batch of a chunk per
+        // worker at a time so memory stays bounded by the batch rather than the whole forest.
+        std::vector<std::size_t> vertexBase(outputs.size(), 1);
+        for (std::size_t i = 1; i < outputs.size(); ++i)
+            vertexBase[i] = vertexBase[i - 1] + outputs[i - 1].Vertices.size();
+        constexpr std::size_t kChunkBufferSize = 64 * 1024; // initial reserve; in-memory writers grow as needed
+        const std::size_t batchSize = std::min(SlLib::Utilities::ResolveThreadCount(0), outputs.size());
+        std::vector<std::unique_ptr<SeEditor::Export::BufferedTextWriter>> chunks(batchSize);
+        for (auto& chunk : chunks)
+            chunk = std::make_unique<SeEditor::Export::BufferedTextWriter>(textOptions, kChunkBufferSize);
+        for (std::size_t first = 0; first < outputs.size(); first += batchSize)
+        {
+            const std::size_t count = std::min(batchSize, outputs.size() - first);
+            SlLib::Utilities::ParallelFor(count, 0, [&](std::size_t i) {
+                chunks[i]->Clear();
+                writeMesh(*chunks[i], outputs[first + i], vertexBase[first + i]);
+            });
+            for (std::size_t i = 0; i < count; ++i)
+                obj.Put(chunks[i]->Buffered());
+        }
+
+        if (!obj.Close())
+        {
+            std::cerr << "Failed to write " << outputPath << ".\n";
+            return 6;
+        }
     }
 
     std::cout << "Exported " << outputs.size() << " mesh chunks to " << outputPath << ".\n";
@@ -0,0 +1,235 @@
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SeEditor {
+
+namespace {
+
+bool ReadWholeFile(std::filesystem::path const& path, std::vector<std::uint8_t>& bytes, std::string& error)
+{
+    errno = 0;
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        error = errno != 0 ? std::generic_category().message(errno) : "unable to open file";
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    const std::streamoff size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (size < 0)
+    {
+        error = "unable to determine the file size";
+        return false;
+    }
+    bytes.resize(static_cast<std::size_t>(size));
+    if (!bytes.empty() && !file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(size)))
+    {
+        error = "read failed";
+        return false;
+    }
+    return true;
+}
+
+#if !defined(_WIN32)
+// madvise wants page-aligned starts. Prefetches widen the range out to whole pages; releases shrink it to
+// the pages fully inside the range so data a neighbouring reader still needs is not dropped.
+void Advise(void* base, std::size_t size, std::size_t offset, std::size_t length, int advice, bool shrink)
+{
+    if (!base || offset >= size || length == 0)
+        return;
+    static const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    std::size_t start = offset - offset % pageSize;
+    std::size_t end = std::min(size, offset + length);
+    if (shrink)
+    {
+        if (start != offset)
+            start += pageSize;
+        if (end != size)
+            end -= end % pageSize;
+        if (start >= end)
+            return;
+    }
+    madvise(static_cast<std::uint8_t*>(base) + start, end - start, advice);
+}
+#endif
+
+} // namespace
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+        _mapping = std::exchange(other._mapping, nullptr);
+#if defined(_WIN32)
+        _fileHandle = std::exchange(other._fileHandle, nullptr);
+        _mappingHandle = std::exchange(other._mappingHandle, nullptr);
+#endif
+        _buffer = std::move(other._buffer);
+        other._buffer.clear();
+    }
+    return *this;
+}
+
+bool MappedFile::Open(std::filesystem::path const& path, std::string& error, AccessHint hint)
+{
+    Close();
+
+#if defined(_WIN32)
+    const DWORD flags = hint == AccessHint::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                        : hint == AccessHint::Random ? FILE_FLAG_RANDOM_ACCESS
+                                                     : FILE_ATTRIBUTE_NORMAL;
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER size{};
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        {
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping)
+            {
+                void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (view)
+                {
+                    _fileHandle = file;
+                    _mappingHandle = mapping;
+                    _mapping = view;
+                    _data = static_cast<const std::uint8_t*>(view);
+                    _size = static_cast<std::size_t>(size.QuadPart);
+                    return true;
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+    else
+    {
+        error = std::system_category().message(static_cast<int>(GetLastError()));
+        return false;
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            const std::size_t size = static_cast<std::size_t>(st.st_size);
+            void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED)
+            {
+                // The mapping keeps the file referenced; the descriptor is not needed any more.
+                ::close(fd);
+                const int advice = hint == AccessHint::Sequential ? MADV_SEQUENTIAL
+                                   : hint == AccessHint::Random   ? MADV_RANDOM
+                                                                  : MADV_NORMAL;
+                madvise(view, size, advice);
+                _mapping = view;
+                _data = static_cast<const std::uint8_t*>(view);
+                _size = size;
+                return true;
+            }
+        }
+        ::close(fd);
+    }
+    else
+    {
+        error = std::generic_category().message(errno);
+        return false;
+    }
+#endif
+
+    // Empty files cannot be mapped, and some file systems refuse to; read those the plain way.
+    if (!ReadWholeFile(path, _buffer, error))
+        return false;
+    _data = _buffer.data();
+    _size = _buffer.size();
+    return true;
+}
+
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+    if (_mapping)
+        UnmapViewOfFile(_mapping);
+    if (_mappingHandle)
+        CloseHandle(static_cast<HANDLE>(_mappingHandle));
+    if (_fileHandle)
+        CloseHandle(static_cast<HANDLE>(_fileHandle));
+    _fileHandle = nullptr;
+    _mappingHandle = nullptr;
+#else
+    if (_mapping)
+        munmap(_mapping, _size);
+#endif
+    _mapping = nullptr;
+    _data = nullptr;
+    _size = 0;
+    _buffer.clear();
+    _buffer.shrink_to_fit();
+}
+
+void MappedFile::WillNeed(std::size_t offset, std::size_t length) const
+{
+#if defined(_WIN32)
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+    if (!_mapping || offset >= _size || length == 0)
+        return;
+    WIN32_MEMORY_RANGE_ENTRY range{};
+    range.VirtualAddress = const_cast<std::uint8_t*>(_data) + offset;
+    range.NumberOfBytes = std::min(length, _size - offset);
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    (void)offset;
+    (void)length;
+#endif
+#else
+    Advise(_mapping, _size, offset, length, MADV_WILLNEED, false);
+#endif
+}
+
+void MappedFile::DontNeed(std::size_t offset, std::size_t length) const
+{
+#if defined(_WIN32)
+    (void)offset;
+    (void)length;
+#else
+    Advise(_mapping, _size, offset, length, MADV_DONTNEED, true);
+#endif
+}
+
+} // namespace SeEditor
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SeEditor {
+
+// Read-only view of a whole file. The file is memory-mapped where the platform allows it and read into
+// memory otherwise, so callers always get one contiguous span either way.
+class MappedFile
+{
+public:
+    enum class AccessHint
+    {
+        Normal,
+        Sequential,
+        Random,
+    };
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // On failure `error` holds the reason, e.g. the OS message for a file that cannot be opened.
+    bool Open(std::filesystem::path const& path, std::string& error, AccessHint hint = AccessHint::Normal);
+    void Close();
+
+    std::span<const std::uint8_t> Bytes() const { return {_data, _size}; }
+    std::size_t Size() const { return _size; }
+    bool IsMapped() const { return _mapping != nullptr; }
+
+    // Tells the OS a range is about to be read / will not be read again. No-ops for the buffered fallback.
+    void WillNeed(std::size_t offset, std::size_t length) const;
+    void DontNeed(std::size_t offset, std::size_t length) const;
+
+private:
+    const std::uint8_t* _data = nullptr;
+    std::size_t _size = 0;
+    void* _mapping = nullptr;
+#if defined(_WIN32)
+    void* _fileHandle = nullptr;
+    void* _mappingHandle = nullptr;
+#endif
+    std::vector<std::uint8_t> _buffer;
+};
+
+} // namespace SeEditor
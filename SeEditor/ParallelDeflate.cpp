@@ -0,0 +1,143 @@
+#include "ParallelDeflate.hpp"
+
+#include "SlLib/Utilities/ParallelFor.hpp"
+
+#include <algorithm>
+#include <array>
+
+#ifdef Z_SOLO
+#undef Z_SOLO
+#endif
+#include <zlib.h>
+
+namespace SeEditor {
+
+namespace {
+
+constexpr std::size_t kWindowSize = 32 * 1024;
+
+// Runs deflate() over `input` until `flush` completes, appending to `out`.
+bool DeflateAll(z_stream& stream, std::span<const std::uint8_t> input, int flush, std::vector<std::uint8_t>& out)
+{
+    stream.next_in = const_cast<std::uint8_t*>(input.data());
+    stream.avail_in = static_cast<uInt>(input.size());
+    std::array<std::uint8_t, 16 * 1024> buffer{};
+    int status = Z_OK;
+    do
+    {
+        stream.next_out = buffer.data();
+        stream.avail_out = static_cast<uInt>(buffer.size());
+        status = deflate(&stream, flush);
+        if (status == Z_STREAM_ERROR)
+            return false;
+        out.insert(out.end(), buffer.begin(), buffer.begin() + (buffer.size() - stream.avail_out));
+    } while (stream.avail_out == 0);
+    return flush != Z_FINISH || status == Z_STREAM_END;
+}
+
+bool CompressSingle(std::span<const std::uint8_t> input, std::vector<std::uint8_t>& out, int level, std::string& error)
+{
+    z_stream stream{};
+    if (deflateInit(&stream, level) != Z_OK)
+    {
+        error = "Failed to init zlib deflater.";
+        return false;
+    }
+    out.clear();
+    out.reserve(deflateBound(&stream, static_cast<uLong>(input.size())));
+    const bool ok = DeflateAll(stream, input, Z_FINISH, out);
+    deflateEnd(&stream);
+    if (!ok)
+        error = "Zlib compression failed.";
+    return ok;
+}
+
+// Same two bytes deflateInit writes for `level` with the default strategy and a 32 KiB window.
+std::array<std::uint8_t, 2> ZlibHeader(int level)
+{
+    unsigned levelFlags = 3;
+    if (level >= 0 && level < 2)
+        levelFlags = 0;
+    else if (level >= 2 && level < 6)
+        levelFlags = 1;
+    else if (level == 6 || level == Z_DEFAULT_COMPRESSION)
+        levelFlags = 2;
+    unsigned header = (0x78u << 8) | (levelFlags << 6);
+    header += 31 - header % 31;
+    return {static_cast<std::uint8_t>(header >> 8), static_cast<std::uint8_t>(header & 0xFF)};
+}
+
+} // namespace
+
+bool CompressZlibStream(std::span<const std::uint8_t> input,
+                        std::vector<std::uint8_t>& out,
+                        ZlibCompressOptions const& options,
+                        std::string& error)
+{
+    const std::size_t blockSize = options.BlockSize;
+    if (blockSize == 0 || input.size() <= blockSize || SlLib::Utilities::ResolveThreadCount(options.Threads) == 1)
+        return CompressSingle(input, out, options.Level, error);
+
+    // pigz layout: every block is a raw deflate stream that knows the previous 32 KiB as its dictionary and
+    // ends on a byte boundary (sync flush), except the last, which finishes the stream. Concatenated behind
+    // a zlib header and followed by the Adler-32 of the whole input they form one ordinary zlib stream.
+    const std::size_t blockCount = (input.size() + blockSize - 1) / blockSize;
+    struct Block
+    {
+        std::vector<std::uint8_t> Data;
+        uLong Adler = 0;
+        bool Ok = false;
+    };
+    std::vector<Block> blocks(blockCount);
+
+    SlLib::Utilities::ParallelFor(blockCount, options.Threads, [&](std::size_t index) {
+        Block& block = blocks[index];
+        const std::size_t begin = index * blockSize;
+        const std::size_t size = std::min(blockSize, input.size() - begin);
+        const std::span<const std::uint8_t> chunk = input.subspan(begin, size);
+        const bool last = index + 1 == blockCount;
+
+        z_stream stream{};
+        if (deflateInit2(&stream, options.Level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            return;
+        if (index > 0)
+        {
+            const std::size_t dictSize = std::min(kWindowSize, begin);
+            deflateSetDictionary(&stream, input.data() + begin - dictSize, static_cast<uInt>(dictSize));
+        }
+        block.Data.reserve(deflateBound(&stream, static_cast<uLong>(size)));
+        block.Ok = DeflateAll(stream, chunk, last ? Z_FINISH : Z_SYNC_FLUSH, block.Data);
+        deflateEnd(&stream);
+        block.Adler = adler32(adler32(0, nullptr, 0), chunk.data(), static_cast<uInt>(chunk.size()));
+    });
+
+    std::size_t total = 2 + 4;
+    for (Block const& block : blocks)
+    {
+        if (!block.Ok)
+        {
+            error = "Zlib compression failed.";
+            return false;
+        }
+        total += block.Data.size();
+    }
+
+    out.clear();
+    out.reserve(total);
+    const auto header = ZlibHeader(options.Level);
+    out.insert(out.end(), header.begin(), header.end());
+    uLong adler = adler32(0, nullptr, 0);
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+        out.insert(out.end(), blocks[i].Data.begin(), blocks[i].Data.end());
+        const std::size_t size = std::min(blockSize, input.size() - i * blockSize);
+        adler = adler32_combine(adler, blocks[i].Adler, static_cast<z_off_t>(size));
+    }
+    out.push_back(static_cast<std::uint8_t>(adler >> 24));
+    out.push_back(static_cast<std::uint8_t>(adler >> 16));
+    out.push_back(static_cast<std::uint8_t>(adler >> 8));
+    out.push_back(static_cast<std::uint8_t>(adler));
+    return true;
+}
+
+} // namespace SeEditor
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SeEditor {
+
+struct ZlibCompressOptions
+{
+    int Level = 9;
+    // Inputs larger than this are split into blocks of this size and deflated on several threads. Each
+    // block is primed with the 32 KiB before it, so the ratio stays close to a single stream. 0 (the
+    // default) disables splitting; smaller inputs always produce exactly what a single deflate() call does.
+    static constexpr std::size_t kDefaultBlockSize = std::size_t{1} << 20;
+    std::size_t BlockSize = 0;
+    std::size_t Threads = 0; // 0 = hardware threads
+};
+
+// Compresses `input` into one standard zlib stream (RFC 1950) that any inflater can read.
+bool CompressZlibStream(std::span<const std::uint8_t> input,
+                        std::vector<std::uint8_t>& out,
+                        ZlibCompressOptions const& options,
+                        std::string& error);
+
+} // namespace SeEditor
@@ -8,7 +8,12 @@
 #include "XpacUnpacker.hpp"
 #include "Editor/Scene.hpp"
 #include "Forest/ForestTypes.hpp"
+#include "Forest/PrimitiveIndices.hpp"
 #include "SlLib/Resources/Database/SlPlatform.hpp"
+#include "SlLib/SumoTool/Siff/Logic/TriggerBvh.hpp"
+#include "SlLib/SumoTool/Siff/NavData/NavGraph.hpp"
+#include "SlLib/SumoTool/Siff/NavData/NavLinkGrid.hpp"
+#include "SlLib/Utilities/ParallelFor.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -27,6 +32,7 @@
 #endif
 #include <zlib.h>
 #include <functional>
+#include <cstdio>
 #include <cstring>
 #include <cmath>
 
@@ -78,24 +84,29 @@ std::uint64_t HashFnv1a64(std::span<const std::uint8_t> data)
     return hash;
 }
 
-std::vector<std::uint8_t> CompressWithParams(std::span<const std::uint8_t> input,
-                                             int level,
-                                             int wbits,
-                                             int memLevel,
-                                             int strategy,
-                                             bool& ok)
+// Deflates `input` with the given parameters and compares the output against `target` as it is produced,
+// a few KiB at a time. Returns true only for a byte-exact match; `matchedBytes` receives the length of the
+// common prefix, which is where a wrong candidate gave up.
+bool DeflateMatchesTarget(std::span<const std::uint8_t> input,
+                          std::span<const std::uint8_t> target,
+                          int level,
+                          int wbits,
+                          int memLevel,
+                          int strategy,
+                          std::size_t& matchedBytes)
 {
-    ok = false;
+    matchedBytes = 0;
     z_stream stream{};
     stream.next_in = const_cast<std::uint8_t*>(input.data());
     stream.avail_in = static_cast<decltype(stream.avail_in)>(input.size());
 
     if (deflateInit2(&stream, level, Z_DEFLATED, wbits, memLevel, strategy) != Z_OK)
-        return {};
-
-    std::vector<std::uint8_t> output;
-    std::vector<std::uint8_t> buffer(1 << 14);
+        return false;
 
+    // A small output window makes deflate return early, so a mismatch is seen after a few KiB of output
+    // instead of after compressing the whole file.
+    std::array<std::uint8_t, 4096> buffer{};
+    bool match = true;
     int status = Z_OK;
     while (status == Z_OK)
     {
@@ -104,16 +115,34 @@ std::vector<std::uint8_t> CompressWithParams(std::span<const std::uint8_t> input
         status = deflate(&stream, Z_FINISH);
         if (status != Z_OK && status != Z_STREAM_END)
         {
-            deflateEnd(&stream);
-            return {};
+            match = false;
+            break;
         }
         std::size_t have = buffer.size() - stream.avail_out;
-        output.insert(output.end(), buffer.begin(), buffer.begin() + have);
+        std::size_t comparable = std::min(have, target.size() - matchedBytes);
+        auto mismatch = std::mismatch(buffer.begin(), buffer.begin() + comparable, target.begin() + matchedBytes);
+        matchedBytes += static_cast<std::size_t>(mismatch.first - buffer.begin());
+        if (comparable != have || mismatch.first != buffer.begin() + comparable)
+        {
+            match = false;
+            break;
+        }
     }
 
     deflateEnd(&stream);
-    ok = true;
-    return output;
+    return match && status == Z_STREAM_END && matchedBytes == target.size();
+}
+
+// Order in which --find-zif-params tries parameter sets: the zlib defaults and the settings the game's
+// encoder (and EncodeZifZig) use come first, unusual strategies and tiny memLevels last.
+int ZifCandidatePriority(int level, int memLevel, int strategy, bool withLength)
+{
+    int score = 0;
+    score += strategy == Z_DEFAULT_STRATEGY ? 0 : strategy == Z_FILTERED ? 200 : 400;
+    score += memLevel == 8 ? 0 : memLevel == 9 ? 20 : 40 + (9 - memLevel) * 5;
+    score += level == 9 ? 0 : level == 6 ? 1 : 2 + (9 - level);
+    score += withLength ? 0 : 10;
+    return score;
 }
 
 void WriteInt32LE(std::vector<std::uint8_t>& out, std::size_t offset, std::int32_t value);
@@ -722,217 +751,6 @@ std::vector<ObjVertex> DecodeVertexStream(SeEditor::Forest::SuRenderVertexStream
     return verts;
 }
 
-std::vector<std::uint32_t> BuildTriangleIndices(SeEditor::Forest::SuRenderPrimitive const& primitive,
-                                                std::size_t vertexLimit)
-{
-    std::size_t availableIndices = primitive.IndexData.size() / 2;
-    std::size_t indexCount = availableIndices;
-    if (primitive.NumIndices > 0)
-        indexCount = std::min<std::size_t>(static_cast<std::size_t>(primitive.NumIndices), availableIndices);
-    if (indexCount == 0)
-        return {};
-
-    struct IndexMode
-    {
-        bool Use32 = false;
-        bool Swap = false;
-        std::size_t Count = 0;
-        std::size_t Droppable = 0;
-        std::size_t Restart = 0;
-    };
-
-    auto eval16 = [&](bool swap) {
-        IndexMode mode;
-        mode.Use32 = false;
-        mode.Swap = swap;
-        mode.Count = indexCount;
-        for (std::size_t i = 0; i < indexCount; ++i)
-        {
-            std::uint16_t a = primitive.IndexData[i * 2];
-            std::uint16_t b = primitive.IndexData[i * 2 + 1];
-            std::uint16_t idx = swap ? static_cast<std::uint16_t>((a << 8) | b)
-                                     : static_cast<std::uint16_t>(a | (b << 8));
-            if (idx == 0xFFFFu)
-            {
-                ++mode.Restart;
-                continue;
-            }
-            if (static_cast<std::size_t>(idx) >= vertexLimit)
-                ++mode.Droppable;
-        }
-        return mode;
-    };
-
-    auto eval32 = [&](bool swap) {
-        IndexMode mode;
-        mode.Use32 = true;
-        mode.Swap = swap;
-        if (primitive.IndexData.size() % 4 != 0)
-            return mode;
-        mode.Count = primitive.IndexData.size() / 4;
-        if (primitive.NumIndices > 0)
-            mode.Count = std::min<std::size_t>(mode.Count,
-                static_cast<std::size_t>(primitive.NumIndices));
-        for (std::size_t i = 0; i < mode.Count; ++i)
-        {
-            std::size_t off = i * 4;
-            std::uint32_t idx = static_cast<std::uint32_t>(primitive.IndexData[off + 0] |
-                (primitive.IndexData[off + 1] << 8) |
-                (primitive.IndexData[off + 2] << 16) |
-                (primitive.IndexData[off + 3] << 24));
-            if (swap)
-            {
-                idx = ((idx & 0x000000FFu) << 24) |
-                      ((idx & 0x0000FF00u) << 8) |
-                      ((idx & 0x00FF0000u) >> 8) |
-                      ((idx & 0xFF000000u) >> 24);
-            }
-            if (idx == 0xFFFFFFFFu)
-            {
-                ++mode.Restart;
-                continue;
-            }
-            if (idx >= vertexLimit)
-                ++mode.Droppable;
-        }
-        return mode;
-    };
-
-    IndexMode mode16le = eval16(false);
-    IndexMode mode16be = eval16(true);
-    IndexMode mode32le = eval32(false);
-    IndexMode mode32be = eval32(true);
-
-    IndexMode best = mode16le;
-    if (mode16be.Droppable < best.Droppable)
-        best = mode16be;
-    if (mode32le.Count > 0 && mode32le.Droppable < best.Droppable)
-        best = mode32le;
-    if (mode32be.Count > 0 && mode32be.Droppable < best.Droppable)
-        best = mode32be;
-
-    bool use32Bit = best.Use32;
-    bool swapIndices = best.Swap;
-    std::size_t indexCount32 = best.Use32 ? best.Count : 0;
-    std::size_t restart = 0;
-    std::vector<std::uint32_t> rawIndices;
-    rawIndices.reserve(best.Count);
-
-    if (use32Bit)
-    {
-        for (std::size_t i = 0; i < indexCount32; ++i)
-        {
-            std::size_t off = i * 4;
-            std::uint32_t idx = static_cast<std::uint32_t>(primitive.IndexData[off + 0] |
-                (primitive.IndexData[off + 1] << 8) |
-                (primitive.IndexData[off + 2] << 16) |
-                (primitive.IndexData[off + 3] << 24));
-            if (swapIndices)
-            {
-                idx = ((idx & 0x000000FFu) << 24) |
-                      ((idx & 0x0000FF00u) << 8) |
-                      ((idx & 0x00FF0000u) >> 8) |
-                      ((idx & 0xFF000000u) >> 24);
-            }
-            if (idx == 0xFFFFFFFFu)
-            {
-                ++restart;
-                rawIndices.push_back(idx);
-                continue;
-            }
-            if (idx >= vertexLimit)
-                continue;
-            rawIndices.push_back(idx);
-        }
-    }
-    else
-    {
-        for (std::size_t i = 0; i < best.Count; ++i)
-        {
-            std::uint16_t a = primitive.IndexData[i * 2];
-            std::uint16_t b = primitive.IndexData[i * 2 + 1];
-            std::uint16_t idx = swapIndices ? static_cast<std::uint16_t>((a << 8) | b)
-                                            : static_cast<std::uint16_t>(a | (b << 8));
-            if (idx == 0xFFFFu)
-            {
-                ++restart;
-                rawIndices.push_back(idx);
-                continue;
-            }
-            if (static_cast<std::size_t>(idx) >= vertexLimit)
-                continue;
-            rawIndices.push_back(static_cast<std::uint32_t>(idx));
-        }
-    }
-
-    int primitiveType = primitive.Unknown_0x9c;
-    bool isStrip = primitiveType == 5 || (primitiveType != 4 && restart > 0);
-    std::vector<std::uint32_t> indices;
-    if (isStrip)
-    {
-        indices.reserve(rawIndices.size());
-        bool have0 = false;
-        bool have1 = false;
-        std::uint32_t i0 = 0;
-        std::uint32_t i1 = 0;
-        bool flip = false;
-        for (std::size_t i = 0; i < rawIndices.size(); ++i)
-        {
-            std::uint32_t idx = rawIndices[i];
-            if ((use32Bit && idx == 0xFFFFFFFFu) || (!use32Bit && idx == 0xFFFFu))
-            {
-                have0 = false;
-                have1 = false;
-                flip = false;
-                continue;
-            }
-            if (!have0)
-            {
-                i0 = idx;
-                have0 = true;
-                continue;
-            }
-            if (!have1)
-            {
-                i1 = idx;
-                have1 = true;
-                continue;
-            }
-
-            if (i0 != i1 && i1 != idx && i0 != idx)
-            {
-                if (flip)
-                {
-                    indices.push_back(i1);
-                    indices.push_back(i0);
-                    indices.push_back(idx);
-                }
-                else
-                {
-                    indices.push_back(i0);
-                    indices.push_back(i1);
-                    indices.push_back(idx);
-                }
-            }
-            i0 = i1;
-            i1 = idx;
-            flip = !flip;
-        }
-    }
-    else
-    {
-        indices.reserve(rawIndices.size());
-        for (std::uint32_t idx : rawIndices)
-        {
-            if ((use32Bit && idx == 0xFFFFFFFFu) || (!use32Bit && idx == 0xFFFFu))
-                continue;
-            indices.push_back(idx);
-        }
-    }
-
-    return indices;
-}
-
 bool TryLoadForestLibraryFromChunk(SifChunkInfo const& chunk,
                                    std::span<const std::uint8_t> gpuData,
                                    std::shared_ptr<SeEditor::Forest::ForestLibrary>& outLibrary,
@@ -1063,13 +881,24 @@ int Program::Run(int argc, char** argv)
     if (argc >= 3 && std::string(argv[1]) == "--unpack-xpac")
     {
         std::filesystem::path xpacPath = argv[2];
-        std::filesystem::path outputRoot = argc >= 4 ? std::filesystem::path(argv[3]) : GetDefaultStuffRoot();
+        std::filesystem::path outputRoot = GetDefaultStuffRoot();
+        bool sifOnly = false;
+        for (int i = 3; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--sif-only")
+                sifOnly = true;
+            else if (i == 3)
+                outputRoot = arg;
+        }
 
         Xpac::XpacUnpackOptions options;
         options.XpacPath = xpacPath;
         options.OutputRoot = outputRoot;
         options.MappingPath = Xpac::FindDefaultMappingPath(xpacPath, outputRoot);
         options.ConvertToSifSig = true;
+        options.ConvertMode = Xpac::XpacConvertMode::InWorkers;
+        options.KeepZifZig = !sifOnly;
 
         Xpac::XpacUnpackResult result = Xpac::UnpackXpac(options);
         std::cout << "[XPAC] Entries=" << result.TotalEntries
@@ -1360,6 +1189,135 @@ int Program::Run(int argc, char** argv)
         return 0;
     }
 
+    if (argc >= 4 && std::string(argv[1]) == "--nav-track-dist")
+    {
+        // Maps "x,y,z" lines from a CSV to track distance and lateral offset along the SIF's navigation.
+        std::ifstream file(argv[2], std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "[NavCLI] Failed to open file." << std::endl;
+            return 1;
+        }
+        std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), {});
+
+        std::string error;
+        auto parsed = ParseSifFile(std::span<const std::uint8_t>(data.data(), data.size()), error);
+        if (!parsed)
+        {
+            std::cerr << "[NavCLI] Parse error: " << error << std::endl;
+            return 2;
+        }
+
+        SlLib::SumoTool::Siff::Navigation navigation;
+        NavigationProbeInfo probe{};
+        if (!LoadNavigationFromSifChunks(parsed->Chunks, navigation, probe, error))
+        {
+            std::cerr << "[NavCLI] Navigation parse failed: " << error << std::endl;
+            return 3;
+        }
+
+        std::ifstream csv(argv[3]);
+        if (!csv)
+        {
+            std::cerr << "[NavCLI] Failed to open " << argv[3] << std::endl;
+            return 1;
+        }
+        std::vector<SlLib::Math::Vector3> positions;
+        std::string line;
+        while (std::getline(csv, line))
+        {
+            SlLib::Math::Vector3 p{};
+            if (std::sscanf(line.c_str(), "%f , %f , %f", &p.X, &p.Y, &p.Z) == 3)
+                positions.push_back(p);
+        }
+
+        SlLib::SumoTool::Siff::NavData::NavLinkGrid grid;
+        grid.Build(navigation);
+        std::vector<SlLib::SumoTool::Siff::NavData::NavTrackPosition> results(positions.size());
+        grid.QueryBatch(positions, results);
+
+        std::cout << "x,y,z,link,trackDist,lateral,distance\n";
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            auto const& p = positions[i];
+            auto const& r = results[i];
+            std::cout << p.X << ',' << p.Y << ',' << p.Z << ',' << r.Link << ',' << r.TrackDist << ','
+                      << r.LateralOffset << ',' << r.Distance << '\n';
+        }
+        std::cerr << "[NavCLI] " << positions.size() << " positions, " << grid.LinkCount() << " links" << std::endl;
+        return 0;
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--nav-validate")
+    {
+        // Route check: every waypoint should be reachable from a start and able to get back to one.
+        std::ifstream file(argv[2], std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "[NavCLI] Failed to open file." << std::endl;
+            return 1;
+        }
+        std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), {});
+
+        std::string error;
+        auto parsed = ParseSifFile(std::span<const std::uint8_t>(data.data(), data.size()), error);
+        if (!parsed)
+        {
+            std::cerr << "[NavCLI] Parse error: " << error << std::endl;
+            return 2;
+        }
+
+        SlLib::SumoTool::Siff::Navigation navigation;
+        NavigationProbeInfo probe{};
+        if (!LoadNavigationFromSifChunks(parsed->Chunks, navigation, probe, error))
+        {
+            std::cerr << "[NavCLI] Navigation parse failed: " << error << std::endl;
+            return 3;
+        }
+
+        using SlLib::SumoTool::Siff::NavData::NavGraph;
+        NavGraph graph;
+        graph.Build(navigation);
+
+        std::vector<std::uint32_t> starts;
+        for (auto const& start : navigation.NavStarts)
+        {
+            if (!start || !start->TrackMarker || !start->TrackMarker->Waypoint)
+                continue;
+            std::uint32_t node = graph.IndexOf(start->TrackMarker->Waypoint.get());
+            if (node != NavGraph::InvalidIndex)
+                starts.push_back(node);
+        }
+        if (starts.empty() && graph.NodeCount() > 0)
+            starts.push_back(0);
+
+        SlLib::SumoTool::Siff::NavData::NavShortestPaths fromStart;
+        SlLib::SumoTool::Siff::NavData::NavShortestPaths toStart;
+        graph.ShortestPaths(starts, fromStart);
+        graph.ShortestPaths(starts, toStart, true);
+
+        std::size_t unreachable = 0;
+        std::size_t deadEnds = 0;
+        for (std::uint32_t node = 0; node < graph.NodeCount(); ++node)
+        {
+            const std::string& name = graph.WaypointOf(node)->Name;
+            if (!fromStart.Reached(node))
+            {
+                ++unreachable;
+                std::cout << "[NavCLI] unreachable waypoint " << node << " " << name << "\n";
+            }
+            if (!toStart.Reached(node))
+            {
+                ++deadEnds;
+                std::cout << "[NavCLI] dead-end waypoint " << node << " " << name << "\n";
+            }
+        }
+        std::cout << "[NavCLI] nodes=" << graph.NodeCount() << " edges=" << graph.EdgeCount()
+                  << " starts=" << starts.size() << " unreachable=" << unreachable << " deadEnds=" << deadEnds
+                  << std::endl;
+        return unreachable == 0 && deadEnds == 0 ? 0 : 4;
+    }
+
     if (argc >= 3 && std::string(argv[1]) == "--parse-logic")
     {
         std::filesystem::path path = argv[2];
@@ -1402,6 +1360,64 @@ int Program::Run(int argc, char** argv)
         return 0;
     }
 
+    if (argc >= 4 && std::string(argv[1]) == "--trigger-replay")
+    {
+        // Replays a recorded path ("x,y,z" per line) and lists every trigger it enters, in order.
+        std::ifstream file(argv[2], std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "[LogicCLI] Failed to open file." << std::endl;
+            return 1;
+        }
+        std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), {});
+
+        std::string error;
+        auto parsed = ParseSifFile(std::span<const std::uint8_t>(data.data(), data.size()), error);
+        if (!parsed)
+        {
+            std::cerr << "[LogicCLI] Parse error: " << error << std::endl;
+            return 2;
+        }
+
+        SlLib::SumoTool::Siff::LogicData logic;
+        LogicProbeInfo probe{};
+        if (!LoadLogicFromSifChunks(parsed->Chunks, logic, probe, error))
+        {
+            std::cerr << "[LogicCLI] Logic parse failed: " << error << std::endl;
+            return 3;
+        }
+
+        std::ifstream csv(argv[3]);
+        if (!csv)
+        {
+            std::cerr << "[LogicCLI] Failed to open " << argv[3] << std::endl;
+            return 1;
+        }
+        std::vector<SlLib::Math::Vector3> path;
+        std::string line;
+        while (std::getline(csv, line))
+        {
+            SlLib::Math::Vector3 p{};
+            if (std::sscanf(line.c_str(), "%f , %f , %f", &p.X, &p.Y, &p.Z) == 3)
+                path.push_back(p);
+        }
+
+        SlLib::SumoTool::Siff::Logic::TriggerBvh bvh;
+        bvh.Build(logic.Triggers);
+        std::vector<SlLib::SumoTool::Siff::Logic::TriggerHit> hits;
+        bvh.SweepBatch(path, hits);
+
+        std::cout << "sample,t,trigger,nameHash\n";
+        for (auto const& hit : hits)
+        {
+            std::cout << hit.Sample << ',' << hit.T << ',' << hit.Trigger << ",0x" << std::hex
+                      << static_cast<std::uint32_t>(logic.Triggers[hit.Trigger]->NameHash) << std::dec << '\n';
+        }
+        std::cerr << "[LogicCLI] " << path.size() << " samples, " << logic.Triggers.size() << " triggers, "
+                  << hits.size() << " entries" << std::endl;
+        return 0;
+    }
+
     if (argc >= 3 && std::string(argv[1]) == "--logic-size")
     {
         std::filesystem::path path = argv[2];
@@ -1522,6 +1538,12 @@ int Program::Run(int argc, char** argv)
         std::vector<int> memLevels{1,2,3,4,5,6,7,8,9};
         std::vector<int> strategies{Z_DEFAULT_STRATEGY, Z_FILTERED, Z_HUFFMAN_ONLY, Z_RLE, Z_FIXED};
 
+        // A zlib-wrapped target starts with a header whose check bits make it divisible by 31; a raw stream
+        // almost never does. The header also pins the wrapper, so the other half of the window sizes can
+        // be skipped outright.
+        const bool zlibWrapped = zif.size() >= 2 && (zif[0] & 0x0F) == Z_DEFLATED &&
+                                 ((static_cast<unsigned>(zif[0]) << 8) | zif[1]) % 31 == 0;
+
         std::vector<Candidate> candidates;
         candidates.reserve(levels.size() * wbitsList.size() * memLevels.size() * strategies.size() * 2);
         for (int level : levels)
@@ -1529,60 +1551,55 @@ int Program::Run(int argc, char** argv)
                 for (int memLevel : memLevels)
                     for (int strategy : strategies)
                         for (int withLen = 0; withLen < 2; ++withLen)
+                        {
+                            if ((wbits > 0) != zlibWrapped)
+                                continue;
                             candidates.push_back({level, wbits, memLevel, strategy, withLen != 0});
+                        }
+        std::stable_sort(candidates.begin(), candidates.end(), [](Candidate const& a, Candidate const& b) {
+            return ZifCandidatePriority(a.level, a.memLevel, a.strategy, a.withLength) <
+                   ZifCandidatePriority(b.level, b.memLevel, b.strategy, b.withLength);
+        });
 
-        std::atomic<std::size_t> index{0};
+        const bool stopAtFirst = argc >= 5 && std::string(argv[4]) == "--first";
+        std::atomic<bool> found{false};
         std::atomic<std::size_t> tested{0};
-        std::vector<Candidate> matches;
+        std::atomic<std::size_t> longestPrefix{0};
+        std::vector<std::size_t> matchedIndices;
         std::mutex matchMutex;
-        std::mutex logMutex;
-
-        unsigned int threadCount = std::thread::hardware_concurrency();
-        if (threadCount == 0)
-            threadCount = 4;
-        std::vector<std::thread> workers;
-        workers.reserve(threadCount);
-        for (unsigned int t = 0; t < threadCount; ++t)
-        {
-            workers.emplace_back([&]() {
-                while (true)
-                {
-                    std::size_t i = index.fetch_add(1);
-                    if (i >= candidates.size())
-                        break;
-                    auto const& c = candidates[i];
-                    {
-                        std::lock_guard<std::mutex> lock(logMutex);
-                        std::cout << "[ZIFMatch] try level=" << c.level
-                                  << " wbits=" << c.wbits
-                                  << " memLevel=" << c.memLevel
-                                  << " strategy=" << c.strategy
-                                  << " lengthPrefix=" << (c.withLength ? "yes" : "no")
-                                  << "\n";
-                    }
-                    bool ok = false;
-                    auto const& payload = c.withLength ? payloadWithLen : raw;
-                    auto out = CompressWithParams(payload, c.level, c.wbits, c.memLevel, c.strategy, ok);
-                    tested.fetch_add(1);
-                    if (!ok)
-                        continue;
-                    if (out == zif)
-                    {
-                        std::lock_guard<std::mutex> lock(matchMutex);
-                        matches.push_back(c);
-                    }
-                }
-            });
-        }
-        for (auto& t : workers)
-            t.join();
 
-        const std::size_t total = candidates.size();
+        std::cout << "[ZIFMatch] " << candidates.size() << " candidates, "
+                  << (zlibWrapped ? "zlib-wrapped" : "raw deflate") << " target of " << zif.size() << " bytes\n";
+        SlLib::Utilities::ParallelFor(candidates.size(), 0, [&](std::size_t i) {
+            if (stopAtFirst && found.load(std::memory_order_relaxed))
+                return;
+            auto const& c = candidates[i];
+            auto const& payload = c.withLength ? payloadWithLen : raw;
+            std::size_t matchedBytes = 0;
+            bool match = DeflateMatchesTarget(payload, zif, c.level, c.wbits, c.memLevel, c.strategy, matchedBytes);
+            tested.fetch_add(1);
+            std::size_t longest = longestPrefix.load(std::memory_order_relaxed);
+            while (matchedBytes > longest && !longestPrefix.compare_exchange_weak(longest, matchedBytes))
+            {
+            }
+            if (match)
+            {
+                found = true;
+                std::lock_guard<std::mutex> lock(matchMutex);
+                matchedIndices.push_back(i);
+            }
+        });
+        // Report in priority order regardless of which worker finished first.
+        std::sort(matchedIndices.begin(), matchedIndices.end());
+        std::vector<Candidate> matches;
+        for (std::size_t i : matchedIndices)
+            matches.push_back(candidates[i]);
 
         std::cout << "[ZIFMatch] Tested " << tested.load() << " combinations.\n";
         if (matches.empty())
         {
-            std::cout << "[ZIFMatch] No exact match found.\n";
+            std::cout << "[ZIFMatch] No exact match found (longest common prefix " << longestPrefix.load()
+                      << " bytes).\n";
             return 2;
         }
 
@@ -2145,7 +2162,8 @@ int Program::Run(int argc, char** argv)
                     v.Normal = SlLib::Math::normalize({nT.X, nT.Y, nT.Z});
                 }
 
-                auto indices = BuildTriangleIndices(*primitive, verts.size());
+                auto decoded = SeEditor::Forest::GetDecodedPrimitiveIndices(*primitive, verts.size());
+                auto const& indices = decoded->Triangles;
                 if (indices.empty())
                     continue;
 
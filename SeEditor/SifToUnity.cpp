@@ -1,32 +1,104 @@
 #include "SeEditor/UnityExport.hpp"
+#include "SeEditor/XpacFileSystem.hpp"
 
+#include <cstdlib>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 int main(int argc, char** argv)
 {
-    if (argc < 2)
+    SeEditor::UnityExport::ExportOptions options;
+    std::vector<std::string> positional;
+    std::filesystem::path xpacPath;
+    for (int i = 1; i < argc; ++i)
     {
-        std::cout << "sif_to_unity <input.sif> [<unity_project_root>]\n";
-        std::cout << "Writes: <unity_project_root>/Assets/<SIFNAME>.SIF/export.json and mesh/collision .obj files.\n";
+        std::string arg = argv[i];
+        if (SeEditor::Export::ParseMeshOptimizeArg(arg, options.MeshOptimization))
+            continue;
+        if (arg == "--threads" && i + 1 < argc)
+        {
+            options.ThreadCount = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+            continue;
+        }
+        if (arg == "--glb")
+        {
+            options.WriteGlb = true;
+            continue;
+        }
+        if (arg == "--incremental")
+        {
+            options.Incremental = true;
+            continue;
+        }
+        if (arg == "--shared-textures" && i + 1 < argc)
+        {
+            options.SharedTextureDir = argv[++i];
+            continue;
+        }
+        if (arg == "--xpac" && i + 1 < argc)
+        {
+            xpacPath = argv[++i];
+            continue;
+        }
+        positional.push_back(std::move(arg));
+    }
+
+    if (positional.empty())
+    {
+        std::cout << "sif_to_unity <input.sif> [<unity_project_root>] [--threads N] [--glb] [--incremental] [--shared-textures <dir>] [--xpac <archive>] [mesh options]\n";
+        std::cout << "Writes: <unity_project_root>/Assets/<SIFNAME>.SIF/export.json and mesh/collision .obj files (plus .glb with --glb).\n";
+        std::cout << "--incremental skips assets whose inputs match export.manifest and removes stale outputs.\n";
+        std::cout << "--shared-textures writes textures once, named by content hash, into <dir> (inside Assets/).\n";
+        std::cout << "--xpac reads <input.sif> (a path inside the archive, e.g. Resource/.../Foo.sif) straight from a .xpac.\n";
+        std::cout << "Mesh options: --no-weld --no-vertex-cache --no-vertex-fetch --overdraw --no-mesh-opt\n";
         return 1;
     }
 
-    std::filesystem::path inputPath = argv[1];
+    std::filesystem::path inputPath = positional[0];
     std::filesystem::path unityRoot;
-    if (argc >= 3)
-        unityRoot = std::filesystem::path(argv[2]);
+    if (positional.size() >= 2)
+        unityRoot = std::filesystem::path(positional[1]);
     else
         unityRoot = std::filesystem::current_path() / ".." / ".." / "Unity";
 
-    auto res = SeEditor::UnityExport::ExportSifToUnity(inputPath, unityRoot);
+    std::unique_ptr<SeEditor::Xpac::XpacFileSystem> xpac;
+    if (!xpacPath.empty())
+    {
+        try
+        {
+            xpac = std::make_unique<SeEditor::Xpac::XpacFileSystem>(xpacPath);
+        }
+        catch (std::exception const& ex)
+        {
+            std::cerr << "[sif_to_unity] " << ex.what() << "\n";
+            return 2;
+        }
+        options.SourceFileSystem = xpac.get();
+    }
+
+    auto res = SeEditor::UnityExport::ExportSifToUnity(inputPath, unityRoot, options);
     if (!res.Success)
     {
         std::cerr << "[sif_to_unity] " << res.Error << "\n";
         return 2;
     }
 
+    if (res.UpToDate)
+    {
+        std::cout << "[sif_to_unity] Up to date: " << res.ExportJsonPath.string() << "\n";
+        return 0;
+    }
     std::cout << "[sif_to_unity] Wrote " << res.ExportJsonPath.string() << "\n";
+    if (res.DuplicateTextures > 0)
+        std::cout << "[sif_to_unity] " << res.UniqueTextures << " unique textures; " << res.DuplicateTextures
+                  << " duplicates (" << res.DuplicateTextureBytes << " bytes) not written again.\n";
+    if (options.Incremental)
+        std::cout << "[sif_to_unity] Reused " << res.SkippedTasks << " unchanged tasks, removed " << res.RemovedOrphans
+                  << " stale files.\n";
     return 0;
 }
 
@@ -0,0 +1,220 @@
+// Build step: turns MAPPING.GC ("<hash>:<path>;" per line) into a header holding a minimal perfect hash
+// table of filename hash -> path, so the tools do not parse the mapping text on every start.
+//
+// Usage: xpac_mapping_table_gen <MAPPING.GC> <output header>
+
+#include "SeEditor/XpacMappingTable.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+using SeEditor::Xpac::MappingSlotHash;
+
+struct MappingEntry
+{
+    std::uint32_t Hash = 0;
+    std::string Name;
+};
+
+// Same rules as LoadMappingFromText in XpacUnpacker.cpp: the first entry for a hash wins.
+std::vector<MappingEntry> ParseMapping(std::string_view text)
+{
+    std::vector<MappingEntry> entries;
+    std::unordered_set<std::uint32_t> seen;
+    std::size_t start = 0;
+    while (start < text.size())
+    {
+        std::size_t end = text.find('\n', start);
+        if (end == std::string_view::npos)
+            end = text.size();
+        std::string_view line = text.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        auto colon = line.find(':');
+        auto semi = line.find(';', colon != std::string_view::npos ? colon + 1 : 0);
+        if (colon != std::string_view::npos && semi != std::string_view::npos)
+        {
+            try
+            {
+                auto hash = static_cast<std::uint32_t>(std::stoul(std::string(line.substr(0, colon))));
+                if (seen.insert(hash).second)
+                    entries.push_back({hash, std::string(line.substr(colon + 1, semi - colon - 1))});
+            }
+            catch (...)
+            {
+            }
+        }
+        if (end == text.size())
+            break;
+        start = end + 1;
+    }
+    return entries;
+}
+
+struct PerfectHash
+{
+    std::uint32_t SlotCount = 0;
+    std::vector<std::uint16_t> Seeds;
+    std::vector<std::int32_t> SlotEntry; // entry index per slot, -1 when empty
+};
+
+// Hash-and-displace: keys are grouped into buckets of about four, and buckets, largest first, search for a
+// seed that drops all their keys into free slots.
+bool BuildPerfectHash(std::vector<MappingEntry> const& entries, std::uint32_t slotCount, PerfectHash& table)
+{
+    const std::uint32_t bucketCount = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(entries.size() + 3) / 4);
+    std::vector<std::vector<std::uint32_t>> buckets(bucketCount);
+    for (std::uint32_t i = 0; i < entries.size(); ++i)
+        buckets[MappingSlotHash(entries[i].Hash, 0) % bucketCount].push_back(i);
+
+    std::vector<std::uint32_t> order(bucketCount);
+    for (std::uint32_t i = 0; i < bucketCount; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    table.SlotCount = slotCount;
+    table.Seeds.assign(bucketCount, 0);
+    table.SlotEntry.assign(slotCount, -1);
+    std::vector<std::uint32_t> slots;
+    for (std::uint32_t bucketIndex : order)
+    {
+        auto const& bucket = buckets[bucketIndex];
+        if (bucket.empty())
+            break;
+        bool placed = false;
+        for (std::uint32_t seed = 1; seed <= 0xFFFF && !placed; ++seed)
+        {
+            slots.clear();
+            placed = true;
+            for (std::uint32_t entryIndex : bucket)
+            {
+                std::uint32_t slot = MappingSlotHash(entries[entryIndex].Hash, seed) % slotCount;
+                if (table.SlotEntry[slot] != -1 || std::find(slots.begin(), slots.end(), slot) != slots.end())
+                {
+                    placed = false;
+                    break;
+                }
+                slots.push_back(slot);
+            }
+            if (placed)
+            {
+                table.Seeds[bucketIndex] = static_cast<std::uint16_t>(seed);
+                for (std::size_t k = 0; k < bucket.size(); ++k)
+                    table.SlotEntry[slots[k]] = static_cast<std::int32_t>(bucket[k]);
+            }
+        }
+        if (!placed)
+            return false;
+    }
+    return true;
+}
+
+void WriteEscaped(std::ostream& out, std::string_view text)
+{
+    for (char c : text)
+    {
+        auto byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (byte < 0x20 || byte >= 0x7F || c == '?')
+            out << "\\" << static_cast<char>('0' + ((byte >> 6) & 7)) << static_cast<char>('0' + ((byte >> 3) & 7))
+                << static_cast<char>('0' + (byte & 7));
+        else
+            out << c;
+    }
+}
+
+template <typename T>
+void WriteArray(std::ostream& out, char const* type, char const* name, std::vector<T> const& values)
+{
+    out << "inline constexpr " << type << ' ' << name << "[] = {";
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        if (i % 12 == 0)
+            out << "\n    ";
+        out << values[i] << "u,";
+    }
+    out << "\n};\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: xpac_mapping_table_gen <MAPPING.GC> <output header>\n";
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "Unable to open " << argv[1] << "\n";
+        return 1;
+    }
+    std::string text((std::istreambuf_iterator<char>(in)), {});
+    std::vector<MappingEntry> entries = ParseMapping(text);
+
+    PerfectHash table;
+    std::uint32_t slotCount = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(entries.size()));
+    while (!BuildPerfectHash(entries, slotCount, table))
+        slotCount += slotCount / 64 + 1;
+
+    std::vector<std::uint32_t> keys(table.SlotCount, 0);
+    std::vector<std::uint32_t> offsets;
+    offsets.reserve(table.SlotCount + 1);
+    std::string names;
+    for (std::uint32_t slot = 0; slot < table.SlotCount; ++slot)
+    {
+        offsets.push_back(static_cast<std::uint32_t>(names.size()));
+        if (table.SlotEntry[slot] < 0)
+            continue;
+        MappingEntry const& entry = entries[static_cast<std::size_t>(table.SlotEntry[slot])];
+        keys[slot] = entry.Hash;
+        names += entry.Name;
+    }
+    offsets.push_back(static_cast<std::uint32_t>(names.size()));
+
+    std::ostringstream out;
+    out << "// Generated from MAPPING.GC by xpac_mapping_table_gen. Do not edit.\n";
+    out << "inline constexpr std::uint32_t kMappingEntryCount = " << entries.size() << "u;\n";
+    out << "inline constexpr std::uint32_t kMappingSlotCount = " << table.SlotCount << "u;\n";
+    out << "inline constexpr std::uint32_t kMappingBucketCount = " << table.Seeds.size() << "u;\n";
+    WriteArray(out, "std::uint16_t", "kMappingSeeds", table.Seeds);
+    WriteArray(out, "std::uint32_t", "kMappingKeys", keys);
+    WriteArray(out, "std::uint32_t", "kMappingOffsets", offsets);
+    out << "inline constexpr char kMappingNames[] =";
+    constexpr std::size_t kPieceSize = 2048;
+    for (std::size_t pos = 0; pos < names.size() || pos == 0; pos += kPieceSize)
+    {
+        out << "\n    \"";
+        WriteEscaped(out, std::string_view(names).substr(pos, kPieceSize));
+        out << '"';
+        if (names.empty())
+            break;
+    }
+    out << ";\n";
+
+    std::string generated = out.str();
+    std::ofstream file(argv[2], std::ios::binary | std::ios::trunc);
+    if (!file || !file.write(generated.data(), static_cast<std::streamsize>(generated.size())))
+    {
+        std::cerr << "Unable to write " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << "[MappingTable] " << entries.size() << " names in " << table.SlotCount << " slots\n";
+    return 0;
+}
@@ -4,11 +4,18 @@
 #include "SeEditor/NavigationLoader.hpp"
 #include "SeEditor/SifParser.hpp"
 #include "SeEditor/Forest/ForestTypes.hpp"
+#include "SeEditor/Export/ExportManifest.hpp"
+#include "SeEditor/Export/GlbWriter.hpp"
+#include "SeEditor/Export/TextMeshWriter.hpp"
+#include "SeEditor/Export/TextureStore.hpp"
+#include "SeEditor/Forest/PrimitiveIndices.hpp"
 
+#include "SlLib/Filesystem/IFileSystem.hpp"
 #include "SlLib/Math/Vector.hpp"
 #include "SlLib/Resources/Database/SlPlatform.hpp"
 #include "SlLib/Resources/Database/SlResourceRelocation.hpp"
 #include "SlLib/Serialization/ResourceLoadContext.hpp"
+#include "SlLib/Utilities/ParallelFor.hpp"
 
 #include <algorithm>
 #include <cctype>
@@ -16,12 +23,15 @@
 #include <cstring>
 #include <array>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <map>
 #include <optional>
 #include <span>
 #include <sstream>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <zlib.h>
@@ -618,6 +628,25 @@ void StripLengthPrefixIfPresent(std::vector<std::uint8_t>& data)
         data.erase(data.begin(), data.begin() + 4);
 }
 
+// GPU data is stored either zlib-wrapped with a 4-byte header (.zig) or as a length-prefixed blob (.sig).
+std::vector<std::uint8_t> DecodeGpuData(std::vector<std::uint8_t> data)
+{
+    if (LooksLikeZlib(data))
+    {
+        auto inflated = DecompressZlib(data);
+        if (inflated.size() >= 4)
+            data.assign(inflated.begin() + 4, inflated.end());
+        else
+            data.clear();
+    }
+    else
+    {
+        StripLengthPrefixIfPresent(data);
+    }
+
+    return data;
+}
+
 std::vector<std::uint8_t> LoadGpuDataForSif(const std::filesystem::path& sifPath)
 {
     std::filesystem::path gpuPath = sifPath;
@@ -640,22 +669,19 @@ std::vector<std::uint8_t> LoadGpuDataForSif(const std::filesystem::path& sifPath
     if (!file)
         return {};
     std::vector<char> buffer((std::istreambuf_iterator<char>(file)), {});
-    std::vector<std::uint8_t> data(buffer.begin(), buffer.end());
-
-    if (LooksLikeZlib(data))
-    {
-        auto inflated = DecompressZlib(data);
-        if (inflated.size() >= 4)
-            data.assign(inflated.begin() + 4, inflated.end());
-        else
-            data.clear();
-    }
-    else
-    {
-        StripLengthPrefixIfPresent(data);
-    }
+    return DecodeGpuData(std::vector<std::uint8_t>(buffer.begin(), buffer.end()));
+}
 
-    return data;
+// Same lookup order as LoadGpuDataForSif, against a virtual filesystem.
+std::vector<std::uint8_t> LoadGpuDataForSif(SlLib::Filesystem::IFileSystem& fs, const std::filesystem::path& sifPath)
+{
+    std::filesystem::path gpuPath = sifPath;
+    gpuPath.replace_extension(".zig");
+    if (!fs.DoesFileExist(gpuPath.generic_string()))
+        gpuPath.replace_extension(".sig");
+    if (!fs.DoesFileExist(gpuPath.generic_string()))
+        return {};
+    return DecodeGpuData(fs.GetFile(gpuPath.generic_string()));
 }
 
 std::vector<ObjVertex> DecodeVertexStream(SeEditor::Forest::SuRenderVertexStream const& stream)
@@ -719,241 +745,41 @@ std::vector<ObjVertex> DecodeVertexStream(SeEditor::Forest::SuRenderVertexStream
     return verts;
 }
 
-std::vector<std::uint32_t> DecodePrimitiveIndices(SeEditor::Forest::SuRenderPrimitive const& primitive,
-                                                  std::size_t vertexLimit)
-{
-    std::size_t indexCount = primitive.IndexData.size() / 2;
-    if (primitive.NumIndices > 0)
-        indexCount = std::min<std::size_t>(indexCount, static_cast<std::size_t>(primitive.NumIndices));
-    else if (indexCount == 0)
-        return {};
-
-    struct IndexMode
-    {
-        bool Use32 = false;
-        bool Swap = false;
-        std::size_t Count = 0;
-        std::size_t Droppable = 0;
-        std::size_t Restart = 0;
-    };
-
-    auto eval16 = [&](bool swap) {
-        IndexMode mode;
-        mode.Use32 = false;
-        mode.Swap = swap;
-        mode.Count = indexCount;
-        for (std::size_t i = 0; i < indexCount; ++i)
-        {
-            std::uint16_t a = primitive.IndexData[i * 2];
-            std::uint16_t b = primitive.IndexData[i * 2 + 1];
-            std::uint16_t idx = swap ? static_cast<std::uint16_t>((a << 8) | b)
-                                     : static_cast<std::uint16_t>(a | (b << 8));
-            if (idx == 0xFFFFu)
-            {
-                ++mode.Restart;
-                continue;
-            }
-            if (static_cast<std::size_t>(idx) >= vertexLimit)
-                ++mode.Droppable;
-        }
-        return mode;
-    };
-
-    auto eval32 = [&](bool swap) {
-        IndexMode mode;
-        mode.Use32 = true;
-        mode.Swap = swap;
-        if (primitive.IndexData.size() % 4 != 0)
-            return mode;
-        mode.Count = primitive.IndexData.size() / 4;
-        if (primitive.NumIndices > 0)
-            mode.Count = std::min<std::size_t>(mode.Count, static_cast<std::size_t>(primitive.NumIndices));
-        for (std::size_t i = 0; i < mode.Count; ++i)
-        {
-            std::size_t off = i * 4;
-            std::uint32_t idx = static_cast<std::uint32_t>(primitive.IndexData[off + 0] |
-                                                          (primitive.IndexData[off + 1] << 8) |
-                                                          (primitive.IndexData[off + 2] << 16) |
-                                                          (primitive.IndexData[off + 3] << 24));
-            if (swap)
-            {
-                idx = ((idx & 0x000000FFu) << 24) |
-                      ((idx & 0x0000FF00u) << 8) |
-                      ((idx & 0x00FF0000u) >> 8) |
-                      ((idx & 0xFF000000u) >> 24);
-            }
-            if (idx == 0xFFFFFFFFu)
-            {
-                ++mode.Restart;
-                continue;
-            }
-            if (idx >= vertexLimit)
-                ++mode.Droppable;
-        }
-        return mode;
-    };
-
-    IndexMode best = eval16(false);
-    IndexMode cand16be = eval16(true);
-    if (cand16be.Droppable < best.Droppable)
-        best = cand16be;
-
-    IndexMode cand32le = eval32(false);
-    if (cand32le.Count > 0 && cand32le.Droppable < best.Droppable)
-        best = cand32le;
-
-    IndexMode cand32be = eval32(true);
-    if (cand32be.Count > 0 && cand32be.Droppable < best.Droppable)
-        best = cand32be;
-
-    const bool use32Bit = best.Use32;
-    const bool swapIndices = best.Swap;
-
-    std::vector<std::uint32_t> rawIndices;
-    rawIndices.reserve(best.Count);
-    if (use32Bit)
-    {
-        for (std::size_t i = 0; i < best.Count; ++i)
-        {
-            std::size_t off = i * 4;
-            std::uint32_t idx = static_cast<std::uint32_t>(primitive.IndexData[off + 0] |
-                                                          (primitive.IndexData[off + 1] << 8) |
-                                                          (primitive.IndexData[off + 2] << 16) |
-                                                          (primitive.IndexData[off + 3] << 24));
-            if (swapIndices)
-            {
-                idx = ((idx & 0x000000FFu) << 24) |
-                      ((idx & 0x0000FF00u) << 8) |
-                      ((idx & 0x00FF0000u) >> 8) |
-                      ((idx & 0xFF000000u) >> 24);
-            }
-            rawIndices.push_back(idx);
-        }
-    }
-    else
-    {
-        for (std::size_t i = 0; i < best.Count; ++i)
-        {
-            std::uint16_t a = primitive.IndexData[i * 2];
-            std::uint16_t b = primitive.IndexData[i * 2 + 1];
-            std::uint16_t idx = swapIndices ? static_cast<std::uint16_t>((a << 8) | b)
-                                            : static_cast<std::uint16_t>(a | (b << 8));
-            rawIndices.push_back(idx);
-        }
-    }
-
-    const int primitiveType = primitive.Unknown_0x9c;
-    const bool isStrip = primitiveType == 5 || (primitiveType != 4 && best.Restart > 0);
-
-    std::vector<std::uint32_t> validIndices;
-    if (isStrip)
-    {
-        validIndices.reserve(rawIndices.size());
-        bool have0 = false;
-        bool have1 = false;
-        std::uint32_t i0 = 0;
-        std::uint32_t i1 = 0;
-        bool flip = false;
-        for (std::uint32_t idx : rawIndices)
-        {
-            if ((use32Bit && idx == 0xFFFFFFFFu) || (!use32Bit && idx == 0xFFFFu))
-            {
-                have0 = false;
-                have1 = false;
-                flip = false;
-                continue;
-            }
-            if (idx >= vertexLimit)
-                continue;
-            if (!have0)
-            {
-                i0 = idx;
-                have0 = true;
-                continue;
-            }
-            if (!have1)
-            {
-                i1 = idx;
-                have1 = true;
-                continue;
-            }
-            if (i0 != i1 && i1 != idx && i0 != idx)
-            {
-                if (flip)
-                {
-                    validIndices.push_back(i1);
-                    validIndices.push_back(i0);
-                    validIndices.push_back(idx);
-                }
-                else
-                {
-                    validIndices.push_back(i0);
-                    validIndices.push_back(i1);
-                    validIndices.push_back(idx);
-                }
-            }
-            i0 = i1;
-            i1 = idx;
-            flip = !flip;
-        }
-    }
-    else
-    {
-        validIndices.reserve(rawIndices.size());
-        for (std::uint32_t idx : rawIndices)
-        {
-            if ((use32Bit && idx == 0xFFFFFFFFu) || (!use32Bit && idx == 0xFFFFu))
-                continue;
-            if (idx >= vertexLimit)
-                continue;
-            validIndices.push_back(idx);
-        }
-    }
-
-    return validIndices;
-}
-
 bool WriteObj(const std::filesystem::path& path,
               std::string_view objectName,
               std::span<const ObjVertex> vertices,
-              std::span<const std::uint32_t> indices)
+              std::span<const std::uint32_t> indices,
+              SeEditor::Export::TextFormatOptions const& textOptions)
 {
-    std::ofstream obj(path);
-    if (!obj)
+    SeEditor::Export::BufferedTextWriter obj(textOptions);
+    if (!obj.Open(path))
         return false;
 
-    obj << "o " << SanitizeName(std::string(objectName)) << '\n';
+    obj.Put("o ");
+    obj.Put(SanitizeName(std::string(objectName)));
+    obj.Put('\n');
     for (auto const& v : vertices)
-        obj << "v " << v.Pos.X << ' ' << v.Pos.Y << ' ' << v.Pos.Z << '\n';
+        obj.PutVec3("v", v.Pos.X, v.Pos.Y, v.Pos.Z);
     for (auto const& v : vertices)
-        obj << "vn " << v.Normal.X << ' ' << v.Normal.Y << ' ' << v.Normal.Z << '\n';
+        obj.PutVec3("vn", v.Normal.X, v.Normal.Y, v.Normal.Z);
     for (auto const& v : vertices)
-        obj << "vt " << v.Uv.X << ' ' << v.Uv.Y << '\n';
+        obj.PutVec2("vt", v.Uv.X, v.Uv.Y);
 
     const std::size_t vertexBase = 1;
     for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
-    {
-        obj << "f ";
-        for (int v = 0; v < 3; ++v)
-        {
-            std::size_t idx = static_cast<std::size_t>(indices[i + v]);
-            obj << vertexBase + idx << '/' << vertexBase + idx << '/' << vertexBase + idx;
-            if (v < 2)
-                obj << ' ';
-        }
-        obj << '\n';
-    }
+        obj.PutFaceVtn(vertexBase + indices[i], vertexBase + indices[i + 1], vertexBase + indices[i + 2]);
 
-    return true;
+    return obj.Close();
 }
 
 bool WriteCollisionObj(const std::filesystem::path& path,
                        std::string_view objectName,
                        std::span<const Vector3> vertices,
-                       std::span<const CollisionTriangle> triangles)
+                       std::span<const CollisionTriangle> triangles,
+                       SeEditor::Export::TextFormatOptions const& textOptions)
 {
-    std::ofstream obj(path);
-    if (!obj)
+    SeEditor::Export::BufferedTextWriter obj(textOptions);
+    if (!obj.Open(path))
         return false;
 
     std::vector<int> remap(vertices.size(), -1);
@@ -972,7 +798,9 @@ bool WriteCollisionObj(const std::filesystem::path& path,
         return slot;
     };
 
-    obj << "o " << SanitizeName(std::string(objectName)) << '\n';
+    obj.Put("o ");
+    obj.Put(SanitizeName(std::string(objectName)));
+    obj.Put('\n');
     for (auto const& tri : triangles)
     {
         mapIndex(tri.Indices[0]);
@@ -981,7 +809,7 @@ bool WriteCollisionObj(const std::filesystem::path& path,
     }
 
     for (auto const& v : outVerts)
-        obj << "v " << v.X << ' ' << v.Y << ' ' << v.Z << '\n';
+        obj.PutVec3("v", v.X, v.Y, v.Z);
 
     for (auto const& tri : triangles)
     {
@@ -990,15 +818,16 @@ bool WriteCollisionObj(const std::filesystem::path& path,
         int c = mapIndex(tri.Indices[2]);
         if (a < 0 || b < 0 || c < 0)
             continue;
-        obj << "f " << (a + 1) << ' ' << (b + 1) << ' ' << (c + 1) << '\n';
+        obj.PutFace(static_cast<std::uint64_t>(a) + 1, static_cast<std::uint64_t>(b) + 1, static_cast<std::uint64_t>(c) + 1);
     }
 
-    return true;
+    return obj.Close();
 }
 
 bool ExportRenderMeshToObj(const std::filesystem::path& outPath,
                            SeEditor::Forest::SuRenderMesh const& mesh,
-                           std::string_view objectName)
+                           std::string_view objectName,
+                           ExportOptions const& options)
 {
     if (mesh.Primitives.empty())
         return false;
@@ -1012,9 +841,11 @@ bool ExportRenderMeshToObj(const std::filesystem::path& outPath,
         auto verts = DecodeVertexStream(*prim->VertexStream);
         if (verts.empty())
             continue;
-        auto idx = DecodePrimitiveIndices(*prim, verts.size());
-        if (idx.empty())
+        auto decoded = SeEditor::Forest::GetDecodedPrimitiveIndices(*prim, verts.size());
+        if (decoded->Triangles.empty())
             continue;
+        std::vector<std::uint32_t> idx = decoded->Triangles;
+        SeEditor::Export::OptimizeMesh(verts, idx, options.MeshOptimization);
         std::uint32_t base = static_cast<std::uint32_t>(mergedVertices.size());
         mergedVertices.insert(mergedVertices.end(), verts.begin(), verts.end());
         for (auto i : idx)
@@ -1024,7 +855,7 @@ bool ExportRenderMeshToObj(const std::filesystem::path& outPath,
     if (mergedVertices.empty() || mergedIndices.empty())
         return false;
 
-    return WriteObj(outPath, objectName, mergedVertices, mergedIndices);
+    return WriteObj(outPath, objectName, mergedVertices, mergedIndices, options.ObjText);
 }
 
 struct ObjMtlExportResult
@@ -1033,321 +864,692 @@ struct ObjMtlExportResult
     std::size_t SubMeshCount = 0;
 };
 
-std::filesystem::path WriteTextureFile(const std::filesystem::path& texturesRoot,
-                                       const std::string& name,
-                                       const std::vector<std::uint8_t>& imageData,
-                                       std::error_code& ec)
-{
-    if (imageData.empty())
-        return {};
+using TexturePathMap = std::unordered_map<const SeEditor::Forest::SuRenderTextureResource*, std::filesystem::path>;
 
-    std::string base = SanitizeName(name);
-    if (base.empty())
-        base = "tex";
+std::string_view TextureFileExtension(const std::vector<std::uint8_t>& imageData)
+{
+    return StartsWith(std::span<const std::uint8_t>(imageData.data(), imageData.size()), "DDS ") ? ".dds" : ".bin";
+}
 
-    std::string ext = StartsWith(std::span<const std::uint8_t>(imageData.data(), imageData.size()), "DDS ") ? ".dds" : ".bin";
-    std::filesystem::path outPath = texturesRoot / (base + ext);
+bool WriteTextureFile(const std::filesystem::path& outPath, const std::vector<std::uint8_t>& imageData)
+{
+    if (imageData.empty())
+        return false;
 
+    std::error_code ec;
     std::filesystem::create_directories(outPath.parent_path(), ec);
     if (ec)
-        return {};
+        return false;
 
     std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
     if (!out)
-        return {};
+        return false;
     out.write(reinterpret_cast<const char*>(imageData.data()), static_cast<std::streamsize>(imageData.size()));
-    return outPath;
+    return true;
 }
 
-ObjMtlExportResult ExportTreeToObjMtl(const std::filesystem::path& objPath,
-                                     const std::filesystem::path& mtlPath,
-                                     const std::filesystem::path& texturesRoot,
-                                     SeEditor::Forest::SuRenderTree const& tree,
-                                     const SeEditor::Forest::SuRenderForest& forest,
-                                     std::error_code& ec)
+// First texture of `mat` that was exported, or empty.
+std::filesystem::path MaterialTexturePath(const std::shared_ptr<SeEditor::Forest::SuRenderMaterial>& mat,
+                                          TexturePathMap const& texturePaths)
 {
-    ObjMtlExportResult result{};
-
-    std::ofstream obj(objPath, std::ios::binary | std::ios::trunc);
-    if (!obj)
-        return result;
-    std::ofstream mtl(mtlPath, std::ios::binary | std::ios::trunc);
-    if (!mtl)
-        return result;
-
-    // Map texture resource ptr -> exported path
-    std::unordered_map<const SeEditor::Forest::SuRenderTextureResource*, std::filesystem::path> texOutByPtr;
-    texOutByPtr.reserve(forest.TextureResources.size());
-
-    auto materialName = [](const std::shared_ptr<SeEditor::Forest::SuRenderMaterial>& mat) -> std::string {
-        if (!mat)
-            return "mat_default";
-        if (!mat->Name.empty())
-            return SanitizeName(mat->Name);
-        return "mat_" + std::to_string(mat->Hash);
-    };
+    if (!mat)
+        return {};
+    for (auto const& t : mat->Textures)
+    {
+        if (!t || !t->TextureResource)
+            continue;
+        auto it = texturePaths.find(t->TextureResource.get());
+        if (it != texturePaths.end())
+            return it->second;
+    }
+    return {};
+}
 
-    auto materialTexturePath = [&](const std::shared_ptr<SeEditor::Forest::SuRenderMaterial>& mat) -> std::filesystem::path {
-        if (!mat)
-            return {};
-        for (auto const& t : mat->Textures)
+// Folds the texture file every primitive of `tree` resolves to into `seed`. Texture file names are assigned
+// across the whole export, so a tree whose own data is unchanged can still end up pointing at another file.
+std::uint64_t HashTreeTexturePaths(SeEditor::Forest::SuRenderTree const& tree,
+                                   TexturePathMap const& texturePaths,
+                                   std::uint64_t seed)
+{
+    auto hashMesh = [&](const std::shared_ptr<SeEditor::Forest::SuRenderMesh>& mesh) {
+        if (!mesh)
+            return;
+        for (auto const& prim : mesh->Primitives)
         {
-            if (!t || !t->TextureResource)
-                continue;
-            auto* key = t->TextureResource.get();
-            auto it = texOutByPtr.find(key);
-            if (it != texOutByPtr.end())
-                return it->second;
-
-            auto written = WriteTextureFile(texturesRoot, t->TextureResource->Name, t->TextureResource->ImageData, ec);
-            if (!written.empty())
-            {
-                texOutByPtr[key] = written;
-                return written;
-            }
+            if (prim)
+                seed = SeEditor::Export::HashString(MaterialTexturePath(prim->Material, texturePaths).generic_string(),
+                                                    seed);
         }
-        return {};
     };
-
-    // Emit materials as we encounter them.
-    std::unordered_map<std::string, bool> writtenMtl;
-
-    obj << "mtllib " << mtlPath.filename().string() << "\n";
-    obj << "o tree\n";
-
-    std::size_t vBase = 1;
-    std::size_t subMeshCount = 0;
-
     for (auto const& branch : tree.Branches)
     {
         if (!branch)
             continue;
+        hashMesh(branch->Mesh);
+        if (branch->Lod)
+        {
+            for (auto const& th : branch->Lod->Thresholds)
+                if (th)
+                    hashMesh(th->Mesh);
+        }
+    }
+    return seed;
+}
 
-        auto exportMesh = [&](const std::shared_ptr<SeEditor::Forest::SuRenderMesh>& mesh) {
-            if (!mesh)
-                return;
-            for (auto const& prim : mesh->Primitives)
-            {
-                if (!prim || !prim->VertexStream)
-                    continue;
-                auto verts = DecodeVertexStream(*prim->VertexStream);
-                if (verts.empty())
-                    continue;
-                auto idx = DecodePrimitiveIndices(*prim, verts.size());
-                if (idx.empty())
-                    continue;
-
-                std::string mName = materialName(prim->Material);
-                if (!writtenMtl[mName])
-                {
-                    writtenMtl[mName] = true;
-                    mtl << "newmtl " << mName << "\n";
-                    mtl << "Kd 1.000000 1.000000 1.000000\n";
-                    auto texPath = materialTexturePath(prim->Material);
-                    if (!texPath.empty())
-                    {
-                        auto rel = std::filesystem::relative(texPath, objPath.parent_path(), ec);
-                        if (!ec)
-                            mtl << "map_Kd " << rel.generic_string() << "\n";
-                    }
-                    mtl << "\n";
-                }
+// Shared body of the tree/branch OBJ+MTL exporters: one `g`/`usemtl` group per primitive, materials
+// emitted to the MTL the first time they are used.
+class ObjMtlBuilder
+{
+public:
+    ObjMtlBuilder(const std::filesystem::path& objPath,
+                  const std::filesystem::path& mtlPath,
+                  TexturePathMap const& texturePaths,
+                  std::error_code& ec,
+                  ExportOptions const& options)
+        : _objPath(objPath), _texturePaths(texturePaths), _ec(ec), _options(options), _obj(options.ObjText),
+          _mtl(options.ObjText, 64 * 1024)
+    {
+        _opened = _obj.Open(objPath) && _mtl.Open(mtlPath);
+        if (!_opened)
+            return;
+        _obj.Put("mtllib ");
+        _obj.Put(mtlPath.filename().string());
+        _obj.Put('\n');
+    }
 
-                obj << "g " << mName << "\n";
-                obj << "usemtl " << mName << "\n";
-                ++subMeshCount;
+    bool IsOpen() const { return _opened; }
+    std::size_t SubMeshCount() const { return _subMeshCount; }
+    ObjMtlBuilder& Object(std::string_view name)
+    {
+        _obj.Put("o ");
+        _obj.Put(name);
+        _obj.Put('\n');
+        return *this;
+    }
 
-                for (auto const& v : verts)
-                    obj << "v " << v.Pos.X << ' ' << v.Pos.Y << ' ' << v.Pos.Z << "\n";
-                for (auto const& v : verts)
-                    obj << "vn " << v.Normal.X << ' ' << v.Normal.Y << ' ' << v.Normal.Z << "\n";
-                for (auto const& v : verts)
-                    obj << "vt " << v.Uv.X << ' ' << v.Uv.Y << "\n";
+    void AddMesh(const std::shared_ptr<SeEditor::Forest::SuRenderMesh>& mesh)
+    {
+        if (!mesh)
+            return;
+        for (auto const& prim : mesh->Primitives)
+        {
+            if (!prim || !prim->VertexStream)
+                continue;
+            auto verts = DecodeVertexStream(*prim->VertexStream);
+            if (verts.empty())
+                continue;
+            auto decoded = SeEditor::Forest::GetDecodedPrimitiveIndices(*prim, verts.size());
+            if (decoded->Triangles.empty())
+                continue;
+            std::vector<std::uint32_t> idx = decoded->Triangles;
+            SeEditor::Export::OptimizeMesh(verts, idx, _options.MeshOptimization);
 
-                for (std::size_t i = 0; i + 2 < idx.size(); i += 3)
+            std::string mName = MaterialName(prim->Material);
+            if (!_writtenMtl[mName])
+            {
+                _writtenMtl[mName] = true;
+                _mtl.Put("newmtl ");
+                _mtl.Put(mName);
+                _mtl.Put("\nKd 1.000000 1.000000 1.000000\n");
+                auto texPath = MaterialTexturePath(prim->Material, _texturePaths);
+                if (!texPath.empty())
                 {
-                    obj << "f ";
-                    for (int k = 0; k < 3; ++k)
+                    auto rel = std::filesystem::relative(texPath, _objPath.parent_path(), _ec);
+                    if (!_ec)
                     {
-                        std::size_t vi = vBase + static_cast<std::size_t>(idx[i + k]);
-                        obj << vi << "/" << vi << "/" << vi;
-                        if (k < 2)
-                            obj << ' ';
+                        _mtl.Put("map_Kd ");
+                        _mtl.Put(rel.generic_string());
+                        _mtl.Put('\n');
                     }
-                    obj << "\n";
                 }
-                vBase += verts.size();
+                _mtl.Put('\n');
             }
-        };
 
-        exportMesh(branch->Mesh);
-        if (branch->Lod)
+            _obj.Put("g ");
+            _obj.Put(mName);
+            _obj.Put("\nusemtl ");
+            _obj.Put(mName);
+            _obj.Put('\n');
+            ++_subMeshCount;
+
+            for (auto const& v : verts)
+                _obj.PutVec3("v", v.Pos.X, v.Pos.Y, v.Pos.Z);
+            for (auto const& v : verts)
+                _obj.PutVec3("vn", v.Normal.X, v.Normal.Y, v.Normal.Z);
+            for (auto const& v : verts)
+                _obj.PutVec2("vt", v.Uv.X, v.Uv.Y);
+
+            for (std::size_t i = 0; i + 2 < idx.size(); i += 3)
+                _obj.PutFaceVtn(_vBase + idx[i], _vBase + idx[i + 1], _vBase + idx[i + 2]);
+            _vBase += verts.size();
+        }
+    }
+
+    void AddBranch(SeEditor::Forest::SuBranch const& branch)
+    {
+        AddMesh(branch.Mesh);
+        if (branch.Lod)
         {
-            for (auto const& th : branch->Lod->Thresholds)
+            for (auto const& th : branch.Lod->Thresholds)
                 if (th && th->Mesh)
-                    exportMesh(th->Mesh);
+                    AddMesh(th->Mesh);
         }
     }
 
-    result.Success = true;
-    result.SubMeshCount = subMeshCount;
+    // Flushes both files; false if either failed to write.
+    bool Close()
+    {
+        const bool objOk = _obj.Close();
+        const bool mtlOk = _mtl.Close();
+        return _opened && objOk && mtlOk;
+    }
+
+private:
+    static std::string MaterialName(const std::shared_ptr<SeEditor::Forest::SuRenderMaterial>& mat)
+    {
+        if (!mat)
+            return "mat_default";
+        if (!mat->Name.empty())
+            return SanitizeName(mat->Name);
+        return "mat_" + std::to_string(mat->Hash);
+    }
+
+    const std::filesystem::path& _objPath;
+    TexturePathMap const& _texturePaths;
+    std::error_code& _ec;
+    ExportOptions const& _options;
+    SeEditor::Export::BufferedTextWriter _obj;
+    SeEditor::Export::BufferedTextWriter _mtl;
+    bool _opened = false;
+    std::unordered_map<std::string, bool> _writtenMtl;
+    std::size_t _vBase = 1;
+    std::size_t _subMeshCount = 0;
+};
+
+ObjMtlExportResult ExportTreeToObjMtl(const std::filesystem::path& objPath,
+                                     const std::filesystem::path& mtlPath,
+                                     TexturePathMap const& texturePaths,
+                                     SeEditor::Forest::SuRenderTree const& tree,
+                                     std::error_code& ec,
+                                     ExportOptions const& options)
+{
+    ObjMtlExportResult result{};
+
+    ObjMtlBuilder builder(objPath, mtlPath, texturePaths, ec, options);
+    if (!builder.IsOpen())
+        return result;
+
+    builder.Object("tree");
+    for (auto const& branch : tree.Branches)
+    {
+        if (branch)
+            builder.AddBranch(*branch);
+    }
+
+    result.Success = builder.Close();
+    result.SubMeshCount = builder.SubMeshCount();
     return result;
 }
 
 ObjMtlExportResult ExportBranchToObjMtl(const std::filesystem::path& objPath,
                                        const std::filesystem::path& mtlPath,
-                                       const std::filesystem::path& texturesRoot,
+                                       TexturePathMap const& texturePaths,
                                        const std::shared_ptr<SeEditor::Forest::SuBranch>& branch,
-                                       const SeEditor::Forest::SuRenderForest& forest,
-                                       std::error_code& ec)
+                                       std::error_code& ec,
+                                       ExportOptions const& options)
 {
     ObjMtlExportResult result{};
     if (!branch)
         return result;
 
-    std::ofstream obj(objPath, std::ios::binary | std::ios::trunc);
-    if (!obj)
-        return result;
-    std::ofstream mtl(mtlPath, std::ios::binary | std::ios::trunc);
-    if (!mtl)
+    ObjMtlBuilder builder(objPath, mtlPath, texturePaths, ec, options);
+    if (!builder.IsOpen())
         return result;
 
-    std::unordered_map<const SeEditor::Forest::SuRenderTextureResource*, std::filesystem::path> texOutByPtr;
-    texOutByPtr.reserve(forest.TextureResources.size());
+    builder.Object("branch");
+    builder.AddBranch(*branch);
 
-    auto materialName = [](const std::shared_ptr<SeEditor::Forest::SuRenderMaterial>& mat) -> std::string {
-        if (!mat)
-            return "mat_default";
-        if (!mat->Name.empty())
-            return SanitizeName(mat->Name);
-        return "mat_" + std::to_string(mat->Hash);
-    };
+    const bool written = builder.Close();
+    result.Success = written && builder.SubMeshCount() > 0;
+    result.SubMeshCount = builder.SubMeshCount();
+    return result;
+}
 
-    auto materialTexturePath = [&](const std::shared_ptr<SeEditor::Forest::SuRenderMaterial>& mat) -> std::filesystem::path {
-        if (!mat)
-            return {};
-        for (auto const& t : mat->Textures)
+bool ExportCollisionToObj(const std::filesystem::path& outPath,
+                          SeEditor::Forest::SuRenderTree const& tree,
+                          SeEditor::Export::TextFormatOptions const& textOptions)
+{
+    SeEditor::Export::BufferedTextWriter obj(textOptions);
+    if (!obj.Open(outPath))
+        return false;
+
+    obj.Put("o collision\n");
+    std::size_t vBase = 1;
+    for (auto const& cm : tree.CollisionMeshes)
+    {
+        if (!cm)
+            continue;
+        for (auto const& tri : cm->Triangles)
         {
-            if (!t || !t->TextureResource)
+            if (!tri)
                 continue;
-            auto* key = t->TextureResource.get();
-            auto it = texOutByPtr.find(key);
-            if (it != texOutByPtr.end())
-                return it->second;
+            obj.PutVec3("v", tri->A.X, tri->A.Y, tri->A.Z);
+            obj.PutVec3("v", tri->B.X, tri->B.Y, tri->B.Z);
+            obj.PutVec3("v", tri->C.X, tri->C.Y, tri->C.Z);
+            obj.PutFace(vBase, vBase + 1, vBase + 2);
+            vBase += 3;
+        }
+    }
+    return obj.Close();
+}
+
+struct GlbVertex
+{
+    Vector3 Pos{};
+    Vector3 Normal{};
+    Vector2 Uv{};
+    std::array<std::uint16_t, 4> Joints{};
+    std::array<float, 4> Weights{};
+};
 
-            auto written = WriteTextureFile(texturesRoot, t->TextureResource->Name, t->TextureResource->ImageData, ec);
-            if (!written.empty())
+// Decoded vertices plus blend indices/weights; `skinned` is set when the stream carries blend indices.
+std::vector<GlbVertex> DecodeGlbVertices(SeEditor::Forest::SuRenderVertexStream const& stream, bool& skinned)
+{
+    using namespace SeEditor::Forest;
+    skinned = false;
+    auto base = DecodeVertexStream(stream);
+    std::vector<GlbVertex> verts(base.size());
+    for (std::size_t i = 0; i < base.size(); ++i)
+    {
+        verts[i].Pos = base[i].Pos;
+        verts[i].Normal = base[i].Normal;
+        verts[i].Uv = base[i].Uv;
+        verts[i].Weights = {1.0f, 0.0f, 0.0f, 0.0f};
+    }
+
+    auto readU8 = [&](std::size_t offset) -> std::uint8_t {
+        return offset < stream.Stream.size() ? stream.Stream[offset] : 0;
+    };
+    auto readU16 = [&](std::size_t offset) -> std::uint16_t {
+        if (offset + 2 > stream.Stream.size())
+            return 0;
+        return static_cast<std::uint16_t>(stream.Stream[offset] | (stream.Stream[offset + 1] << 8));
+    };
+    auto readFloat = [&](std::size_t offset) -> float {
+        if (offset + 4 > stream.Stream.size())
+            return 0.0f;
+        float v = 0.0f;
+        std::memcpy(&v, stream.Stream.data() + offset, sizeof(float));
+        return v;
+    };
+
+    for (auto const& attr : stream.AttributeStreamsInfo)
+    {
+        if (attr.Stream != 0)
+            continue;
+        if (attr.Usage == D3DDeclUsage::BlendIndices &&
+            (attr.Type == D3DDeclType::UByte4 || attr.Type == D3DDeclType::UByte4N || attr.Type == D3DDeclType::Short4))
+            skinned = true;
+    }
+    if (!skinned)
+        return verts;
+
+    for (std::size_t i = 0; i < verts.size(); ++i)
+    {
+        const std::size_t vbase = i * static_cast<std::size_t>(stream.VertexStride);
+        GlbVertex& v = verts[i];
+        for (auto const& attr : stream.AttributeStreamsInfo)
+        {
+            if (attr.Stream != 0)
+                continue;
+            const std::size_t off = vbase + static_cast<std::size_t>(attr.Offset);
+            if (attr.Usage == D3DDeclUsage::BlendWeight)
+            {
+                if (attr.Type == D3DDeclType::Float4)
+                    v.Weights = {readFloat(off + 0), readFloat(off + 4), readFloat(off + 8), readFloat(off + 12)};
+                else if (attr.Type == D3DDeclType::UByte4N)
+                    v.Weights = {readU8(off + 0) / 255.0f, readU8(off + 1) / 255.0f, readU8(off + 2) / 255.0f,
+                                 readU8(off + 3) / 255.0f};
+                else if (attr.Type == D3DDeclType::Short4N)
+                    v.Weights = {static_cast<std::int16_t>(readU16(off + 0)) / 32767.0f,
+                                 static_cast<std::int16_t>(readU16(off + 2)) / 32767.0f,
+                                 static_cast<std::int16_t>(readU16(off + 4)) / 32767.0f,
+                                 static_cast<std::int16_t>(readU16(off + 6)) / 32767.0f};
+            }
+            else if (attr.Usage == D3DDeclUsage::BlendIndices)
             {
-                texOutByPtr[key] = written;
-                return written;
+                if (attr.Type == D3DDeclType::UByte4 || attr.Type == D3DDeclType::UByte4N)
+                    v.Joints = {readU8(off + 0), readU8(off + 1), readU8(off + 2), readU8(off + 3)};
+                else if (attr.Type == D3DDeclType::Short4)
+                    v.Joints = {readU16(off + 0), readU16(off + 2), readU16(off + 4), readU16(off + 6)};
             }
         }
-        return {};
-    };
 
-    std::unordered_map<std::string, bool> writtenMtl;
+        float sum = v.Weights[0] + v.Weights[1] + v.Weights[2] + v.Weights[3];
+        if (sum > 0.0f)
+        {
+            for (auto& w : v.Weights)
+                w /= sum;
+        }
+        else
+        {
+            v.Weights = {1.0f, 0.0f, 0.0f, 0.0f};
+        }
+    }
+    return verts;
+}
 
-    obj << "mtllib " << mtlPath.filename().string() << "\n";
-    obj << "o branch\n";
+SlLib::Math::Matrix4x4 LocalMatrixFromTrs(Vector4 t, Vector4 r, Vector4 s)
+{
+    SlLib::Math::Matrix4x4 rot = SlLib::Math::CreateFromQuaternion({r.X, r.Y, r.Z, r.W});
+    SlLib::Math::Matrix4x4 scale{};
+    scale(0, 0) = s.X;
+    scale(1, 1) = s.Y;
+    scale(2, 2) = s.Z;
+    scale(3, 3) = 1.0f;
+    SlLib::Math::Matrix4x4 local = SlLib::Math::Multiply(rot, scale);
+    local(0, 3) = t.X;
+    local(1, 3) = t.Y;
+    local(2, 3) = t.Z;
+    local(3, 3) = 1.0f;
+    return local;
+}
 
-    std::size_t vBase = 1;
-    std::size_t subMeshCount = 0;
+// Writes the tree as one GLB: a node per SuBranch mirroring the hierarchy with its TRS, branch meshes
+// (LOD meshes as child nodes) and, for meshes with a bone palette, a skin whose joints are the branch nodes.
+// Skinned vertices are in tree space, so their inverse bind matrices come from the bind-pose hierarchy.
+bool ExportTreeToGlb(const std::filesystem::path& glbPath,
+                     std::string const& treeName,
+                     SeEditor::Forest::SuRenderTree const& tree,
+                     TexturePathMap const& texturePaths,
+                     ExportOptions const& options,
+                     std::string& error)
+{
+    using namespace SeEditor::Export;
+    GlbDocument doc;
+    GlbNode root;
+    root.Name = treeName;
+    doc.Nodes.push_back(std::move(root));
+    doc.SceneNodes.push_back(0);
+
+    const std::size_t branchCount = tree.Branches.size();
+    std::vector<int> branchNode(branchCount, -1);
+    std::vector<Vector4> t(branchCount, Vector4{}), r(branchCount, Vector4{0, 0, 0, 1}), s(branchCount, Vector4{1, 1, 1, 1});
+    for (std::size_t i = 0; i < branchCount; ++i)
+    {
+        auto const& branch = tree.Branches[i];
+        if (!branch)
+            continue;
+        if (i < tree.Translations.size())
+            t[i] = tree.Translations[i];
+        if (i < tree.Rotations.size())
+            r[i] = tree.Rotations[i];
+        if (i < tree.Scales.size())
+            s[i] = tree.Scales[i];
+
+        GlbNode node;
+        node.Name = branch->Name.empty() ? ("Branch_" + std::to_string(i)) : branch->Name;
+        node.Translation = {t[i].X, t[i].Y, t[i].Z};
+        node.Rotation = r[i];
+        node.Scale = {s[i].X, s[i].Y, s[i].Z};
+        branchNode[i] = static_cast<int>(doc.Nodes.size());
+        doc.Nodes.push_back(std::move(node));
+    }
+    for (std::size_t i = 0; i < branchCount; ++i)
+    {
+        if (branchNode[i] < 0)
+            continue;
+        const int parent = tree.Branches[i]->Parent;
+        int parentNode = 0;
+        if (parent >= 0 && static_cast<std::size_t>(parent) < branchCount && static_cast<std::size_t>(parent) != i &&
+            branchNode[static_cast<std::size_t>(parent)] >= 0)
+            parentNode = branchNode[static_cast<std::size_t>(parent)];
+        doc.Nodes[static_cast<std::size_t>(parentNode)].Children.push_back(branchNode[i]);
+    }
+
+    std::vector<SlLib::Math::Matrix4x4> bindWorld(branchCount);
+    std::vector<std::uint8_t> bindState(branchCount, 0); // 0 = pending, 1 = visiting, 2 = done
+    auto computeBind = [&](auto&& self, std::size_t i) -> SlLib::Math::Matrix4x4 const& {
+        if (bindState[i] == 2)
+            return bindWorld[i];
+        bindState[i] = 1;
+        SlLib::Math::Matrix4x4 local = LocalMatrixFromTrs(t[i], r[i], s[i]);
+        const int parent = tree.Branches[i] ? tree.Branches[i]->Parent : -1;
+        if (parent >= 0 && static_cast<std::size_t>(parent) < branchCount && bindState[static_cast<std::size_t>(parent)] != 1)
+            bindWorld[i] = SlLib::Math::Multiply(self(self, static_cast<std::size_t>(parent)), local);
+        else
+            bindWorld[i] = local;
+        bindState[i] = 2;
+        return bindWorld[i];
+    };
+
+    std::unordered_map<const SeEditor::Forest::SuRenderMaterial*, int> materialIndex;
+    std::unordered_map<std::string, int> textureIndex;
+    auto resolveMaterial = [&](const std::shared_ptr<SeEditor::Forest::SuRenderMaterial>& mat) -> int {
+        auto it = materialIndex.find(mat.get());
+        if (it != materialIndex.end())
+            return it->second;
+        GlbMaterial glbMat;
+        glbMat.Name = !mat ? "mat_default" : (!mat->Name.empty() ? SanitizeName(mat->Name) : "mat_" + std::to_string(mat->Hash));
+        auto texPath = MaterialTexturePath(mat, texturePaths);
+        if (!texPath.empty())
+        {
+            std::error_code relEc;
+            auto rel = std::filesystem::relative(texPath, glbPath.parent_path(), relEc);
+            if (!relEc)
+            {
+                auto [texIt, inserted] = textureIndex.emplace(rel.generic_string(), static_cast<int>(doc.Textures.size()));
+                if (inserted)
+                    doc.Textures.push_back({rel.generic_string()});
+                glbMat.Texture = texIt->second;
+            }
+        }
+        const int index = static_cast<int>(doc.Materials.size());
+        doc.Materials.push_back(std::move(glbMat));
+        materialIndex.emplace(mat.get(), index);
+        return index;
+    };
 
-    auto exportMesh = [&](const std::shared_ptr<SeEditor::Forest::SuRenderMesh>& mesh) {
+    // Bones that do not resolve to a branch are bound to one identity node under the root, created on first use.
+    int unboundJoint = -1;
+    auto unboundJointNode = [&]() {
+        if (unboundJoint < 0)
+        {
+            GlbNode node;
+            node.Name = "UnboundJoint";
+            unboundJoint = static_cast<int>(doc.Nodes.size());
+            doc.Nodes.push_back(std::move(node));
+            doc.Nodes[0].Children.push_back(unboundJoint);
+        }
+        return unboundJoint;
+    };
+
+    auto addMesh = [&](const std::shared_ptr<SeEditor::Forest::SuRenderMesh>& mesh, std::size_t branchIdx, std::string name) {
         if (!mesh)
             return;
+        GlbMesh glbMesh;
+        glbMesh.Name = mesh->Name.empty() ? name : mesh->Name;
+        bool meshSkinned = false;
+
+        // glTF requires a skin's joints to be unique, so palette entries that name the same node share a
+        // joint and vertex palette indices are remapped to joint indices.
+        GlbSkin skin;
+        std::vector<std::uint16_t> paletteJoint;
+        auto buildSkin = [&]() {
+            std::unordered_map<int, std::uint16_t> jointOfNode;
+            paletteJoint.resize(mesh->BoneMatrixIndices.size());
+            for (std::size_t p = 0; p < mesh->BoneMatrixIndices.size(); ++p)
+            {
+                const int bone = mesh->BoneMatrixIndices[p];
+                const bool resolved = bone >= 0 && static_cast<std::size_t>(bone) < branchCount &&
+                                      branchNode[static_cast<std::size_t>(bone)] >= 0;
+                const int node = resolved ? branchNode[static_cast<std::size_t>(bone)] : unboundJointNode();
+                auto [it, inserted] = jointOfNode.emplace(node, static_cast<std::uint16_t>(skin.Joints.size()));
+                if (inserted)
+                {
+                    skin.Joints.push_back(node);
+                    if (resolved)
+                    {
+                        skin.InverseBindMatrices.push_back(
+                            SlLib::Math::Invert(computeBind(computeBind, static_cast<std::size_t>(bone))));
+                    }
+                    else
+                    {
+                        SlLib::Math::Matrix4x4 identity{};
+                        for (std::size_t k = 0; k < 4; ++k)
+                            identity(k, k) = 1.0f;
+                        skin.InverseBindMatrices.push_back(identity);
+                    }
+                }
+                paletteJoint[p] = it->second;
+            }
+        };
         for (auto const& prim : mesh->Primitives)
         {
             if (!prim || !prim->VertexStream)
                 continue;
-            auto verts = DecodeVertexStream(*prim->VertexStream);
+            bool skinned = false;
+            auto verts = DecodeGlbVertices(*prim->VertexStream, skinned);
             if (verts.empty())
                 continue;
-            auto idx = DecodePrimitiveIndices(*prim, verts.size());
-            if (idx.empty())
+            auto decoded = SeEditor::Forest::GetDecodedPrimitiveIndices(*prim, verts.size());
+            if (decoded->Triangles.empty())
                 continue;
-
-            std::string mName = materialName(prim->Material);
-            if (!writtenMtl[mName])
+            std::vector<std::uint32_t> idx = decoded->Triangles;
+            SeEditor::Export::OptimizeMesh(verts, idx, options.MeshOptimization);
+
+            skinned = skinned && !mesh->BoneMatrixIndices.empty();
+            if (skinned && paletteJoint.empty())
+                buildSkin();
+            meshSkinned = meshSkinned || skinned;
+            GlbPrimitive glbPrim;
+            glbPrim.Positions.reserve(verts.size());
+            glbPrim.Normals.reserve(verts.size());
+            glbPrim.Uvs.reserve(verts.size());
+            for (auto const& v : verts)
             {
-                writtenMtl[mName] = true;
-                mtl << "newmtl " << mName << "\n";
-                mtl << "Kd 1.000000 1.000000 1.000000\n";
-                auto texPath = materialTexturePath(prim->Material);
-                if (!texPath.empty())
+                glbPrim.Positions.push_back(v.Pos);
+                glbPrim.Normals.push_back(v.Normal);
+                glbPrim.Uvs.push_back(v.Uv);
+                if (skinned)
                 {
-                    auto rel = std::filesystem::relative(texPath, objPath.parent_path(), ec);
-                    if (!ec)
-                        mtl << "map_Kd " << rel.generic_string() << "\n";
+                    auto joints = v.Joints;
+                    for (auto& j : joints)
+                        j = paletteJoint[j < paletteJoint.size() ? j : 0];
+                    glbPrim.Joints.push_back(joints);
+                    glbPrim.Weights.push_back(v.Weights);
                 }
-                mtl << "\n";
             }
+            glbPrim.Indices = std::move(idx);
+            glbPrim.Material = resolveMaterial(prim->Material);
+            glbMesh.Primitives.push_back(std::move(glbPrim));
+        }
+        if (glbMesh.Primitives.empty())
+            return;
 
-            obj << "g " << mName << "\n";
-            obj << "usemtl " << mName << "\n";
-            ++subMeshCount;
-
-            for (auto const& v : verts)
-                obj << "v " << v.Pos.X << ' ' << v.Pos.Y << ' ' << v.Pos.Z << "\n";
-            for (auto const& v : verts)
-                obj << "vn " << v.Normal.X << ' ' << v.Normal.Y << ' ' << v.Normal.Z << "\n";
-            for (auto const& v : verts)
-                obj << "vt " << v.Uv.X << ' ' << v.Uv.Y << "\n";
-
-            for (std::size_t i = 0; i + 2 < idx.size(); i += 3)
+        // glTF needs every primitive of a skinned mesh to carry joints; give rigid ones the first joint.
+        if (meshSkinned)
+        {
+            for (auto& glbPrim : glbMesh.Primitives)
             {
-                obj << "f ";
-                for (int k = 0; k < 3; ++k)
-                {
-                    std::size_t vi = vBase + static_cast<std::size_t>(idx[i + k]);
-                    obj << vi << "/" << vi << "/" << vi;
-                    if (k < 2)
-                        obj << ' ';
-                }
-                obj << "\n";
+                if (!glbPrim.Joints.empty())
+                    continue;
+                glbPrim.Joints.assign(glbPrim.Positions.size(), {0, 0, 0, 0});
+                glbPrim.Weights.assign(glbPrim.Positions.size(), {1.0f, 0.0f, 0.0f, 0.0f});
             }
-            vBase += verts.size();
         }
+
+        const int meshIndex = static_cast<int>(doc.Meshes.size());
+        doc.Meshes.push_back(std::move(glbMesh));
+
+        GlbNode meshNode;
+        meshNode.Name = name;
+        meshNode.Mesh = meshIndex;
+        if (meshSkinned)
+        {
+            skin.Name = name + "_skin";
+            skin.Skeleton = 0;
+            meshNode.Skin = static_cast<int>(doc.Skins.size());
+            doc.Skins.push_back(std::move(skin));
+            // A skinned mesh is posed by its joints; park it under the tree root.
+            doc.Nodes[0].Children.push_back(static_cast<int>(doc.Nodes.size()));
+        }
+        else
+        {
+            doc.Nodes[static_cast<std::size_t>(branchNode[branchIdx])].Children.push_back(static_cast<int>(doc.Nodes.size()));
+        }
+        doc.Nodes.push_back(std::move(meshNode));
     };
 
-    exportMesh(branch->Mesh);
-    if (branch->Lod)
+    for (std::size_t i = 0; i < branchCount; ++i)
     {
-        for (auto const& th : branch->Lod->Thresholds)
-            if (th && th->Mesh)
-                exportMesh(th->Mesh);
+        auto const& branch = tree.Branches[i];
+        if (!branch)
+            continue;
+        const std::string& branchName = doc.Nodes[static_cast<std::size_t>(branchNode[i])].Name;
+        addMesh(branch->Mesh, i, SanitizeName(branchName) + "_Mesh");
+        if (branch->Lod)
+        {
+            for (std::size_t lod = 0; lod < branch->Lod->Thresholds.size(); ++lod)
+            {
+                auto const& th = branch->Lod->Thresholds[lod];
+                if (th && th->Mesh)
+                    addMesh(th->Mesh, i, SanitizeName(branchName) + "_Lod" + std::to_string(lod));
+            }
+        }
     }
 
-    result.Success = (subMeshCount > 0);
-    result.SubMeshCount = subMeshCount;
-    return result;
+    return WriteGlb(glbPath, doc, error);
 }
 
-bool ExportCollisionToObj(const std::filesystem::path& outPath,
-                          SeEditor::Forest::SuRenderTree const& tree)
+// Collision as GLB: one node/mesh per (surface, flags) type with its own compacted vertex set.
+bool WriteCollisionGlb(const std::filesystem::path& path,
+                       std::span<const Vector3> vertices,
+                       std::span<const std::pair<std::string, std::span<const CollisionTriangle>>> types,
+                       std::string& error)
 {
-    std::ofstream obj(outPath);
-    if (!obj)
-        return false;
-
-    obj << "o collision\n";
-    std::size_t vBase = 1;
-    for (auto const& cm : tree.CollisionMeshes)
-    {
-        if (!cm)
-            continue;
-        for (auto const& tri : cm->Triangles)
+    using namespace SeEditor::Export;
+    GlbDocument doc;
+    GlbNode root;
+    root.Name = "collision";
+    doc.Nodes.push_back(std::move(root));
+    doc.SceneNodes.push_back(0);
+    std::vector<std::uint32_t> remap(vertices.size());
+    for (auto const& [name, triangles] : types)
+    {
+        std::fill(remap.begin(), remap.end(), kUnusedVertex);
+        GlbPrimitive prim;
+        for (auto const& tri : triangles)
         {
-            if (!tri)
+            bool valid = true;
+            for (int idx : tri.Indices)
+                valid = valid && idx >= 0 && static_cast<std::size_t>(idx) < vertices.size();
+            if (!valid)
                 continue;
-            obj << "v " << tri->A.X << ' ' << tri->A.Y << ' ' << tri->A.Z << '\n';
-            obj << "v " << tri->B.X << ' ' << tri->B.Y << ' ' << tri->B.Z << '\n';
-            obj << "v " << tri->C.X << ' ' << tri->C.Y << ' ' << tri->C.Z << '\n';
-            obj << "f " << vBase << ' ' << (vBase + 1) << ' ' << (vBase + 2) << '\n';
-            vBase += 3;
+            for (int idx : tri.Indices)
+            {
+                std::uint32_t& slot = remap[static_cast<std::size_t>(idx)];
+                if (slot == kUnusedVertex)
+                {
+                    slot = static_cast<std::uint32_t>(prim.Positions.size());
+                    prim.Positions.push_back(vertices[static_cast<std::size_t>(idx)]);
+                }
+                prim.Indices.push_back(slot);
+            }
         }
-    }
-    return true;
+        if (prim.Indices.empty())
+            continue;
+        GlbMesh mesh;
+        mesh.Name = name;
+        mesh.Primitives.push_back(std::move(prim));
+        GlbNode node;
+        node.Name = name;
+        node.Mesh = static_cast<int>(doc.Meshes.size());
+        doc.Meshes.push_back(std::move(mesh));
+        doc.Nodes[0].Children.push_back(static_cast<int>(doc.Nodes.size()));
+        doc.Nodes.push_back(std::move(node));
+    }
+    return WriteGlb(path, doc, error);
 }
 
 bool ParseCollisionMeshChunk(SeEditor::SifChunkInfo const& chunk,
@@ -1821,6 +2023,33 @@ struct UnityPrefabWriter
     }
 };
 
+// Input key for a chunk: its raw bytes plus relocations.
+std::uint64_t ChunkContentHash(SeEditor::SifChunkInfo const& chunk)
+{
+    std::uint64_t hash = SeEditor::Export::HashValue(chunk.TypeValue);
+    hash = SeEditor::Export::HashBytes(chunk.RawChunk.empty() ? chunk.Data : chunk.RawChunk, hash);
+    return SeEditor::Export::HashBytes(chunk.RelocRaw, hash);
+}
+
+// Everything in ExportOptions that changes output bytes (ThreadCount does not). Bump kExportFormatVersion
+// whenever the exporter's output changes, so incremental runs do not keep assets from an older exporter.
+constexpr std::uint64_t kExportFormatVersion = 1;
+
+std::uint64_t HashExportOptions(ExportOptions const& options)
+{
+    using SeEditor::Export::HashValue;
+    auto const& mesh = options.MeshOptimization;
+    std::uint64_t hash = HashValue(kExportFormatVersion);
+    hash = HashValue((mesh.WeldVertices ? 1u : 0u) | (mesh.OptimizeVertexCache ? 2u : 0u) |
+                         (mesh.OptimizeOverdraw ? 4u : 0u) | (mesh.OptimizeVertexFetch ? 8u : 0u),
+                     hash);
+    hash = HashValue(mesh.CacheSize, hash);
+    hash = HashValue(static_cast<std::uint64_t>(options.ObjText.Floats), hash);
+    hash = HashValue(static_cast<std::uint64_t>(options.ObjText.Precision), hash);
+    hash = HashValue(options.WriteGlb ? 1u : 0u, hash);
+    return SeEditor::Export::HashString(options.SharedTextureDir.generic_string(), hash);
+}
+
 } // namespace
 
 std::filesystem::path FindUnityProjectRoot(std::filesystem::path const& startDir)
@@ -1958,11 +2187,13 @@ static std::optional<std::filesystem::path> TryPrepareUnityProjectAtRoot(std::fi
 }
 
 ExportResult ExportSifToUnity(std::filesystem::path const& sifPath,
-                             std::filesystem::path const& unityProjectRoot)
+                             std::filesystem::path const& unityProjectRoot,
+                             ExportOptions const& options)
 {
     ExportResult result;
 
-    if (!std::filesystem::exists(sifPath))
+    auto* sourceFs = options.SourceFileSystem;
+    if (sourceFs ? !sourceFs->DoesFileExist(sifPath.generic_string()) : !std::filesystem::exists(sifPath))
     {
         result.Error = "Input not found: " + sifPath.string();
         return result;
@@ -1981,25 +2212,34 @@ ExportResult ExportSifToUnity(std::filesystem::path const& sifPath,
         unityRoot = *prepared;
     }
 
-    std::ifstream file(sifPath, std::ios::binary);
-    if (!file)
-    {
-        result.Error = "Failed to open input: " + sifPath.string();
-        return result;
-    }
-
-    std::vector<char> buffer((std::istreambuf_iterator<char>(file)), {});
-    std::vector<std::uint8_t> data(buffer.begin(), buffer.end());
-
-    std::string error;
-    auto parsed = SeEditor::ParseSifFile(std::span<const std::uint8_t>(data.data(), data.size()), error);
-    if (!parsed)
+    std::vector<std::uint8_t> data;
+    std::vector<std::uint8_t> gpuData;
+    if (sourceFs)
     {
-        result.Error = "SIF parse error: " + error;
-        return result;
+        try
+        {
+            data = sourceFs->GetFile(sifPath.generic_string());
+            gpuData = LoadGpuDataForSif(*sourceFs, sifPath);
+        }
+        catch (std::exception const& ex)
+        {
+            result.Error = "Failed to read input: " + std::string(ex.what());
+            return result;
+        }
     }
+    else
+    {
+        std::ifstream file(sifPath, std::ios::binary);
+        if (!file)
+        {
+            result.Error = "Failed to open input: " + sifPath.string();
+            return result;
+        }
 
-    auto gpuData = LoadGpuDataForSif(sifPath);
+        std::vector<char> buffer((std::istreambuf_iterator<char>(file)), {});
+        data.assign(buffer.begin(), buffer.end());
+        gpuData = LoadGpuDataForSif(sifPath);
+    }
     std::span<const std::uint8_t> gpuSpan;
     if (!gpuData.empty())
         gpuSpan = std::span<const std::uint8_t>(gpuData.data(), gpuData.size());
@@ -2011,6 +2251,7 @@ ExportResult ExportSifToUnity(std::filesystem::path const& sifPath,
     const std::filesystem::path jsonPath = exportRoot / "export.json";
     const std::filesystem::path scenePath = exportRoot / (sifPath.stem().string() + ".unity");
     const std::filesystem::path collisionPath = exportRoot / "collision.obj";
+    const std::filesystem::path collisionGlbPath = exportRoot / "collision.glb";
     const std::filesystem::path collisionTypesDir = exportRoot / "collision_types";
     const std::filesystem::path subbranchRoot = exportRoot / "SuBranches";
     const std::filesystem::path rawRoot = exportRoot / "Raw";
@@ -2018,6 +2259,7 @@ ExportResult ExportSifToUnity(std::filesystem::path const& sifPath,
     const std::filesystem::path waypointsPath = navRoot / "waypoints.json";
     const std::filesystem::path rawColiPath = rawRoot / "COLI.raw";
     const std::filesystem::path rawTrakPath = rawRoot / "TRAK.raw";
+    const std::filesystem::path manifestPath = exportRoot / "export.manifest";
 
     std::error_code ec;
     std::filesystem::create_directories(meshesRoot, ec);
@@ -2041,20 +2283,109 @@ ExportResult ExportSifToUnity(std::filesystem::path const& sifPath,
         }
     }
 
+    // Incremental bookkeeping. Every task below is keyed by a hash of exactly what it reads; a task whose key
+    // matches the previous manifest and whose outputs still hash as recorded is skipped. When the SIF, its GPU
+    // data and the output-affecting options are all unchanged, nothing is parsed at all.
+    using SeEditor::Export::HashBytes;
+    using SeEditor::Export::HashValue;
+    const std::uint64_t optionsKey = HashExportOptions(options);
+    const std::uint64_t gpuKey = HashBytes(gpuSpan);
+    const std::uint64_t sourceKey = HashValue(optionsKey, HashValue(gpuKey, HashBytes(data)));
+    SeEditor::Export::ExportManifest previousManifest;
+    if (options.Incremental && previousManifest.Load(manifestPath) && previousManifest.SourceKey == sourceKey &&
+        previousManifest.Find("export") != nullptr && previousManifest.AllOutputsMatch(exportRoot, options.ThreadCount))
+    {
+        result.Success = true;
+        result.UpToDate = true;
+        result.SkippedTasks = previousManifest.Tasks.size();
+        result.ExportJsonPath = jsonPath;
+        result.ScenePath = scenePath;
+        return result;
+    }
+
+    SeEditor::Export::ExportManifest manifest;
+    manifest.SourceKey = sourceKey;
+    struct ManifestSlot
+    {
+        SeEditor::Export::ManifestTask* Task = nullptr;
+        bool UpToDate = false;
+    };
+    // Registers a task in the new manifest; an up-to-date task carries its previous outputs over. Called on
+    // this thread only, so running tasks may fill their own slot's Outputs without locking.
+    auto trackTask = [&](std::string const& id, std::uint64_t key) {
+        ManifestSlot slot;
+        slot.Task = &manifest.Tasks[id];
+        slot.Task->Key = key;
+        if (options.Incremental && previousManifest.IsUpToDate(id, key, exportRoot))
+        {
+            slot.Task->Outputs = previousManifest.Find(id)->Outputs;
+            slot.UpToDate = true;
+            ++result.SkippedTasks;
+        }
+        return slot;
+    };
+    auto addOutput = [&](ManifestSlot const& slot, std::filesystem::path const& path) {
+        SeEditor::Export::AddManifestOutput(slot.Task->Outputs, exportRoot, path);
+    };
+
+    std::string error;
+    auto parsed = SeEditor::ParseSifFile(std::span<const std::uint8_t>(data.data(), data.size()), error);
+    if (!parsed)
+    {
+        result.Error = "SIF parse error: " + error;
+        return result;
+    }
+
+    // The export below is split into independent tasks (forest load, raw dumps, waypoints, collision types,
+    // textures, trees). Each task writes only its own files and result slot; export.json and the scene are
+    // assembled afterwards in source order, so the output does not depend on the worker count.
+    const std::size_t threadCount = SlLib::Utilities::ResolveThreadCount(options.ThreadCount);
+
+    struct ExportTask
+    {
+        std::function<void(std::string& error)> Run;
+        std::string Error;
+    };
+    // Runs a batch of tasks; the first failing task (in task order) becomes the export error.
+    auto runTasks = [&](std::vector<ExportTask>& tasks) {
+        SlLib::Utilities::ParallelFor(tasks.size(), threadCount, [&](std::size_t i) { tasks[i].Run(tasks[i].Error); });
+        for (auto const& task : tasks)
+        {
+            if (!task.Error.empty())
+            {
+                result.Error = task.Error;
+                return false;
+            }
+        }
+        return true;
+    };
+
     struct ForestSource
     {
         std::string name;
         std::shared_ptr<SeEditor::Forest::ForestLibrary> library;
+        std::uint64_t key = 0;
     };
     std::vector<ForestSource> forests;
-    for (auto const& chunk : parsed->Chunks)
     {
-        if (chunk.TypeValue != 0x45524F46) // 'FORE'
-            continue;
-        std::shared_ptr<SeEditor::Forest::ForestLibrary> lib;
-        if (!TryLoadForestLibraryFromChunk(chunk, gpuSpan, lib, error))
-            continue;
-        forests.push_back({chunk.Name, std::move(lib)});
+        std::vector<const SeEditor::SifChunkInfo*> forestChunks;
+        for (auto const& chunk : parsed->Chunks)
+        {
+            if (chunk.TypeValue == 0x45524F46) // 'FORE'
+                forestChunks.push_back(&chunk);
+        }
+
+        std::vector<std::shared_ptr<SeEditor::Forest::ForestLibrary>> libraries(forestChunks.size());
+        SlLib::Utilities::ParallelFor(forestChunks.size(), threadCount, [&](std::size_t i) {
+            std::string loadError;
+            TryLoadForestLibraryFromChunk(*forestChunks[i], gpuSpan, libraries[i], loadError);
+        });
+        for (std::size_t i = 0; i < forestChunks.size(); ++i)
+        {
+            if (libraries[i])
+                forests.push_back({forestChunks[i]->Name, std::move(libraries[i]),
+                                   HashValue(gpuKey, ChunkContentHash(*forestChunks[i]))});
+        }
     }
 
     SlLib::SumoTool::Siff::LogicData logic;
@@ -2067,46 +2398,56 @@ ExportResult ExportSifToUnity(std::filesystem::path const& sifPath,
     std::string navError;
     bool hasNavigation = SeEditor::LoadNavigationFromSifChunks(parsed->Chunks, navigation, navProbe, navError);
 
+    std::vector<ExportTask> assetTasks;
+
     // Dump raw chunks for future repacking/edit workflows.
-    {
-        auto dumpRaw = [&](std::uint32_t type, std::filesystem::path const& outPath) {
-            auto it = std::find_if(parsed->Chunks.begin(), parsed->Chunks.end(),
-                                   [&](SeEditor::SifChunkInfo const& c) { return c.TypeValue == type; });
+    auto addRawDump = [&](std::uint32_t type, std::filesystem::path const& outPath) {
+        auto it = std::find_if(parsed->Chunks.begin(), parsed->Chunks.end(),
+                               [&](SeEditor::SifChunkInfo const& c) { return c.TypeValue == type; });
+        auto slot = trackTask("raw/" + outPath.stem().string(), it != parsed->Chunks.end() ? ChunkContentHash(*it) : 0);
+        if (slot.UpToDate)
+            return;
+        addOutput(slot, outPath);
+        assetTasks.push_back({[&, it, outPath](std::string& taskError) {
             if (it != parsed->Chunks.end())
             {
                 if (!WriteBinaryFile(outPath, std::span<const std::uint8_t>(it->RawChunk.data(), it->RawChunk.size())))
-                {
-                    result.Error = "Failed to write raw chunk: " + outPath.string();
-                    return false;
-                }
-                return true;
+                    taskError = "Failed to write raw chunk: " + outPath.string();
+                return;
             }
             // Still create the file so tooling can rely on stable paths.
             std::ofstream empty(outPath, std::ios::binary | std::ios::trunc);
-            return true;
-        };
+        }, {}});
+    };
+    addRawDump(0x494C4F43, rawColiPath); // 'COLI'
+    addRawDump(0x4B415254, rawTrakPath); // 'TRAK'
 
-        if (!dumpRaw(0x494C4F43, rawColiPath)) // 'COLI'
-            return result;
-        if (!dumpRaw(0x4B415254, rawTrakPath)) // 'TRAK'
-            return result;
+    // Export waypoints as a Unity-friendly JSON for editor tooling. Navigation may come from any non-forest
+    // chunk, so the key covers all of them.
+    std::uint64_t nonForestKey = 0;
+    for (auto const& chunk : parsed->Chunks)
+    {
+        if (chunk.TypeValue != 0x45524F46) // 'FORE'
+            nonForestKey = HashValue(ChunkContentHash(chunk), nonForestKey);
     }
-
-    // Export waypoints as a Unity-friendly JSON for editor tooling.
+    auto waypointsSlot = trackTask("waypoints", nonForestKey);
+    if (!waypointsSlot.UpToDate)
     {
-        std::ofstream wpOut(waypointsPath, std::ios::binary | std::ios::trunc);
-        if (!wpOut)
-        {
-            result.Error = "Failed to write waypoints: " + waypointsPath.string();
-            return result;
-        }
+        addOutput(waypointsSlot, waypointsPath);
+        assetTasks.push_back({[&](std::string& taskError) {
+            std::ofstream wpOut(waypointsPath, std::ios::binary | std::ios::trunc);
+            if (!wpOut)
+            {
+                taskError = "Failed to write waypoints: " + waypointsPath.string();
+                return;
+            }
+
+            if (!hasNavigation)
+            {
+                wpOut << "{\n  \"waypoints\": [],\n  \"links\": []\n}\n";
+                return;
+            }
 
-        if (!hasNavigation)
-        {
-            wpOut << "{\n  \"waypoints\": [],\n  \"links\": []\n}\n";
-        }
-        else
-        {
             std::unordered_map<const SlLib::SumoTool::Siff::NavData::NavWaypoint*, int> waypointIndex;
             waypointIndex.reserve(navigation.Waypoints.size());
             for (std::size_t i = 0; i < navigation.Waypoints.size(); ++i)
@@ -2165,7 +2506,7 @@ ExportResult ExportSifToUnity(std::filesystem::path const& sifPath,
             }
             wpOut << "\n  ]\n";
             wpOut << "}\n";
-        }
+        }, {}});
     }
 
     struct CollisionExportEntry
@@ -2174,267 +2515,528 @@ ExportResult ExportSifToUnity(std::filesystem::path const& sifPath,
         std::filesystem::path Path;
         std::uint32_t Surface = 0;
         std::uint16_t Flags = 0;
+        std::vector<CollisionTriangle> Triangles;
+        bool Written = false;
     };
     std::vector<CollisionExportEntry> collisionExports;
 
-    // Export a single collision mesh for the whole SIF from COLI chunk (Unity-readable OBJ).
+    // Export a single collision mesh for the whole SIF from COLI chunk (Unity-readable OBJ), plus one mesh
+    // per (surface, flags) pair. Types are emitted in ascending key order.
+    std::vector<SlLib::Math::Vector3> collisionVertices;
+    std::vector<CollisionTriangle> collisionTriangles;
+    bool hasCollisionMesh = false;
+    std::uint64_t collisionKey = optionsKey;
     {
         auto it = std::find_if(parsed->Chunks.begin(), parsed->Chunks.end(),
                                [](SeEditor::SifChunkInfo const& c) { return c.TypeValue == 0x494C4F43; }); // 'COLI'
+        std::string colError;
         if (it != parsed->Chunks.end())
         {
-            std::vector<SlLib::Math::Vector3> vertices;
-            std::vector<CollisionTriangle> triangles;
-            std::string colError;
-            if (ParseCollisionMeshChunk(*it, vertices, triangles, colError))
+            collisionKey = HashValue(ChunkContentHash(*it), optionsKey);
+            hasCollisionMesh = ParseCollisionMeshChunk(*it, collisionVertices, collisionTriangles, colError);
+        }
+    }
+    // All collision outputs come from the COLI chunk, so they share one manifest entry.
+    auto collisionSlot = trackTask("collision", collisionKey);
+    if (hasCollisionMesh)
+    {
+        if (!collisionSlot.UpToDate)
+        {
+            assetTasks.push_back({[&](std::string& taskError) {
+                if (!WriteCollisionObj(collisionPath, "collision", collisionVertices, collisionTriangles, options.ObjText))
+                    taskError = "Failed to write collision: " + collisionPath.string();
+            }, {}});
+        }
+        if (options.WriteGlb && !collisionSlot.UpToDate)
+        {
+            assetTasks.push_back({[&](std::string& taskError) {
+                std::vector<std::pair<std::string, std::span<const CollisionTriangle>>> types;
+                for (auto const& entry : collisionExports)
+                    types.emplace_back(entry.Name, entry.Triangles);
+                std::string glbError;
+                if (!WriteCollisionGlb(collisionGlbPath, collisionVertices, types, glbError))
+                    taskError = "Failed to write collision GLB: " + glbError;
+            }, {}});
+        }
+
+        std::map<std::pair<std::uint32_t, std::uint16_t>, std::vector<CollisionTriangle>> byType;
+        for (auto const& tri : collisionTriangles)
+            byType[{tri.SurfaceType, tri.Flags}].push_back(tri);
+
+        std::error_code dirEc;
+        std::filesystem::create_directories(collisionTypesDir, dirEc);
+        if (!dirEc)
+        {
+            collisionExports.reserve(byType.size());
+            for (auto& [key, tris] : byType)
+            {
+                const std::string surfaceHex = HexString(key.first, 8);
+                const std::string flagsHex = HexString(key.second, 4);
+                const std::string name = "collision_surface_" + surfaceHex + "_flags_" + flagsHex;
+                collisionExports.push_back({name, collisionTypesDir / (name + ".obj"), key.first, key.second,
+                                            std::move(tris), false});
+            }
+            for (auto& entry : collisionExports)
             {
-                if (!WriteCollisionObj(collisionPath, "collision", vertices, triangles))
+                if (collisionSlot.UpToDate)
                 {
-                    result.Error = "Failed to write collision: " + collisionPath.string();
-                    return result;
+                    entry.Written = std::filesystem::exists(entry.Path, dirEc);
+                    continue;
                 }
-
-                struct CollisionKey
-                {
-                    std::uint32_t Surface = 0;
-                    std::uint16_t Flags = 0;
-                };
-                struct CollisionKeyHash
-                {
-                    std::size_t operator()(CollisionKey const& k) const noexcept
-                    {
-                        return (static_cast<std::size_t>(k.Surface) << 16) ^ k.Flags;
-                    }
-                };
-                struct CollisionKeyEq
-                {
-                    bool operator()(CollisionKey const& a, CollisionKey const& b) const noexcept
+                assetTasks.push_back({[&](std::string&) {
+                    if (WriteCollisionObj(entry.Path, entry.Name, collisionVertices, entry.Triangles, options.ObjText))
                     {
-                        return a.Surface == b.Surface && a.Flags == b.Flags;
+                        WriteUnityModelMeta(entry.Path, StableGuidForPath(entry.Path));
+                        entry.Written = true;
                     }
-                };
+                }, {}});
+            }
+        }
+    }
+    else if (!collisionSlot.UpToDate)
+    {
+        // Still create the file so Unity has a stable reference.
+        std::ofstream obj(collisionPath, std::ios::binary | std::ios::trunc);
+        if (obj)
+            obj << "o collision\n";
+    }
 
-                std::unordered_map<CollisionKey, std::vector<CollisionTriangle>, CollisionKeyHash, CollisionKeyEq> byType;
-                byType.reserve(triangles.size());
-                for (auto const& tri : triangles)
+    // Textures referenced by branch materials are written once each, before any mesh needs their path.
+    // The store deduplicates by payload, so identical images reached through different resources or
+    // forests share one file; with SharedTextureDir that also holds across SIFs. Shared files are not
+    // tracked in the manifest since other exports may use them.
+    const bool sharedTextures = !options.SharedTextureDir.empty();
+    SeEditor::Export::TextureStore textureStore(sharedTextures ? options.SharedTextureDir : texturesRoot, sharedTextures);
+    std::unordered_map<const SeEditor::Forest::SuRenderTextureResource*, std::size_t> textureExportByResource;
+    {
+        auto collectMeshTextures = [&](const std::shared_ptr<SeEditor::Forest::SuRenderMesh>& mesh) {
+            if (!mesh)
+                return;
+            for (auto const& prim : mesh->Primitives)
+            {
+                if (!prim || !prim->Material)
+                    continue;
+                for (auto const& tex : prim->Material->Textures)
                 {
-                    CollisionKey key{tri.SurfaceType, tri.Flags};
-                    byType[key].push_back(tri);
+                    if (!tex || !tex->TextureResource || tex->TextureResource->ImageData.empty())
+                        continue;
+                    auto const* resource = tex->TextureResource.get();
+                    if (textureExportByResource.count(resource) != 0)
+                        continue;
+                    textureExportByResource.emplace(
+                        resource, textureStore.Intern(resource->ImageData, SanitizeName(resource->Name),
+                                                      TextureFileExtension(resource->ImageData)));
                 }
-
-                std::error_code dirEc;
-                std::filesystem::create_directories(collisionTypesDir, dirEc);
-                if (!dirEc)
+            }
+        };
+        for (auto const& forestLib : forests)
+        {
+            for (auto const& entry : forestLib.library->Forests)
+            {
+                if (!entry.Forest)
+                    continue;
+                for (auto const& tree : entry.Forest->Trees)
                 {
-                    for (auto const& [key, tris] : byType)
+                    if (!tree)
+                        continue;
+                    for (auto const& branch : tree->Branches)
                     {
-                        const std::string surfaceHex = HexString(key.Surface, 8);
-                        const std::string flagsHex = HexString(key.Flags, 4);
-                        const std::string name = "collision_surface_" + surfaceHex + "_flags_" + flagsHex;
-                        const std::filesystem::path outPath = collisionTypesDir / (name + ".obj");
-
-                        if (WriteCollisionObj(outPath, name, vertices, tris))
+                        if (!branch)
+                            continue;
+                        collectMeshTextures(branch->Mesh);
+                        if (branch->Lod)
                         {
-                            WriteUnityModelMeta(outPath, StableGuidForPath(outPath));
-                            collisionExports.push_back({name, outPath, key.Surface, key.Flags});
+                            for (auto const& th : branch->Lod->Thresholds)
+                                if (th)
+                                    collectMeshTextures(th->Mesh);
                         }
                     }
                 }
             }
-            else
+        }
+    }
+    struct TextureExportEntry
+    {
+        bool Written = false;
+        ManifestSlot Manifest;
+    };
+    std::vector<TextureExportEntry> textureExports(textureStore.Size());
+    for (std::size_t i = 0; i < textureExports.size(); ++i)
+    {
+        auto& entry = textureExports[i];
+        if (!sharedTextures)
+        {
+            // Keyed by content: a texture is rewritten only when its image bytes change.
+            entry.Manifest = trackTask("texture/" + textureStore.PathOf(i).lexically_relative(exportRoot).generic_string(),
+                                       textureStore.HashOf(i));
+            if (entry.Manifest.UpToDate)
             {
-                // Still create the file so Unity has a stable reference.
-                std::ofstream obj(collisionPath, std::ios::binary | std::ios::trunc);
-                if (obj)
-                    obj << "o collision\n";
+                entry.Written = true;
+                continue;
             }
         }
-        else
+        assetTasks.push_back({[&, i](std::string&) { textureExports[i].Written = textureStore.Write(i); }, {}});
+    }
+    result.UniqueTextures = textureStore.Stats().Unique;
+    result.DuplicateTextures = textureStore.Stats().Duplicates;
+    result.DuplicateTextureBytes = textureStore.Stats().DuplicateBytes;
+
+    if (!runTasks(assetTasks))
+        return result;
+    if (!collisionSlot.UpToDate)
+    {
+        addOutput(collisionSlot, collisionPath);
+        if (options.WriteGlb && hasCollisionMesh)
+            addOutput(collisionSlot, collisionGlbPath);
+        for (auto const& entry : collisionExports)
         {
-            std::ofstream obj(collisionPath, std::ios::binary | std::ios::trunc);
-            if (obj)
-                obj << "o collision\n";
+            if (entry.Written)
+                addOutput(collisionSlot, entry.Path);
         }
     }
+    for (std::size_t i = 0; i < textureExports.size(); ++i)
+    {
+        if (!sharedTextures && !textureExports[i].Manifest.UpToDate && textureExports[i].Written)
+            addOutput(textureExports[i].Manifest, textureStore.PathOf(i));
+    }
     // Stable GUID so scenes can reference the collision mesh if needed.
     WriteUnityModelMeta(collisionPath, StableGuidForPath(collisionPath));
 
-    std::ostringstream json;
-    json << "{\n";
-    json << "  \"sif\": \"" << JsonEscape(sifPath.filename().string()) << "\",\n";
-    json << "  \"collision\": \"" << JsonEscape(std::filesystem::relative(collisionPath, exportRoot).generic_string()) << "\",\n";
-    json << "  \"collisions\": [\n";
-    for (std::size_t i = 0; i < collisionExports.size(); ++i)
+    TexturePathMap texturePaths;
+    texturePaths.reserve(textureExportByResource.size());
+    for (auto const& [resource, index] : textureExportByResource)
     {
-        auto const& entry = collisionExports[i];
-        if (i > 0)
-            json << ",\n";
-        json << "    {\"name\": \"" << JsonEscape(entry.Name)
-             << "\", \"path\": \"" << JsonEscape(std::filesystem::relative(entry.Path, exportRoot).generic_string())
-             << "\", \"surface\": " << entry.Surface
-             << ", \"flags\": " << entry.Flags << "}";
+        if (textureExports[index].Written)
+            texturePaths.emplace(resource, textureStore.PathOf(index));
     }
-    json << "\n  ],\n";
-    json << "  \"waypoints\": \"" << JsonEscape(std::filesystem::relative(waypointsPath, exportRoot).generic_string()) << "\",\n";
-    json << "  \"raw\": {\n";
-    json << "    \"COLI\": \"" << JsonEscape(std::filesystem::relative(rawColiPath, exportRoot).generic_string()) << "\",\n";
-    json << "    \"TRAK\": \"" << JsonEscape(std::filesystem::relative(rawTrakPath, exportRoot).generic_string()) << "\"\n";
-    json << "  },\n";
-    json << "  \"forests\": [\n";
 
-    bool firstForestEntry = true;
+    // One task per tree: SuBranch json, per-branch obj/mtl and the tree prefab. The task's export.json
+    // fragment is spliced into the manifest in tree order.
+    struct TreeExportEntry
+    {
+        const SeEditor::Forest::SuRenderForest* Forest = nullptr;
+        const SeEditor::Forest::SuRenderTree* Tree = nullptr;
+        std::size_t TreeIdx = 0;
+        std::filesystem::path MeshDir;
+        std::filesystem::path SubbranchDir;
+        std::filesystem::path PrefabPath;
+        std::string Json;
+        ManifestSlot Manifest;
+    };
+    struct ForestExportEntry
+    {
+        std::string Name;
+        int Hash = 0;
+        std::size_t FirstTree = 0;
+        std::size_t TreeCount = 0;
+    };
+    std::vector<ForestExportEntry> forestExports;
+    std::vector<TreeExportEntry> treeExports;
+    // Forest names are not unique across chunks, and trees are written in parallel: later duplicates get a
+    // numbered directory so no two tasks share output files. Compared case-insensitively for Windows.
+    std::unordered_set<std::string> usedForestDirs;
     for (auto const& forestLib : forests)
     {
-        if (!forestLib.library)
-            continue;
         for (auto const& entry : forestLib.library->Forests)
         {
             if (!entry.Forest)
                 continue;
 
-            if (!firstForestEntry)
-                json << ",\n";
-            firstForestEntry = false;
-
             const std::string forestName = entry.Name.empty() ? ("forest_" + std::to_string(entry.Hash)) : entry.Name;
-            const std::filesystem::path forestMeshDir = meshesRoot / SanitizeName(forestName);
+            auto dirKey = [](std::string dir) {
+                for (char& c : dir)
+                    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                return dir;
+            };
+            const std::string baseDir = SanitizeName(forestName);
+            std::string forestDir = baseDir;
+            for (int dup = 1; !usedForestDirs.insert(dirKey(forestDir)).second; ++dup)
+                forestDir = baseDir + "_" + std::to_string(dup);
+            const std::filesystem::path forestMeshDir = meshesRoot / forestDir;
+            const std::filesystem::path forestSubbranchDir = subbranchRoot / forestDir;
+            const std::filesystem::path forestPrefabDir = prefabsRoot / forestDir;
             std::filesystem::create_directories(forestMeshDir, ec);
+            std::filesystem::create_directories(forestPrefabDir, ec);
 
-            json << "    {\n";
-            json << "      \"name\": \"" << JsonEscape(forestName) << "\",\n";
-            json << "      \"hash\": " << entry.Hash << ",\n";
-            json << "      \"trees\": [\n";
-
-            bool firstTree = true;
+            ForestExportEntry forestExport{forestName, entry.Hash, treeExports.size(), 0};
             for (std::size_t treeIdx = 0; treeIdx < entry.Forest->Trees.size(); ++treeIdx)
             {
                 auto const& tree = entry.Forest->Trees[treeIdx];
                 if (!tree)
                     continue;
+                TreeExportEntry treeExport;
+                treeExport.Forest = entry.Forest.get();
+                treeExport.Tree = tree.get();
+                treeExport.TreeIdx = treeIdx;
+                treeExport.MeshDir = forestMeshDir / ("Tree" + std::to_string(treeIdx));
+                treeExport.SubbranchDir = forestSubbranchDir / ("Tree" + std::to_string(treeIdx));
+                treeExport.PrefabPath = forestPrefabDir / ("Tree_" + std::to_string(treeIdx) + ".prefab");
+                const std::string manifestId =
+                    "tree/" + treeExport.MeshDir.lexically_relative(exportRoot).generic_string();
+                treeExport.Manifest =
+                    trackTask(manifestId, HashTreeTexturePaths(*tree, texturePaths,
+                                                               HashValue(treeIdx, HashValue(optionsKey, forestLib.key))));
+                treeExports.push_back(std::move(treeExport));
+                ++forestExport.TreeCount;
+            }
+            forestExports.push_back(std::move(forestExport));
+        }
+    }
 
-                if (!firstTree)
-                    json << ",\n";
-                firstTree = false;
-
-                const std::filesystem::path treeMeshDir = forestMeshDir / ("Tree" + std::to_string(treeIdx));
-                std::filesystem::create_directories(treeMeshDir, ec);
+    std::vector<ExportTask> treeTasks;
+    treeTasks.reserve(treeExports.size());
+    for (auto& treeExport : treeExports)
+    {
+        treeTasks.push_back({[&](std::string&) {
+            auto const& tree = *treeExport.Tree;
+            const std::size_t treeIdx = treeExport.TreeIdx;
+            const std::filesystem::path& treeMeshDir = treeExport.MeshDir;
+            // An up-to-date tree only rebuilds its export.json fragment from what is already on disk.
+            const bool upToDate = treeExport.Manifest.UpToDate;
+            std::error_code treeEc;
+            std::filesystem::create_directories(treeMeshDir / "SuBranches", treeEc);
+            std::filesystem::create_directories(treeExport.SubbranchDir, treeEc);
+
+            std::ostringstream json;
+            json << "        {\n";
+            json << "          \"index\": " << treeIdx << ",\n";
+            json << "          \"hash\": " << tree.Hash << ",\n";
+            // Tree-level combined mesh is no longer exported; the tree is composed from per-branch meshes.
+            json << "          \"mesh\": null,\n";
+            if (options.WriteGlb)
+            {
+                const std::filesystem::path glbPath = treeMeshDir / "tree.glb";
+                std::string glbError;
+                bool glbWritten = upToDate
+                                      ? std::filesystem::exists(glbPath, treeEc)
+                                      : ExportTreeToGlb(glbPath, "Tree_" + std::to_string(treeIdx), tree, texturePaths,
+                                                        options, glbError);
+                if (glbWritten && !upToDate)
+                    addOutput(treeExport.Manifest, glbPath);
+                if (glbWritten)
+                    json << "          \"glb\": \"" << JsonEscape(std::filesystem::relative(glbPath, exportRoot).generic_string())
+                         << "\",\n";
+                else
+                    json << "          \"glb\": null,\n";
+            }
+            else
+            {
+                json << "          \"glb\": null,\n";
+            }
+            json << "          \"branches\": [\n";
 
-                json << "        {\n";
-                json << "          \"index\": " << treeIdx << ",\n";
-                json << "          \"hash\": " << tree->Hash << ",\n";
-                // Tree-level combined mesh is no longer exported; the tree is composed from per-branch meshes.
-                json << "          \"mesh\": null,\n";
-                json << "          \"branches\": [\n";
+            bool firstBranch = true;
+            for (std::size_t branchIdx = 0; branchIdx < tree.Branches.size(); ++branchIdx)
+            {
+                auto const& branch = tree.Branches[branchIdx];
+                if (!branch)
+                    continue;
 
-                bool firstBranch = true;
-                for (std::size_t branchIdx = 0; branchIdx < tree->Branches.size(); ++branchIdx)
+                if (!firstBranch)
+                    json << ",\n";
+                firstBranch = false;
+
+                Vector4 t{};
+                Vector4 r{};
+                Vector4 s{1.0f, 1.0f, 1.0f, 1.0f};
+                if (branchIdx < tree.Translations.size())
+                    t = tree.Translations[branchIdx];
+                if (branchIdx < tree.Rotations.size())
+                    r = tree.Rotations[branchIdx];
+                if (branchIdx < tree.Scales.size())
+                    s = tree.Scales[branchIdx];
+
+                // Always dump a raw-ish branch file for repacking later.
+                const std::filesystem::path subPath =
+                    treeExport.SubbranchDir / ("branch_" + std::to_string(branchIdx) + ".subranch.json");
                 {
-                    auto const& branch = tree->Branches[branchIdx];
-                    if (!branch)
-                        continue;
-
-                    if (!firstBranch)
-                        json << ",\n";
-                    firstBranch = false;
-
-                    Vector4 t{};
-                    Vector4 r{};
-                    Vector4 s{1.0f, 1.0f, 1.0f, 1.0f};
-                    if (branchIdx < tree->Translations.size())
-                        t = tree->Translations[branchIdx];
-                    if (branchIdx < tree->Rotations.size())
-                        r = tree->Rotations[branchIdx];
-                    if (branchIdx < tree->Scales.size())
-                        s = tree->Scales[branchIdx];
-
-                    std::string branchDisplayName = branch->Name.empty() ? ("Branch_" + std::to_string(branchIdx)) : branch->Name;
-                    std::optional<std::string> meshRel;
-                    std::vector<std::string> lodMeshes;
-
-                    // Always dump a raw-ish branch file for repacking later.
-                    const std::filesystem::path subDir =
-                        subbranchRoot / SanitizeName(forestName) / ("Tree" + std::to_string(treeIdx));
-                    std::filesystem::create_directories(subDir, ec);
-                    const std::filesystem::path subPath = subDir / ("branch_" + std::to_string(branchIdx) + ".subranch.json");
+                    std::vector<int> children;
+                    int child = branch->Child;
+                    while (child >= 0 && static_cast<std::size_t>(child) < tree.Branches.size())
                     {
-                        std::vector<int> children;
-                        int child = branch->Child;
-                        while (child >= 0 && static_cast<std::size_t>(child) < tree->Branches.size())
-                        {
-                            children.push_back(child);
-                            auto const& cb = tree->Branches[static_cast<std::size_t>(child)];
-                            if (!cb)
-                                break;
-                            child = cb->Sibling;
-                        }
+                        children.push_back(child);
+                        auto const& cb = tree.Branches[static_cast<std::size_t>(child)];
+                        if (!cb)
+                            break;
+                        child = cb->Sibling;
+                    }
 
-                        std::ofstream sb(subPath, std::ios::binary | std::ios::trunc);
-                        if (sb)
+                    std::ofstream sb;
+                    if (!upToDate)
+                    {
+                        sb.open(subPath, std::ios::binary | std::ios::trunc);
+                        addOutput(treeExport.Manifest, subPath);
+                    }
+                    if (sb)
+                    {
+                        sb << "{\n";
+                        sb << "  \"index\": " << branchIdx << ",\n";
+                        sb << "  \"name\": \"" << JsonEscape(branch->Name) << "\",\n";
+                        sb << "  \"flags\": " << branch->Flags << ",\n";
+                        sb << "  \"parent\": " << branch->Parent << ",\n";
+                        sb << "  \"child\": " << branch->Child << ",\n";
+                        sb << "  \"sibling\": " << branch->Sibling << ",\n";
+                        sb << "  \"children\": [";
+                        for (std::size_t ci = 0; ci < children.size(); ++ci)
                         {
-                            sb << "{\n";
-                            sb << "  \"index\": " << branchIdx << ",\n";
-                            sb << "  \"name\": \"" << JsonEscape(branch->Name) << "\",\n";
-                            sb << "  \"flags\": " << branch->Flags << ",\n";
-                            sb << "  \"parent\": " << branch->Parent << ",\n";
-                            sb << "  \"child\": " << branch->Child << ",\n";
-                            sb << "  \"sibling\": " << branch->Sibling << ",\n";
-                            sb << "  \"children\": [";
-                            for (std::size_t ci = 0; ci < children.size(); ++ci)
-                            {
-                                if (ci > 0)
-                                    sb << ", ";
-                                sb << children[ci];
-                            }
-                            sb << "],\n";
-                            sb << "  \"t\": [" << t.X << ", " << t.Y << ", " << t.Z << "],\n";
-                            sb << "  \"r\": [" << r.X << ", " << r.Y << ", " << r.Z << ", " << r.W << "],\n";
-                            sb << "  \"s\": [" << s.X << ", " << s.Y << ", " << s.Z << "],\n";
-                            sb << "  \"mesh\": null,\n";
-                            sb << "  \"lodMeshes\": []\n";
-                            sb << "}\n";
+                            if (ci > 0)
+                                sb << ", ";
+                            sb << children[ci];
                         }
+                        sb << "],\n";
+                        sb << "  \"t\": [" << t.X << ", " << t.Y << ", " << t.Z << "],\n";
+                        sb << "  \"r\": [" << r.X << ", " << r.Y << ", " << r.Z << ", " << r.W << "],\n";
+                        sb << "  \"s\": [" << s.X << ", " << s.Y << ", " << s.Z << "],\n";
+                        sb << "  \"mesh\": null,\n";
+                        sb << "  \"lodMeshes\": []\n";
+                        sb << "}\n";
                     }
-                    const std::string subRel = std::filesystem::relative(subPath, exportRoot).generic_string();
+                }
+                const std::string subRel = std::filesystem::relative(subPath, exportRoot).generic_string();
 
-                    std::optional<std::string> exportedBranchMeshRel;
+                std::optional<std::string> exportedBranchMeshRel;
+                {
+                    const std::filesystem::path branchDir = treeMeshDir / "SuBranches";
+                    const std::filesystem::path brObj = branchDir / ("branch_" + std::to_string(branchIdx) + ".obj");
+                    const std::filesystem::path brMtl = branchDir / ("branch_" + std::to_string(branchIdx) + ".mtl");
+                    if (upToDate)
                     {
-                        const std::filesystem::path branchDir = treeMeshDir / "SuBranches";
-                        std::filesystem::create_directories(branchDir, ec);
-
-                        const std::filesystem::path brObj = branchDir / ("branch_" + std::to_string(branchIdx) + ".obj");
-                        const std::filesystem::path brMtl = branchDir / ("branch_" + std::to_string(branchIdx) + ".mtl");
-                        auto exp = ExportBranchToObjMtl(brObj, brMtl, texturesRoot, branch, *entry.Forest, ec);
+                        // Meshless branches leave an empty OBJ behind, so trust the manifest rather than the disk.
+                        auto const& outputs = treeExport.Manifest.Task->Outputs;
+                        const std::string brObjRel = brObj.lexically_relative(exportRoot).generic_string();
+                        if (std::any_of(outputs.begin(), outputs.end(),
+                                        [&](auto const& output) { return output.Path == brObjRel; }))
+                            exportedBranchMeshRel = std::filesystem::relative(brObj, exportRoot).generic_string();
+                    }
+                    else
+                    {
+                        auto exp = ExportBranchToObjMtl(brObj, brMtl, texturePaths, branch, treeEc, options);
                         if (exp.Success)
                         {
                             exportedBranchMeshRel = std::filesystem::relative(brObj, exportRoot).generic_string();
                             WriteUnityModelMeta(brObj, StableGuidForPath(brObj));
+                            addOutput(treeExport.Manifest, brObj);
+                            addOutput(treeExport.Manifest, brMtl);
                         }
                     }
+                }
+
+                json << "            {\n";
+                json << "              \"index\": " << branchIdx << ",\n";
+                json << "              \"name\": \"" << JsonEscape(branch->Name) << "\",\n";
+                json << "              \"parent\": " << branch->Parent << ",\n";
+                json << "              \"child\": " << branch->Child << ",\n";
+                json << "              \"sibling\": " << branch->Sibling << ",\n";
+                json << "              \"t\": [" << t.X << ", " << t.Y << ", " << t.Z << "],\n";
+                json << "              \"r\": [" << r.X << ", " << r.Y << ", " << r.Z << ", " << r.W << "],\n";
+                json << "              \"s\": [" << s.X << ", " << s.Y << ", " << s.Z << "],\n";
+                json << "              \"mesh\": " << (exportedBranchMeshRel ? ("\"" + JsonEscape(*exportedBranchMeshRel) + "\"") : "null") << ",\n";
+                json << "              \"subranch\": \"" << JsonEscape(subRel) << "\"";
+                json << "\n";
+                json << "            }";
+            }
+
+            json << "\n          ],\n";
+
+            json << "          \"collision\": null\n";
+            json << "        }";
+            treeExport.Json = json.str();
+            if (upToDate)
+                return;
 
-                    json << "            {\n";
-                    json << "              \"index\": " << branchIdx << ",\n";
-                    json << "              \"name\": \"" << JsonEscape(branch->Name) << "\",\n";
-                    json << "              \"parent\": " << branch->Parent << ",\n";
-                    json << "              \"child\": " << branch->Child << ",\n";
-                    json << "              \"sibling\": " << branch->Sibling << ",\n";
-                    json << "              \"t\": [" << t.X << ", " << t.Y << ", " << t.Z << "],\n";
-                    json << "              \"r\": [" << r.X << ", " << r.Y << ", " << r.Z << ", " << r.W << "],\n";
-                    json << "              \"s\": [" << s.X << ", " << s.Y << ", " << s.Z << "],\n";
-                    json << "              \"mesh\": " << (exportedBranchMeshRel ? ("\"" + JsonEscape(*exportedBranchMeshRel) + "\"") : "null") << ",\n";
-                    json << "              \"subranch\": \"" << JsonEscape(subRel) << "\"";
-                    json << "\n";
-                    json << "            }";
+            // Prefab containing the SuBranch hierarchy + meshes.
+            UnityPrefabWriter prefab;
+            int prefabRoot = prefab.AddNode("Tree_" + std::to_string(treeIdx), 0, {0, 0, 0, 0}, {0, 0, 0, 1}, {1, 1, 1, 1});
+            std::vector<int> branchTransformByIndex(tree.Branches.size(), 0);
+            for (std::size_t branchIdx = 0; branchIdx < tree.Branches.size(); ++branchIdx)
+            {
+                auto const& branch = tree.Branches[branchIdx];
+                if (!branch)
+                    continue;
+                Vector4 t{};
+                Vector4 r{};
+                Vector4 s{1.0f, 1.0f, 1.0f, 1.0f};
+                if (branchIdx < tree.Translations.size())
+                    t = tree.Translations[branchIdx];
+                if (branchIdx < tree.Rotations.size())
+                    r = tree.Rotations[branchIdx];
+                if (branchIdx < tree.Scales.size())
+                    s = tree.Scales[branchIdx];
+                const std::string name = branch->Name.empty() ? ("Branch_" + std::to_string(branchIdx)) : branch->Name;
+                int parentNode = prefabRoot;
+                if (branch->Parent >= 0 && static_cast<std::size_t>(branch->Parent) < branchTransformByIndex.size())
+                {
+                    int p = branchTransformByIndex[static_cast<std::size_t>(branch->Parent)];
+                    if (p != 0)
+                        parentNode = p;
                 }
+                int branchNode = prefab.AddNode(SanitizeName(name), parentNode, t, r, s);
+                branchTransformByIndex[branchIdx] = branchNode;
 
-                json << "\n          ],\n";
+                const std::filesystem::path brObj = treeMeshDir / "SuBranches" / ("branch_" + std::to_string(branchIdx) + ".obj");
+                if (std::filesystem::exists(brObj))
+                    prefab.AddMeshPrefabInstance(branchNode, "Mesh", StableGuidForPath(brObj));
+            }
 
-                json << "          \"collision\": null\n";
-                json << "        }";
+            if (prefab.WritePrefab(treeExport.PrefabPath))
+            {
+                WriteUnityNativeMeta(treeExport.PrefabPath, StableGuidForPath(treeExport.PrefabPath));
+                addOutput(treeExport.Manifest, treeExport.PrefabPath);
             }
+        }, {}});
+    }
+    if (!runTasks(treeTasks))
+        return result;
+
+    std::ostringstream json;
+    json << "{\n";
+    json << "  \"sif\": \"" << JsonEscape(sifPath.filename().string()) << "\",\n";
+    json << "  \"collision\": \"" << JsonEscape(std::filesystem::relative(collisionPath, exportRoot).generic_string()) << "\",\n";
+    json << "  \"collisionGlb\": ";
+    if (options.WriteGlb && hasCollisionMesh && std::filesystem::exists(collisionGlbPath))
+        json << "\"" << JsonEscape(std::filesystem::relative(collisionGlbPath, exportRoot).generic_string()) << "\",\n";
+    else
+        json << "null,\n";
+    json << "  \"collisions\": [\n";
+    bool firstCollision = true;
+    for (auto const& entry : collisionExports)
+    {
+        if (!entry.Written)
+            continue;
+        if (!firstCollision)
+            json << ",\n";
+        firstCollision = false;
+        json << "    {\"name\": \"" << JsonEscape(entry.Name)
+             << "\", \"path\": \"" << JsonEscape(std::filesystem::relative(entry.Path, exportRoot).generic_string())
+             << "\", \"surface\": " << entry.Surface
+             << ", \"flags\": " << entry.Flags << "}";
+    }
+    json << "\n  ],\n";
+    json << "  \"waypoints\": \"" << JsonEscape(std::filesystem::relative(waypointsPath, exportRoot).generic_string()) << "\",\n";
+    json << "  \"raw\": {\n";
+    json << "    \"COLI\": \"" << JsonEscape(std::filesystem::relative(rawColiPath, exportRoot).generic_string()) << "\",\n";
+    json << "    \"TRAK\": \"" << JsonEscape(std::filesystem::relative(rawTrakPath, exportRoot).generic_string()) << "\"\n";
+    json << "  },\n";
+    json << "  \"forests\": [\n";
+
+    for (std::size_t forestIdx = 0; forestIdx < forestExports.size(); ++forestIdx)
+    {
+        auto const& forestExport = forestExports[forestIdx];
+        if (forestIdx > 0)
+            json << ",\n";
 
-            json << "\n      ]\n";
-            json << "    }";
+        json << "    {\n";
+        json << "      \"name\": \"" << JsonEscape(forestExport.Name) << "\",\n";
+        json << "      \"hash\": " << forestExport.Hash << ",\n";
+        json << "      \"trees\": [\n";
+        for (std::size_t i = 0; i < forestExport.TreeCount; ++i)
+        {
+            if (i > 0)
+                json << ",\n";
+            json << treeExports[forestExport.FirstTree + i].Json;
         }
+        json << "\n      ]\n";
+        json << "    }";
     }
     json << "\n  ],\n";
 
@@ -2504,66 +3106,14 @@ ExportResult ExportSifToUnity(std::filesystem::path const& sifPath,
     // Build a Unity scene that instantiates one prefab per tree (prefab contains SuBranch hierarchy + meshes).
     UnitySceneWriter scene;
     int sceneRoot = scene.AddNode(SanitizeName(sifPath.stem().string()), 0, {0, 0, 0, 0}, {0, 0, 0, 1}, {1, 1, 1, 1});
-    for (auto const& forestLib : forests)
+    for (auto const& forestExport : forestExports)
     {
-        if (!forestLib.library)
-            continue;
-        for (auto const& entry : forestLib.library->Forests)
+        int forestNode = scene.AddNode(SanitizeName(forestExport.Name), sceneRoot, {0, 0, 0, 0}, {0, 0, 0, 1}, {1, 1, 1, 1});
+        for (std::size_t i = 0; i < forestExport.TreeCount; ++i)
         {
-            if (!entry.Forest)
-                continue;
-            const std::string forestName = entry.Name.empty() ? ("forest_" + std::to_string(entry.Hash)) : entry.Name;
-            int forestNode = scene.AddNode(SanitizeName(forestName), sceneRoot, {0, 0, 0, 0}, {0, 0, 0, 1}, {1, 1, 1, 1});
-            for (std::size_t treeIdx = 0; treeIdx < entry.Forest->Trees.size(); ++treeIdx)
-            {
-                auto const& tree = entry.Forest->Trees[treeIdx];
-                if (!tree)
-                    continue;
-
-                const std::filesystem::path forestMeshDir = meshesRoot / SanitizeName(forestName);
-                const std::filesystem::path treeMeshDir = forestMeshDir / ("Tree" + std::to_string(treeIdx));
-                const std::filesystem::path treePrefabDir = prefabsRoot / SanitizeName(forestName);
-                std::filesystem::create_directories(treePrefabDir, ec);
-                const std::filesystem::path treePrefabPath = treePrefabDir / ("Tree_" + std::to_string(treeIdx) + ".prefab");
-
-                UnityPrefabWriter prefab;
-                int prefabRoot = prefab.AddNode("Tree_" + std::to_string(treeIdx), 0, {0, 0, 0, 0}, {0, 0, 0, 1}, {1, 1, 1, 1});
-                std::vector<int> branchTransformByIndex(tree->Branches.size(), 0);
-                for (std::size_t branchIdx = 0; branchIdx < tree->Branches.size(); ++branchIdx)
-                {
-                    auto const& branch = tree->Branches[branchIdx];
-                    if (!branch)
-                        continue;
-                    Vector4 t{};
-                    Vector4 r{};
-                    Vector4 s{1.0f, 1.0f, 1.0f, 1.0f};
-                    if (branchIdx < tree->Translations.size())
-                        t = tree->Translations[branchIdx];
-                    if (branchIdx < tree->Rotations.size())
-                        r = tree->Rotations[branchIdx];
-                    if (branchIdx < tree->Scales.size())
-                        s = tree->Scales[branchIdx];
-                    const std::string name = branch->Name.empty() ? ("Branch_" + std::to_string(branchIdx)) : branch->Name;
-                    int parentNode = prefabRoot;
-                    if (branch->Parent >= 0 && static_cast<std::size_t>(branch->Parent) < branchTransformByIndex.size())
-                    {
-                        int p = branchTransformByIndex[static_cast<std::size_t>(branch->Parent)];
-                        if (p != 0)
-                            parentNode = p;
-                    }
-                    int branchNode = prefab.AddNode(SanitizeName(name), parentNode, t, r, s);
-                    branchTransformByIndex[branchIdx] = branchNode;
-
-                    const std::filesystem::path brObj = treeMeshDir / "SuBranches" / ("branch_" + std::to_string(branchIdx) + ".obj");
-                    if (std::filesystem::exists(brObj))
-                        prefab.AddMeshPrefabInstance(branchNode, "Mesh", StableGuidForPath(brObj));
-                }
-
-                if (prefab.WritePrefab(treePrefabPath))
-                    WriteUnityNativeMeta(treePrefabPath, StableGuidForPath(treePrefabPath));
-
-                scene.AddMeshPrefabInstance(forestNode, "Tree_" + std::to_string(treeIdx), StableGuidForPath(treePrefabPath));
-            }
+            auto const& treeExport = treeExports[forestExport.FirstTree + i];
+            scene.AddMeshPrefabInstance(forestNode, "Tree_" + std::to_string(treeExport.TreeIdx),
+                                        StableGuidForPath(treeExport.PrefabPath));
         }
     }
     if (!scene.Write(scenePath))
@@ -2572,6 +3122,19 @@ ExportResult ExportSifToUnity(std::filesystem::path const& sifPath,
         return result;
     }
 
+    auto& exportTask = manifest.Tasks["export"];
+    exportTask.Key = sourceKey;
+    SeEditor::Export::AddManifestOutput(exportTask.Outputs, exportRoot, jsonPath);
+    SeEditor::Export::AddManifestOutput(exportTask.Outputs, exportRoot, scenePath);
+    manifest.HashOutputs(exportRoot, threadCount);
+    if (options.Incremental)
+        result.RemovedOrphans = SeEditor::Export::RemoveOrphanedOutputs(previousManifest, manifest, exportRoot);
+    if (!manifest.Save(manifestPath))
+    {
+        result.Error = "Failed to write " + manifestPath.string();
+        return result;
+    }
+
     result.Success = true;
     result.ExportJsonPath = jsonPath;
     result.ScenePath = scenePath;
@@ -1,8 +1,17 @@
 #pragma once
 
+#include "SeEditor/Export/MeshOptimizer.hpp"
+#include "SeEditor/Export/TextMeshWriter.hpp"
+
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <string>
 
+namespace SlLib::Filesystem {
+class IFileSystem;
+} // namespace SlLib::Filesystem
+
 namespace SeEditor::UnityExport {
 
 struct ExportResult
@@ -11,6 +20,41 @@ struct ExportResult
     std::filesystem::path ExportJsonPath{};
     std::filesystem::path ScenePath{};
     std::string Error;
+
+    // Incremental exports only: tasks whose manifest entry was still current, stale outputs deleted, and
+    // whether the whole export was already up to date (nothing parsed or written).
+    std::size_t SkippedTasks = 0;
+    std::size_t RemovedOrphans = 0;
+    bool UpToDate = false;
+
+    // Texture payloads written (or reused), and references that resolved to an identical payload.
+    std::size_t UniqueTextures = 0;
+    std::size_t DuplicateTextures = 0;
+    std::uint64_t DuplicateTextureBytes = 0;
+};
+
+struct ExportOptions
+{
+    // Applied to every submesh before it is written to OBJ.
+    SeEditor::Export::MeshOptimizeOptions MeshOptimization{};
+    // Float formatting for OBJ output (shortest round-trip by default).
+    SeEditor::Export::TextFormatOptions ObjText{};
+    // Also write each tree as Meshes/<forest>/Tree_N/tree.glb (hierarchy, LODs and skins) and collision.glb.
+    bool WriteGlb = false;
+    // Reuse outputs recorded in <export>/export.manifest whose input hashes are unchanged and delete outputs
+    // the previous run produced that this run no longer does. The manifest is written on every run.
+    bool Incremental = false;
+    // When set, textures go to this directory named by content hash instead of <export>/Textures, so
+    // several exports share one copy of each image. Must be inside the Unity project's Assets folder.
+    std::filesystem::path SharedTextureDir{};
+
+    // Worker threads for the per-asset export tasks; 0 = one per hardware thread. Output is identical for
+    // any value.
+    std::size_t ThreadCount = 0;
+
+    // When set, the SIF and its GPU data are read through this filesystem (e.g. an XpacFileSystem over a
+    // shipped archive) instead of from disk, and `sifPath` is a path inside it.
+    SlLib::Filesystem::IFileSystem* SourceFileSystem = nullptr;
 };
 
 // Exports SIF forests (per-branch meshes), collision and logic manifest.
@@ -20,7 +64,8 @@ struct ExportResult
 //
 // Writes to: <UnityProject>/Assets/<SIFNAME>_SIF/* (Meshes/, Textures/, Prefabs/, collision.obj, <SIFNAME>.unity, export.json).
 ExportResult ExportSifToUnity(std::filesystem::path const& sifPath,
-                             std::filesystem::path const& unityProjectRoot);
+                             std::filesystem::path const& unityProjectRoot,
+                             ExportOptions const& options = {});
 
 // Finds the repo's Unity project root by walking upwards and checking for a Unity/ folder.
 // Returns empty path if not found.
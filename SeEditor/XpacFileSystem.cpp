@@ -0,0 +1,217 @@
+#include "XpacFileSystem.hpp"
+
+#include "XpacMappingTable.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+
+namespace SeEditor::Xpac {
+
+namespace {
+
+std::string ToHashName(std::uint32_t hash)
+{
+    static constexpr char kDigits[] = "0123456789ABCDEF";
+    std::string name = "hash_00000000";
+    for (int i = 0; i < 8; ++i)
+        name[5 + i] = kDigits[(hash >> (28 - i * 4)) & 0xF];
+    return name;
+}
+
+// "hash_XXXXXXXX" or "hash_XXXXXXXX.ext", as written by the unpacker for unnamed entries.
+bool ParseHashName(std::string_view path, std::uint32_t& hash)
+{
+    const std::size_t slash = path.find_last_of("/\\");
+    if (slash != std::string_view::npos)
+        path.remove_prefix(slash + 1);
+    if (!path.starts_with("hash_") || path.size() < 13)
+        return false;
+    if (path.size() > 13 && path[13] != '.')
+        return false;
+    auto res = std::from_chars(path.data() + 5, path.data() + 13, hash, 16);
+    return res.ec == std::errc{} && res.ptr == path.data() + 13;
+}
+
+bool HasExtension(std::string_view path, std::string_view extension)
+{
+    if (path.size() < extension.size())
+        return false;
+    std::string_view tail = path.substr(path.size() - extension.size());
+    return std::equal(tail.begin(), tail.end(), extension.begin(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == b;
+    });
+}
+
+} // namespace
+
+XpacFileSystem::XpacFileSystem(std::filesystem::path archivePath, std::size_t cacheBytes)
+    : _path(std::move(archivePath)), _cacheLimit(cacheBytes)
+{
+    std::string error;
+    if (!_archive.Open(_path, error, MappedFile::AccessHint::Random))
+        throw std::runtime_error("Failed to open XPAC archive: " + error);
+    if (!ReadXpacEntryTable(_archive.Bytes(), _entries, error))
+        throw std::runtime_error(error + " (" + _path.string() + ")");
+
+    _byHash.reserve(_entries.size());
+    for (std::size_t i = 0; i < _entries.size(); ++i)
+        _byHash.emplace(_entries[i].Hash, i);
+}
+
+std::uint32_t XpacFileSystem::HashPath(std::string_view path)
+{
+    // Same scheme as SsrPackFile: ".\" + upper-case path with backslashes, hashed back to front.
+    if (path.starts_with(".\\") || path.starts_with("./"))
+        path.remove_prefix(2);
+    std::uint32_t hash = 0;
+    for (auto it = path.rbegin(); it != path.rend(); ++it)
+    {
+        char c = *it == '/' ? '\\' : *it;
+        hash = hash * 0x83u + static_cast<unsigned char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    hash = hash * 0x83u + static_cast<unsigned char>('\\');
+    hash = hash * 0x83u + static_cast<unsigned char>('.');
+    return hash;
+}
+
+XpacEntry const* XpacFileSystem::FindEntry(std::uint32_t hash) const
+{
+    auto it = _byHash.find(hash);
+    return it != _byHash.end() ? &_entries[it->second] : nullptr;
+}
+
+XpacFileSystem::Resolved XpacFileSystem::Resolve(std::string const& path) const
+{
+    std::uint32_t hash = 0;
+    if (ParseHashName(path, hash))
+        return {FindEntry(hash), false};
+
+    if (XpacEntry const* entry = FindEntry(HashPath(path)))
+        return {entry, false};
+
+    const bool isSif = HasExtension(path, ".sif");
+    if (isSif || HasExtension(path, ".sig"))
+    {
+        std::string stored = path.substr(0, path.size() - 4) + (isSif ? ".zif" : ".zig");
+        if (XpacEntry const* entry = FindEntry(HashPath(stored)))
+            return {entry, true};
+    }
+    return {};
+}
+
+bool XpacFileSystem::DoesFileExist(std::string const& path) const
+{
+    return Resolve(path).Entry != nullptr;
+}
+
+std::shared_ptr<const std::vector<std::uint8_t>> XpacFileSystem::GetFileShared(std::string const& path)
+{
+    const Resolved resolved = Resolve(path);
+    if (!resolved.Entry)
+        return nullptr;
+
+    // Raw and decoded forms of one entry are cached separately.
+    const std::uint64_t key = (static_cast<std::uint64_t>(resolved.Entry->Hash) << 1) | (resolved.DecodeZif ? 1 : 0);
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        auto it = _cache.find(key);
+        if (it != _cache.end())
+        {
+            ++_stats.Hits;
+            _lru.splice(_lru.begin(), _lru, it->second.LruPosition);
+            return it->second.Data;
+        }
+        ++_stats.Misses;
+    }
+
+    // Inflate outside the lock so readers of other entries are not held up. Two threads missing on the same
+    // entry both decode it; the second insert just refreshes the slot.
+    std::string error;
+    std::vector<std::uint8_t> payload;
+    if (!ReadXpacEntry(_archive.Bytes(), *resolved.Entry, payload, error))
+        throw std::runtime_error("XpacFileSystem failed to read " + path + ": " + error);
+    if (resolved.DecodeZif)
+    {
+        std::vector<std::uint8_t> decoded;
+        if (!DecodeZifZig(payload, decoded, error))
+            throw std::runtime_error("XpacFileSystem failed to decode " + path + ": " + error);
+        payload = std::move(decoded);
+    }
+
+    auto data = std::make_shared<const std::vector<std::uint8_t>>(std::move(payload));
+    Insert(key, data);
+    return data;
+}
+
+void XpacFileSystem::Insert(std::uint64_t key, std::shared_ptr<const std::vector<std::uint8_t>> const& data)
+{
+    // Entries larger than the whole budget are handed out but not cached.
+    if (data->size() > _cacheLimit)
+        return;
+
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    auto it = _cache.find(key);
+    if (it != _cache.end())
+    {
+        _stats.CachedBytes -= it->second.Data->size();
+        _lru.erase(it->second.LruPosition);
+        _cache.erase(it);
+    }
+
+    while (!_lru.empty() && _stats.CachedBytes + data->size() > _cacheLimit)
+    {
+        auto victim = _cache.find(_lru.back());
+        _stats.CachedBytes -= victim->second.Data->size();
+        _cache.erase(victim);
+        _lru.pop_back();
+        ++_stats.Evictions;
+    }
+
+    _lru.push_front(key);
+    _cache.emplace(key, CacheSlot{data, _lru.begin()});
+    _stats.CachedBytes += data->size();
+}
+
+std::vector<std::uint8_t> XpacFileSystem::GetFile(std::string const& path)
+{
+    auto data = GetFileShared(path);
+    if (!data)
+        throw std::runtime_error("XpacFileSystem entry not found: " + path);
+    return *data;
+}
+
+std::pair<std::unique_ptr<std::istream>, std::size_t> XpacFileSystem::GetFileStream(std::string const& path)
+{
+    auto data = GetFileShared(path);
+    if (!data)
+        throw std::runtime_error("XpacFileSystem entry not found: " + path);
+    auto stream = std::make_unique<std::stringstream>(std::ios::in | std::ios::out | std::ios::binary);
+    stream->write(reinterpret_cast<const char*>(data->data()), static_cast<std::streamsize>(data->size()));
+    stream->seekg(0, std::ios::beg);
+    return {std::move(stream), data->size()};
+}
+
+std::vector<std::string> XpacFileSystem::ListFiles() const
+{
+    std::vector<std::string> names;
+    names.reserve(_entries.size());
+    for (XpacEntry const& entry : _entries)
+    {
+        std::string_view name = FindEmbeddedMappedName(entry.Hash);
+        if (name.starts_with(".\\") || name.starts_with("./"))
+            name.remove_prefix(2);
+        names.push_back(name.empty() ? ToHashName(entry.Hash) : std::string(name));
+    }
+    return names;
+}
+
+XpacCacheStats XpacFileSystem::CacheStats() const
+{
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    return _stats;
+}
+
+} // namespace SeEditor::Xpac
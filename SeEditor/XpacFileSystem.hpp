@@ -0,0 +1,87 @@
+#pragma once
+
+#include "MappedFile.hpp"
+#include "XpacUnpacker.hpp"
+#include "SlLib/Filesystem/IFileSystem.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SeEditor::Xpac {
+
+struct XpacCacheStats
+{
+    std::size_t Hits = 0;
+    std::size_t Misses = 0;
+    std::size_t Evictions = 0;
+    std::size_t CachedBytes = 0;
+};
+
+// Read-only IFileSystem over a shipped XPAC archive. Nothing is extracted: the archive is memory-mapped,
+// entries are found by the game's filename hash and inflated on demand, and recently used payloads are
+// kept in a size-bounded LRU cache. Safe for concurrent reads from any number of threads.
+//
+// Paths are game paths ("Resource/Tracks/.../Foo.zif", with or without a leading ".\"), or "hash_XXXXXXXX"
+// (any extension) for entries without a known name. Asking for a .sif/.sig that the archive only holds as
+// .zif/.zig returns the decoded SIF/SIG.
+class XpacFileSystem final : public SlLib::Filesystem::IFileSystem
+{
+public:
+    static constexpr std::size_t kDefaultCacheBytes = std::size_t{256} << 20;
+
+    // Throws std::runtime_error when the archive cannot be opened or its entry table is damaged.
+    explicit XpacFileSystem(std::filesystem::path archivePath, std::size_t cacheBytes = kDefaultCacheBytes);
+
+    bool DoesFileExist(std::string const& path) const override;
+    std::vector<std::uint8_t> GetFile(std::string const& path) override;
+    std::pair<std::unique_ptr<std::istream>, std::size_t> GetFileStream(std::string const& path) override;
+
+    // Same bytes as GetFile without copying them out of the cache; nullptr when the path is not in the
+    // archive.
+    std::shared_ptr<const std::vector<std::uint8_t>> GetFileShared(std::string const& path);
+
+    // Names of all entries: the embedded mapping's name where there is one, "hash_XXXXXXXX" otherwise.
+    std::vector<std::string> ListFiles() const;
+    std::vector<XpacEntry> const& Entries() const { return _entries; }
+    XpacCacheStats CacheStats() const;
+
+    // The game's filename hash of a path (case-insensitive, either slash).
+    static std::uint32_t HashPath(std::string_view path);
+
+private:
+    struct Resolved
+    {
+        XpacEntry const* Entry = nullptr;
+        bool DecodeZif = false; // .sif/.sig requested, .zif/.zig stored
+    };
+    struct CacheSlot
+    {
+        std::shared_ptr<const std::vector<std::uint8_t>> Data;
+        std::list<std::uint64_t>::iterator LruPosition;
+    };
+
+    Resolved Resolve(std::string const& path) const;
+    XpacEntry const* FindEntry(std::uint32_t hash) const;
+    void Insert(std::uint64_t key, std::shared_ptr<const std::vector<std::uint8_t>> const& data);
+
+    std::filesystem::path _path;
+    MappedFile _archive;
+    std::vector<XpacEntry> _entries;
+    std::unordered_map<std::uint32_t, std::size_t> _byHash;
+
+    mutable std::mutex _cacheMutex;
+    std::size_t _cacheLimit = 0;
+    std::list<std::uint64_t> _lru; // most recently used first
+    std::unordered_map<std::uint64_t, CacheSlot> _cache;
+    XpacCacheStats _stats;
+};
+
+} // namespace SeEditor::Xpac
@@ -0,0 +1,40 @@
+#include "XpacMappingTable.hpp"
+
+namespace SeEditor::Xpac {
+
+#if defined(SEEDITOR_EMBED_MAPPING)
+
+namespace {
+#include "EmbeddedMappingTable.hpp"
+} // namespace
+
+std::string_view FindEmbeddedMappedName(std::uint32_t hash)
+{
+    const std::uint32_t bucket = MappingSlotHash(hash, 0) % kMappingBucketCount;
+    const std::uint32_t slot = MappingSlotHash(hash, kMappingSeeds[bucket]) % kMappingSlotCount;
+    if (kMappingKeys[slot] != hash)
+        return {};
+    const std::uint32_t begin = kMappingOffsets[slot];
+    return std::string_view(kMappingNames + begin, kMappingOffsets[slot + 1] - begin);
+}
+
+std::size_t EmbeddedMappingSize()
+{
+    return kMappingEntryCount;
+}
+
+#else
+
+std::string_view FindEmbeddedMappedName(std::uint32_t)
+{
+    return {};
+}
+
+std::size_t EmbeddedMappingSize()
+{
+    return 0;
+}
+
+#endif
+
+} // namespace SeEditor::Xpac
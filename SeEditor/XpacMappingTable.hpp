@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace SeEditor::Xpac {
+
+// Slot hash shared by the build-time table generator and the runtime lookup. Seed 0 picks the bucket;
+// the bucket's stored seed picks the slot.
+constexpr std::uint32_t MappingSlotHash(std::uint32_t key, std::uint32_t seed)
+{
+    std::uint32_t h = key ^ (seed * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// Name for an XPAC filename hash from the MAPPING.GC compiled into the binary (a minimal perfect hash
+// built at configure time, so nothing is parsed at startup). Empty when the hash is unknown or the build
+// had no mapping.
+std::string_view FindEmbeddedMappedName(std::uint32_t hash);
+std::size_t EmbeddedMappingSize();
+
+} // namespace SeEditor::Xpac
@@ -1,5 +1,10 @@
 #include "XpacUnpacker.hpp"
 
+#include "BoundedQueue.hpp"
+#include "MappedFile.hpp"
+#include "ParallelDeflate.hpp"
+#include "XpacMappingTable.hpp"
+
 #include <algorithm>
 #include <array>
 #include <cctype>
@@ -8,10 +13,8 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <condition_variable>
 #include <mutex>
 #include <optional>
-#include <queue>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -29,10 +32,6 @@ namespace SeEditor::Xpac {
 
 namespace {
 
-#if defined(SEEDITOR_EMBED_MAPPING)
-#include "EmbeddedMapping.hpp"
-#endif
-
 constexpr std::uint32_t MakeTypeCode(char a, char b, char c, char d)
 {
     return static_cast<std::uint32_t>(static_cast<unsigned char>(a)) |
@@ -191,6 +190,15 @@ std::unordered_map<std::uint32_t, std::string> LoadMapping(std::filesystem::path
     return LoadMappingFromText(contents);
 }
 
+// A mapping file (passed in or found next to the archive) replaces the table compiled into the binary.
+std::string_view FindMappedName(std::unordered_map<std::uint32_t, std::string> const& mapping, std::uint32_t hash)
+{
+    if (mapping.empty())
+        return FindEmbeddedMappedName(hash);
+    auto it = mapping.find(hash);
+    return it != mapping.end() ? std::string_view(it->second) : std::string_view();
+}
+
 std::filesystem::path CleanMappingPath(std::string value)
 {
     for (char& ch : value)
@@ -259,7 +267,7 @@ bool WriteFile(std::filesystem::path const& path, std::span<const std::uint8_t>
     }
 }
 
-bool DecodeZifZig(std::span<const std::uint8_t> data, std::vector<std::uint8_t>& out, std::string& error)
+bool DecodeZifZigImpl(std::span<const std::uint8_t> data, std::vector<std::uint8_t>& out, std::string& error)
 {
     if (data.empty())
     {
@@ -302,7 +310,10 @@ bool DecodeZifZig(std::span<const std::uint8_t> data, std::vector<std::uint8_t>&
     return true;
 }
 
-bool EncodeZifZigImpl(std::span<const std::uint8_t> raw, std::vector<std::uint8_t>& out, std::string& error)
+bool EncodeZifZigImpl(std::span<const std::uint8_t> raw,
+                      std::vector<std::uint8_t>& out,
+                      std::string& error,
+                      ZlibCompressOptions const& compression)
 {
     if (raw.empty())
     {
@@ -330,70 +341,20 @@ bool EncodeZifZigImpl(std::span<const std::uint8_t> raw, std::vector<std::uint8_
         std::memcpy(payload.data() + 4, raw.data(), raw.size());
     }
 
-    z_stream stream{};
-    stream.next_in = payload.data();
-    stream.avail_in = static_cast<decltype(stream.avail_in)>(payload.size());
-
-    constexpr int level = 9;
-    constexpr int wbits = 15;
-    constexpr int memLevel = 8;
-    constexpr int strategy = Z_DEFAULT_STRATEGY;
-    if (deflateInit2(&stream, level, Z_DEFLATED, wbits, memLevel, strategy) != Z_OK)
+    if (!CompressZlibStream(payload, out, compression, error))
     {
-        error = "Failed to init zlib deflater.";
+        error = "XPAC compression failed: " + error;
         return false;
     }
-
-    out.clear();
-    std::vector<std::uint8_t> buffer(1 << 14);
-    int status = Z_OK;
-    while (status == Z_OK)
-    {
-        stream.next_out = buffer.data();
-        stream.avail_out = static_cast<decltype(stream.avail_out)>(buffer.size());
-        status = deflate(&stream, Z_FINISH);
-        if (status != Z_OK && status != Z_STREAM_END)
-        {
-            deflateEnd(&stream);
-            error = "XPAC compression failed.";
-            return false;
-        }
-        std::size_t have = buffer.size() - stream.avail_out;
-        out.insert(out.end(), buffer.begin(), buffer.begin() + have);
-    }
-
-    deflateEnd(&stream);
     return true;
 }
 
-std::vector<std::uint8_t> CompressZlib(std::span<const std::uint8_t> input)
+std::vector<std::uint8_t> CompressZlib(std::span<const std::uint8_t> input, ZlibCompressOptions const& compression)
 {
-    z_stream stream{};
-    stream.next_in = const_cast<std::uint8_t*>(input.data());
-    stream.avail_in = static_cast<decltype(stream.avail_in)>(input.size());
-
-    if (deflateInit(&stream, Z_BEST_COMPRESSION) != Z_OK)
-        throw std::runtime_error("Failed to init zlib deflater.");
-
     std::vector<std::uint8_t> output;
-    std::vector<std::uint8_t> buffer(1 << 14);
-
-    int status = Z_OK;
-    while (status == Z_OK)
-    {
-        stream.next_out = buffer.data();
-        stream.avail_out = static_cast<decltype(stream.avail_out)>(buffer.size());
-        status = deflate(&stream, Z_FINISH);
-        if (status != Z_OK && status != Z_STREAM_END)
-        {
-            deflateEnd(&stream);
-            throw std::runtime_error("XPAC compression failed.");
-        }
-        std::size_t have = buffer.size() - stream.avail_out;
-        output.insert(output.end(), buffer.begin(), buffer.begin() + have);
-    }
-
-    deflateEnd(&stream);
+    std::string error;
+    if (!CompressZlibStream(input, output, compression, error))
+        throw std::runtime_error("XPAC compression failed.");
     return output;
 }
 
@@ -442,9 +403,84 @@ UnknownDecodeResult DecodeUnknownPayload(std::vector<std::uint8_t> const& payloa
 
 } // namespace
 
-bool EncodeZifZig(std::span<const std::uint8_t> raw, std::vector<std::uint8_t>& out, std::string& error)
+bool EncodeZifZig(std::span<const std::uint8_t> raw,
+                  std::vector<std::uint8_t>& out,
+                  std::string& error,
+                  ZlibCompressOptions const& compression)
+{
+    return EncodeZifZigImpl(raw, out, error, compression);
+}
+
+bool DecodeZifZig(std::span<const std::uint8_t> data, std::vector<std::uint8_t>& out, std::string& error)
+{
+    try
+    {
+        return DecodeZifZigImpl(data, out, error);
+    }
+    catch (std::exception const& ex)
+    {
+        error = ex.what();
+        return false;
+    }
+}
+
+bool ReadXpacEntryTable(std::span<const std::uint8_t> archive, std::vector<XpacEntry>& entries, std::string& error)
 {
-    return EncodeZifZigImpl(raw, out, error);
+    constexpr std::size_t kHeaderSize = 24;
+    if (archive.size() < kHeaderSize)
+    {
+        error = "XPAC file is too small.";
+        return false;
+    }
+    const std::uint32_t totalFiles = ReadU32LE(archive, 12);
+    const std::uint64_t tableEnd = kHeaderSize + static_cast<std::uint64_t>(totalFiles) * 20;
+    if (tableEnd > archive.size())
+    {
+        error = "XPAC entry table out of bounds.";
+        return false;
+    }
+
+    entries.clear();
+    entries.reserve(totalFiles);
+    for (std::uint32_t i = 0; i < totalFiles; ++i)
+    {
+        const std::size_t entryOff = kHeaderSize + static_cast<std::size_t>(i) * 20;
+        XpacEntry entry;
+        entry.Hash = ReadU32LE(archive, entryOff + 0);
+        entry.Offset = ReadU32LE(archive, entryOff + 4);
+        entry.Size = ReadU32LE(archive, entryOff + 8);
+        entry.CompressedSize = ReadU32LE(archive, entryOff + 12);
+        entry.Flags = ReadU32LE(archive, entryOff + 16);
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+bool ReadXpacEntry(std::span<const std::uint8_t> archive,
+                   XpacEntry const& entry,
+                   std::vector<std::uint8_t>& out,
+                   std::string& error)
+{
+    const std::uint64_t endOffset = static_cast<std::uint64_t>(entry.Offset) + entry.CompressedSize;
+    if (endOffset > archive.size())
+    {
+        error = "Entry out of bounds for hash " + HashHex(entry.Hash);
+        return false;
+    }
+    const std::span<const std::uint8_t> stored = archive.subspan(entry.Offset, entry.CompressedSize);
+    try
+    {
+        if (entry.CompressedSize != entry.Size)
+            out = DecompressZlib(stored, entry.Size);
+        else
+            out.assign(stored.begin(), stored.end());
+    }
+    catch (std::exception const& ex)
+    {
+        error = "Decompression failed for hash " + HashHex(entry.Hash) + ": " + ex.what();
+        return false;
+    }
+    return true;
 }
 
 std::optional<std::filesystem::path> FindDefaultMappingPath(std::filesystem::path const& xpacPath,
@@ -503,64 +539,32 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
     std::unordered_map<std::uint32_t, std::string> mapping;
     if (mappingPath)
         mapping = LoadMapping(*mappingPath);
-#if defined(SEEDITOR_EMBED_MAPPING)
-    if (mapping.empty() && kEmbeddedMappingSize > 0)
-    {
-        mapping = LoadMappingFromText(
-            std::string_view(reinterpret_cast<char const*>(kEmbeddedMapping), kEmbeddedMappingSize));
-    }
-#endif
 
-    std::ifstream file(options.XpacPath, std::ios::binary);
-    if (!file)
+    // Entries are decompressed straight out of the mapped archive, so only the pages a worker is reading
+    // are resident instead of a full heap copy of the XPAC.
+    MappedFile xpacFile;
+    std::string openError;
+    if (!xpacFile.Open(options.XpacPath, openError, MappedFile::AccessHint::Sequential))
     {
-        result.Errors.push_back("Unable to open XPAC file: " + options.XpacPath.string());
+        result.Errors.push_back("Unable to open XPAC file: " + options.XpacPath.string() + " (" + openError + ")");
         return result;
     }
-
-    file.seekg(0, std::ios::end);
-    std::uint64_t fileSize = static_cast<std::uint64_t>(file.tellg());
-    file.seekg(0, std::ios::beg);
-
-    std::vector<std::uint8_t> xpacBytes(static_cast<std::size_t>(fileSize));
-    if (fileSize == 0 || !file.read(reinterpret_cast<char*>(xpacBytes.data()), static_cast<std::streamsize>(xpacBytes.size())))
+    const std::span<const std::uint8_t> xpacBytes = xpacFile.Bytes();
+    const std::uint64_t fileSize = xpacBytes.size();
+    if (fileSize == 0)
     {
         result.Errors.push_back("Failed to read XPAC file bytes.");
         return result;
     }
 
-    std::array<std::uint8_t, 24> header{};
-    if (xpacBytes.size() < header.size())
-    {
-        result.Errors.push_back("XPAC file is too small.");
-        return result;
-    }
-    std::memcpy(header.data(), xpacBytes.data(), header.size());
-
-    std::uint32_t totalFiles = ReadU32LE(header, 12);
-    result.TotalEntries = totalFiles;
-
-    std::size_t tableOffset = header.size();
-    std::size_t tableSize = static_cast<std::size_t>(totalFiles) * 20;
-    if (tableOffset + tableSize > xpacBytes.size())
-    {
-        result.Errors.push_back("XPAC entry table out of bounds.");
-        return result;
-    }
-
     std::vector<XpacEntry> entries;
-    entries.reserve(totalFiles);
-    for (std::uint32_t i = 0; i < totalFiles; ++i)
+    std::string tableError;
+    if (!ReadXpacEntryTable(xpacBytes, entries, tableError))
     {
-        std::size_t entryOff = tableOffset + static_cast<std::size_t>(i) * 20;
-        XpacEntry entry;
-        entry.Hash = ReadU32LE(xpacBytes, entryOff + 0);
-        entry.Offset = ReadU32LE(xpacBytes, entryOff + 4);
-        entry.Size = ReadU32LE(xpacBytes, entryOff + 8);
-        entry.CompressedSize = ReadU32LE(xpacBytes, entryOff + 12);
-        entry.Flags = ReadU32LE(xpacBytes, entryOff + 16);
-        entries.push_back(entry);
+        result.Errors.push_back(tableError);
+        return result;
     }
+    result.TotalEntries = entries.size();
 
     std::filesystem::path xpacBase = options.XpacPath.stem();
     std::filesystem::path xpacRoot = outputRoot / "xpac" / xpacBase;
@@ -580,6 +584,8 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
     {
         std::filesystem::path Zif;
         std::filesystem::path Zig;
+        bool SifWritten = false;
+        bool SigWritten = false;
     };
     std::unordered_map<std::string, PairPaths> pairMap;
     std::mutex pairMutex;
@@ -590,6 +596,8 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
     std::atomic<std::size_t> skipped{0};
     std::atomic<std::size_t> extractedZif{0};
     std::atomic<std::size_t> extractedZig{0};
+    std::atomic<std::size_t> convertedPairs{0};
+    const bool convertInWorkers = options.ConvertToSifSig && options.ConvertMode == XpacConvertMode::InWorkers;
 
     struct WriteTask
     {
@@ -598,14 +606,14 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
         std::vector<std::uint8_t> Data;
         bool IsMainOutput = false;
         bool IsPairCandidate = false;
+        bool IsConverted = false; // decoded .sif/.sig written by the worker; Extension is the source's
+        bool Stop = false;        // tells one writer thread to exit
         std::string PairBase;
         std::string Extension;
     };
 
-    std::queue<WriteTask> writeQueue;
-    std::mutex writeMutex;
-    std::condition_variable writeCv;
-    bool writerDone = false;
+    // Bounded so decompression workers stall instead of piling payloads up in memory when the disk is slower.
+    BoundedQueue<WriteTask> writeQueue(std::max<std::size_t>(options.MaxQueuedWrites, 1));
 
     struct EntryResult
     {
@@ -634,8 +642,9 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
             return;
         }
 
-        std::span<const std::uint8_t> compressedSpan(xpacBytes.data() + entry.Offset,
-                                                     static_cast<std::size_t>(entry.CompressedSize));
+        std::span<const std::uint8_t> compressedSpan =
+            xpacBytes.subspan(entry.Offset, static_cast<std::size_t>(entry.CompressedSize));
+        xpacFile.WillNeed(entry.Offset, compressedSpan.size());
 
         std::vector<std::uint8_t> payload;
         try
@@ -653,11 +662,10 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
             processed.fetch_add(1);
             return;
         }
+        // The archive is read front to back once; let the kernel drop what this entry used.
+        xpacFile.DontNeed(entry.Offset, compressedSpan.size());
 
-        std::string mappedName;
-        auto it = mapping.find(entry.Hash);
-        if (it != mapping.end())
-            mappedName = it->second;
+        std::string mappedName(FindMappedName(mapping, entry.Hash));
 
         std::filesystem::path relativePath;
         if (!mappedName.empty())
@@ -678,24 +686,70 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
         if (!relativePath.empty())
         {
             outputPath = xpacRoot / relativePath;
-            WriteTask task;
-            task.Index = index;
-            task.Path = outputPath;
-            task.Data = std::move(payload);
-            task.IsMainOutput = true;
-            task.IsPairCandidate = (!extension.empty() && (extension == ".zif" || extension == ".zig"));
-            task.Extension = extension;
-            if (task.IsPairCandidate)
+            const bool isPairCandidate = extension == ".zif" || extension == ".zig";
+            std::string pairBase;
+            if (isPairCandidate)
             {
                 std::filesystem::path base = outputPath;
                 base.replace_extension();
-                task.PairBase = base.string();
+                pairBase = base.string();
             }
+
+            std::vector<std::uint8_t> converted;
+            if (convertInWorkers && isPairCandidate)
             {
-                std::lock_guard<std::mutex> lock(writeMutex);
-                writeQueue.push(std::move(task));
+                std::string convertError;
+                bool convertedOk = false;
+                try
+                {
+                    convertedOk = DecodeZifZig(payload, converted, convertError);
+                }
+                catch (std::exception const& ex)
+                {
+                    convertError = ex.what();
+                }
+                if (convertedOk && converted.empty())
+                    convertError = "decoded empty " + std::string(extension == ".zif" ? "SIF" : "SIG");
+                if (!convertedOk || converted.empty())
+                {
+                    converted.clear();
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    result.Errors.push_back("Failed to convert " + outputPath.string() + ": " + convertError);
+                }
+            }
+
+            const bool keepOriginal = converted.empty() || options.KeepZifZig;
+            if (!converted.empty())
+            {
+                WriteTask task;
+                task.Index = index;
+                task.Path = outputPath;
+                task.Path.replace_extension(extension == ".zif" ? ".sif" : ".sig");
+                task.IsMainOutput = !keepOriginal;
+                task.IsPairCandidate = true;
+                task.IsConverted = true;
+                task.PairBase = pairBase;
+                task.Extension = extension;
+                if (!keepOriginal)
+                {
+                    outputPath = task.Path;
+                    isSif = LooksLikeSif(converted);
+                }
+                task.Data = std::move(converted);
+                writeQueue.Push(std::move(task));
+            }
+            if (keepOriginal)
+            {
+                WriteTask task;
+                task.Index = index;
+                task.Path = outputPath;
+                task.Data = std::move(payload);
+                task.IsMainOutput = true;
+                task.IsPairCandidate = isPairCandidate;
+                task.Extension = extension;
+                task.PairBase = std::move(pairBase);
+                writeQueue.Push(std::move(task));
             }
-            writeCv.notify_one();
             wroteFile = true;
         }
         else
@@ -711,11 +765,7 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
                 task.Path = outputPath;
                 task.Data = std::move(payload);
                 task.IsMainOutput = true;
-                {
-                    std::lock_guard<std::mutex> lock(writeMutex);
-                    writeQueue.push(std::move(task));
-                }
-                writeCv.notify_one();
+                writeQueue.Push(std::move(task));
                 wroteFile = true;
             }
 
@@ -727,11 +777,7 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
                 task.Index = index;
                 task.Path = decodedPath;
                 task.Data = std::move(unknown.Data);
-                {
-                    std::lock_guard<std::mutex> lock(writeMutex);
-                    writeQueue.push(std::move(task));
-                }
-                writeCv.notify_one();
+                writeQueue.Push(std::move(task));
             }
         }
 
@@ -746,22 +792,14 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
     std::atomic<std::size_t> nextIndex{0};
     std::vector<std::thread> workers;
     workers.reserve(workerCount);
-    std::thread writer([&]() {
+    // Written by the writer threads; one slot per entry, so no lock is needed.
+    std::vector<std::uint8_t> mainWriteFailed(entries.size(), 0);
+    auto writeLoop = [&]() {
         for (;;)
         {
-            WriteTask task;
-            {
-                std::unique_lock<std::mutex> lock(writeMutex);
-                writeCv.wait(lock, [&]() { return writerDone || !writeQueue.empty(); });
-                if (writeQueue.empty())
-                {
-                    if (writerDone)
-                        break;
-                    continue;
-                }
-                task = std::move(writeQueue.front());
-                writeQueue.pop();
-            }
+            WriteTask task = writeQueue.Pop();
+            if (task.Stop)
+                break;
 
             std::string error;
             bool ok = WriteFile(task.Path, task.Data, error);
@@ -772,29 +810,36 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
                 result.Errors.push_back(error);
             }
 
-            if (task.IsMainOutput)
-            {
-                std::lock_guard<std::mutex> lock(resultsMutex);
-                entryResults[task.Index].WroteFile = ok;
-            }
+            if (task.IsMainOutput && !ok)
+                mainWriteFailed[task.Index] = 1;
 
             if (ok && task.IsPairCandidate)
             {
                 std::lock_guard<std::mutex> lock(pairMutex);
                 PairPaths& pair = pairMap[task.PairBase];
-                if (task.Extension == ".zif")
+                const bool isZif = task.Extension == ".zif";
+                if (task.IsMainOutput)
+                    (isZif ? extractedZif : extractedZig).fetch_add(1);
+                if (task.IsConverted)
                 {
-                    extractedZif.fetch_add(1);
-                    pair.Zif = task.Path;
+                    (isZif ? pair.SifWritten : pair.SigWritten) = true;
+                    if (pair.SifWritten && pair.SigWritten)
+                        convertedPairs.fetch_add(1);
                 }
-                else if (task.Extension == ".zig")
+                else
                 {
-                    extractedZig.fetch_add(1);
-                    pair.Zig = task.Path;
+                    (isZif ? pair.Zif : pair.Zig) = task.Path;
                 }
             }
         }
-    });
+    };
+    const std::size_t writerCount =
+        options.WriterThreads != 0 ? options.WriterThreads
+                                   : std::clamp<std::size_t>(std::thread::hardware_concurrency() / 4, 1, 4);
+    std::vector<std::thread> writers;
+    writers.reserve(writerCount);
+    for (std::size_t i = 0; i < writerCount; ++i)
+        writers.emplace_back(writeLoop);
     for (std::size_t i = 0; i < workerCount; ++i)
     {
         workers.emplace_back([&]() {
@@ -809,22 +854,26 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
     }
     for (auto& t : workers)
         t.join();
+    // Every real task was queued before these, so each writer drains its share before seeing a stop.
+    for (std::size_t i = 0; i < writerCount; ++i)
     {
-        std::lock_guard<std::mutex> lock(writeMutex);
-        writerDone = true;
+        WriteTask stop;
+        stop.Stop = true;
+        writeQueue.Push(std::move(stop));
     }
-    writeCv.notify_all();
-    writer.join();
+    for (auto& t : writers)
+        t.join();
 
     result.SkippedEntries += skipped.load();
     result.ExtractedZif += extractedZif.load();
     result.ExtractedZig += extractedZig.load();
+    result.ConvertedPairs += convertedPairs.load();
 
     for (std::size_t i = 0; i < entries.size(); ++i)
     {
         auto const& entry = entries[i];
         auto const& entryResult = entryResults[i];
-        if (manifest && entryResult.WroteFile)
+        if (manifest && entryResult.WroteFile && !mainWriteFailed[i])
         {
             manifest << HashHex(entry.Hash) << ",";
             manifest << entry.Hash << ",";
@@ -837,7 +886,7 @@ XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options)
         }
     }
 
-    if (options.ConvertToSifSig)
+    if (options.ConvertToSifSig && !convertInWorkers)
     {
         std::vector<std::reference_wrapper<const PairPaths>> convertPairs;
         convertPairs.reserve(pairMap.size());
@@ -937,13 +986,6 @@ XpacRepackResult RepackXpac(XpacRepackOptions const& options)
     std::unordered_map<std::uint32_t, std::string> mapping;
     if (mappingPath)
         mapping = LoadMapping(*mappingPath);
-#if defined(SEEDITOR_EMBED_MAPPING)
-    if (mapping.empty() && kEmbeddedMappingSize > 0)
-    {
-        mapping = LoadMappingFromText(
-            std::string_view(reinterpret_cast<char const*>(kEmbeddedMapping), kEmbeddedMappingSize));
-    }
-#endif
 
     std::ifstream file(options.XpacPath, std::ios::binary);
     if (!file)
@@ -1031,12 +1073,15 @@ XpacRepackResult RepackXpac(XpacRepackOptions const& options)
     bool allReplacementsIdentical = true;
     if (anyReplacement)
     {
+        // The original archive was written as single zlib streams; only that reproduces its bytes.
+        ZlibCompressOptions identityCompression = options.Compression;
+        identityCompression.BlockSize = 0;
         for (auto const& entry : entries)
         {
             std::filesystem::path relativePath;
-            auto it = mapping.find(entry.Entry.Hash);
-            if (it != mapping.end())
-                relativePath = BuildXpacToolRelativePath(it->second);
+            std::string_view mappedName = FindMappedName(mapping, entry.Entry.Hash);
+            if (!mappedName.empty())
+                relativePath = BuildXpacToolRelativePath(std::string(mappedName));
             if (relativePath.empty())
                 continue;
 
@@ -1067,7 +1112,7 @@ XpacRepackResult RepackXpac(XpacRepackOptions const& options)
             }
 
             std::vector<std::uint8_t> payload;
-            if (!EncodeZifZig(rawBytes, payload, error))
+            if (!EncodeZifZig(rawBytes, payload, error, identityCompression))
             {
                 allReplacementsIdentical = false;
                 break;
@@ -1078,7 +1123,7 @@ XpacRepackResult RepackXpac(XpacRepackOptions const& options)
             {
                 try
                 {
-                    stored = CompressZlib(payload);
+                    stored = CompressZlib(payload, identityCompression);
                 }
                 catch (...)
                 {
@@ -1148,9 +1193,9 @@ XpacRepackResult RepackXpac(XpacRepackOptions const& options)
             options.Progress(i, entries.size());
         auto& entry = entries[i];
         std::filesystem::path relativePath;
-        auto it = mapping.find(entry.Entry.Hash);
-        if (it != mapping.end())
-            relativePath = BuildXpacToolRelativePath(it->second);
+        std::string_view mappedName = FindMappedName(mapping, entry.Entry.Hash);
+        if (!mappedName.empty())
+            relativePath = BuildXpacToolRelativePath(std::string(mappedName));
 
         std::vector<std::uint8_t> payload;
         std::string error;
@@ -1210,7 +1255,7 @@ XpacRepackResult RepackXpac(XpacRepackOptions const& options)
                     result.Errors.push_back("Failed to read " + replacement.string() + ": " + error);
                     return result;
                 }
-                if (!EncodeZifZig(sifBytes, payload, error))
+                if (!EncodeZifZig(sifBytes, payload, error, options.Compression))
                 {
                     result.Errors.push_back("Failed to encode " + replacement.string() + ": " + error);
                     return result;
@@ -1230,7 +1275,7 @@ XpacRepackResult RepackXpac(XpacRepackOptions const& options)
                     {
                         std::vector<std::uint8_t> rawBytes;
                         if (!ReadFileBytes(alt, rawBytes, error) ||
-                            !EncodeZifZig(rawBytes, payload, error))
+                            !EncodeZifZig(rawBytes, payload, error, options.Compression))
                         {
                             result.Errors.push_back("Failed to encode " + alt.string() + ": " + error);
                             return result;
@@ -1266,7 +1311,7 @@ XpacRepackResult RepackXpac(XpacRepackOptions const& options)
             {
                 std::vector<std::uint8_t> rawBytes;
                 if (!ReadFileBytes(sifPath, rawBytes, error) ||
-                    !EncodeZifZig(rawBytes, payload, error))
+                    !EncodeZifZig(rawBytes, payload, error, options.Compression))
                 {
                     result.Errors.push_back("Failed to encode " + sifPath.string() + ": " + error);
                     return result;
@@ -1276,7 +1321,7 @@ XpacRepackResult RepackXpac(XpacRepackOptions const& options)
             {
                 std::vector<std::uint8_t> rawBytes;
                 if (!ReadFileBytes(sigPath, rawBytes, error) ||
-                    !EncodeZifZig(rawBytes, payload, error))
+                    !EncodeZifZig(rawBytes, payload, error, options.Compression))
                 {
                     result.Errors.push_back("Failed to encode " + sigPath.string() + ": " + error);
                     return result;
@@ -1294,7 +1339,7 @@ XpacRepackResult RepackXpac(XpacRepackOptions const& options)
         {
             try
             {
-                stored = CompressZlib(payload);
+                stored = CompressZlib(payload, options.Compression);
             }
             catch (std::exception const& ex)
             {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ParallelDeflate.hpp"
+
 #include <cstdint>
 #include <filesystem>
 #include <functional>
@@ -20,12 +22,28 @@ struct XpacEntry
     std::uint32_t Flags = 0;
 };
 
+enum class XpacConvertMode
+{
+    // Separate pass after extraction that re-reads every written .zif/.zig pair from disk.
+    AfterExtract,
+    // Each unpack worker decodes its .zif/.zig entry while the payload is still in memory.
+    InWorkers,
+};
+
 struct XpacUnpackOptions
 {
     std::filesystem::path XpacPath;
     std::filesystem::path OutputRoot;
     std::optional<std::filesystem::path> MappingPath;
     bool ConvertToSifSig = true;
+    XpacConvertMode ConvertMode = XpacConvertMode::AfterExtract;
+    // InWorkers only: also write the original .zif/.zig next to the converted file. Entries that fail to
+    // convert are always written in their original form.
+    bool KeepZifZig = true;
+    // Threads writing extracted files (0 = a quarter of the hardware threads, 1 to 4).
+    std::size_t WriterThreads = 0;
+    // Finished payloads allowed to wait for a writer before decompression workers block.
+    std::size_t MaxQueuedWrites = 64;
     std::function<void(std::size_t current, std::size_t total)> Progress;
     std::function<void(std::size_t current, std::size_t total)> ProgressConvert;
 };
@@ -48,6 +66,8 @@ struct XpacRepackOptions
     std::optional<std::filesystem::path> ReplacementRoot;
     std::optional<std::filesystem::path> MappingPath;
     std::vector<std::filesystem::path> SelectedSifRelativePaths;
+    // Large entries are deflated in parallel blocks by default; BlockSize = 0 keeps one stream per entry.
+    ZlibCompressOptions Compression{.BlockSize = ZlibCompressOptions::kDefaultBlockSize};
     std::function<void(std::size_t current, std::size_t total)> Progress;
 };
 
@@ -63,6 +83,19 @@ std::optional<std::filesystem::path> FindDefaultMappingPath(std::filesystem::pat
 
 XpacUnpackResult UnpackXpac(XpacUnpackOptions const& options);
 XpacRepackResult RepackXpac(XpacRepackOptions const& options);
-bool EncodeZifZig(std::span<const std::uint8_t> raw, std::vector<std::uint8_t>& out, std::string& error);
+bool EncodeZifZig(std::span<const std::uint8_t> raw,
+                  std::vector<std::uint8_t>& out,
+                  std::string& error,
+                  ZlibCompressOptions const& compression = {});
+// Inflates a .zif/.zig payload and strips its length prefix, giving the .sif/.sig bytes.
+bool DecodeZifZig(std::span<const std::uint8_t> data, std::vector<std::uint8_t>& out, std::string& error);
+
+// Parses the entry table of an XPAC archive held in memory.
+bool ReadXpacEntryTable(std::span<const std::uint8_t> archive, std::vector<XpacEntry>& entries, std::string& error);
+// Payload of one entry, inflated when it is stored compressed.
+bool ReadXpacEntry(std::span<const std::uint8_t> archive,
+                   XpacEntry const& entry,
+                   std::vector<std::uint8_t>& out,
+                   std::string& error);
 
 } // namespace SeEditor::Xpac
@@ -1,16 +1,38 @@
 #include "Szs.hpp"
 
-#include <array>
 #include <stdexcept>
 
+#include "Yaz0Stream.hpp"
+
 namespace SlLib::MarioKart::szs {
 
-bool IsCompressed(const std::vector<uint8_t>& data)
+namespace {
+
+yaz0::Effort EffortFor(CompressionAlgorithm algorithm)
 {
-    if (data.empty())
-        return false;
+    switch (algorithm)
+    {
+    case CompressionAlgorithm::WorstCaseEncoding:
+        return yaz0::Effort::Store;
+    case CompressionAlgorithm::MkwSP:
+    case CompressionAlgorithm::CTGP:
+        return yaz0::Effort::Fast;
+    case CompressionAlgorithm::Haroohie:
+    case CompressionAlgorithm::CTlib:
+    case CompressionAlgorithm::LibYaz0:
+        return yaz0::Effort::Normal;
+    case CompressionAlgorithm::Nintendo:
+    case CompressionAlgorithm::MK8:
+        return yaz0::Effort::Best;
+    }
+    return yaz0::Effort::Best;
+}
+
+} // namespace
 
-    return detail::riiszs_is_compressed(data.data(), static_cast<uint32_t>(data.size())) != 0;
+bool IsCompressed(const std::vector<uint8_t>& data)
+{
+    return yaz0::HasHeader(data);
 }
 
 std::vector<uint8_t> Decode(const std::vector<uint8_t>& compressedData)
@@ -21,52 +43,48 @@ std::vector<uint8_t> Decode(const std::vector<uint8_t>& compressedData)
     if (!IsCompressed(compressedData))
         throw std::invalid_argument("Data is not SZS (\"YAZ0\" or \"YAZ1\") compressed.");
 
-    uint32_t expanded = detail::riiszs_decoded_size(compressedData.data(), static_cast<uint32_t>(compressedData.size()));
-    std::vector<uint8_t> decodedData(expanded);
-
-    const char* error = detail::riiszs_decode(decodedData.data(), expanded, compressedData.data(),
-                                               static_cast<uint32_t>(compressedData.size()));
-    if (error != nullptr)
+    try
     {
-        std::string message(error);
-        detail::riiszs_free_error_message(error);
-        throw std::runtime_error("Encoding failed: " + message);
+        return yaz0::Decode(compressedData);
     }
+    catch (std::runtime_error const& error)
+    {
+        throw std::runtime_error(std::string("Decoding failed: ") + error.what());
+    }
+}
 
-    return decodedData;
+void DecodeTo(std::span<const uint8_t> compressedData, std::function<void(std::span<const uint8_t>)> const& sink)
+{
+    if (!yaz0::HasHeader(compressedData))
+        throw std::invalid_argument("Data is not SZS (\"YAZ0\" or \"YAZ1\") compressed.");
+
+    yaz0::StreamDecoder decoder(compressedData);
+    try
+    {
+        decoder.DecodeTo(sink);
+    }
+    catch (std::runtime_error const& error)
+    {
+        throw std::runtime_error(std::string("Decoding failed: ") + error.what());
+    }
 }
 
 std::vector<uint8_t> Encode(const std::vector<uint8_t>& data, CompressionAlgorithm algorithm)
+{
+    return Encode(data, EffortFor(algorithm));
+}
+
+std::vector<uint8_t> Encode(const std::vector<uint8_t>& data, yaz0::Effort effort)
 {
     if (data.empty())
         throw std::invalid_argument("Input data cannot be empty.");
 
-    uint32_t upperBound = detail::riiszs_encoded_upper_bound(static_cast<uint32_t>(data.size()));
-    std::vector<uint8_t> encodedBuffer(upperBound);
-    uint32_t usedLen = 0;
-
-    const char* error = detail::riiszs_encode_algo_fast(encodedBuffer.data(), upperBound, data.data(),
-                                                        static_cast<uint32_t>(data.size()), &usedLen,
-                                                        static_cast<uint32_t>(algorithm));
-    if (error != nullptr)
-    {
-        std::string message(error);
-        detail::riiszs_free_error_message(error);
-        throw std::runtime_error("Encoding failed: " + message);
-    }
-
-    encodedBuffer.resize(usedLen);
-    return encodedBuffer;
+    return yaz0::Encode(data, effort);
 }
 
 std::string GetVersion()
 {
-    std::array<uint8_t, 256> buffer{};
-    int length = detail::szs_get_version_unstable_api(buffer.data(), static_cast<uint32_t>(buffer.size()));
-    if (length > 0 && length < static_cast<int>(buffer.size()))
-        return std::string(reinterpret_cast<char*>(buffer.data()), static_cast<std::size_t>(length));
-
-    throw std::runtime_error("Failed to retrieve version.");
+    return "SlLib native Yaz0 1.0";
 }
 
 } // namespace SlLib::MarioKart::szs
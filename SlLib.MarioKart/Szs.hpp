@@ -1,23 +1,19 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <span>
 #include <string>
 #include <vector>
 
-namespace SlLib::MarioKart {
+#include "Yaz0.hpp"
 
-namespace detail {
-extern "C" uint32_t riiszs_is_compressed(const uint8_t* src, uint32_t len);
-extern "C" uint32_t riiszs_decoded_size(const uint8_t* src, uint32_t len);
-extern "C" const char* riiszs_decode(uint8_t* dst, uint32_t dst_len, const uint8_t* src, uint32_t src_len);
-extern "C" uint32_t riiszs_encoded_upper_bound(uint32_t len);
-extern "C" const char* riiszs_encode_algo_fast(uint8_t* dst, uint32_t dst_len, const uint8_t* src, uint32_t src_len, uint32_t* used_len, uint32_t algo);
-extern "C" void riiszs_free_error_message(const char* msg);
-extern "C" int szs_get_version_unstable_api(uint8_t* buf, uint32_t len);
-} // namespace detail
+namespace SlLib::MarioKart {
 
 namespace szs {
 
+// Encoder presets named after the tools whose output they used to reproduce. All of them now map onto the
+// native encoder's effort levels.
 enum class CompressionAlgorithm
 {
     WorstCaseEncoding = 0,
@@ -32,7 +28,11 @@ enum class CompressionAlgorithm
 
 bool IsCompressed(const std::vector<uint8_t>& data);
 std::vector<uint8_t> Decode(const std::vector<uint8_t>& compressedData);
+// Decodes without materialising the whole output: `sink` receives the decoded bytes in order, in runs that
+// are only valid for the duration of the call. See yaz0::InputStream for a std::istream over the same data.
+void DecodeTo(std::span<const uint8_t> compressedData, std::function<void(std::span<const uint8_t>)> const& sink);
 std::vector<uint8_t> Encode(const std::vector<uint8_t>& data, CompressionAlgorithm algorithm = CompressionAlgorithm::MK8);
+std::vector<uint8_t> Encode(const std::vector<uint8_t>& data, yaz0::Effort effort);
 std::string GetVersion();
 
 } // namespace szs
@@ -27,7 +27,7 @@ void TrackImporter::Import()
     collision.ImportCollision("collision_main");
 
     auto& database = importer.GetDatabase();
-    std::cout << "[TrackImporter] Database chunk count: " << database.Chunks.size() << std::endl;
+    std::cout << "[TrackImporter] Database chunk count: " << database.GetChunks().size() << std::endl;
 }
 
 } // namespace SlLib::MarioKart
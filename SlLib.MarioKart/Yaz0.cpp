@@ -0,0 +1,395 @@
+#include "Yaz0.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace SlLib::MarioKart::yaz0 {
+
+namespace {
+
+constexpr int kHashBits = 15;
+constexpr std::size_t kWindowMask = WindowSize - 1;
+
+uint32_t ReadBigEndian32(const uint8_t* data)
+{
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+void WriteBigEndian32(uint8_t* data, uint32_t value)
+{
+    data[0] = static_cast<uint8_t>(value >> 24);
+    data[1] = static_cast<uint8_t>(value >> 16);
+    data[2] = static_cast<uint8_t>(value >> 8);
+    data[3] = static_cast<uint8_t>(value);
+}
+
+[[noreturn]] void ThrowTruncated()
+{
+    throw std::runtime_error("Yaz0 stream is truncated.");
+}
+
+struct EffortSettings
+{
+    std::size_t MaxChain = 0;
+    bool Lazy = false;
+};
+
+EffortSettings SettingsFor(Effort effort)
+{
+    switch (effort)
+    {
+    case Effort::Store:
+        return {0, false};
+    case Effort::Fast:
+        return {8, false};
+    case Effort::Normal:
+        return {64, true};
+    case Effort::Best:
+        return {WindowSize, true};
+    }
+    return {64, true};
+}
+
+// Hash chains over the last WindowSize positions: head[] holds the newest position per 3-byte hash and
+// prev[] links each position to the previous one with the same hash.
+class MatchFinder
+{
+public:
+    MatchFinder(std::span<const uint8_t> data, std::size_t maxChain)
+        : _data(data), _maxChain(maxChain), _head(std::size_t{1} << kHashBits, -1), _prev(WindowSize, -1)
+    {}
+
+    void InsertUpTo(std::size_t position)
+    {
+        for (; _next < position; ++_next)
+        {
+            if (_next + MinMatch > _data.size())
+                continue;
+            const uint32_t hash = Hash(_next);
+            _prev[_next & kWindowMask] = _head[hash];
+            _head[hash] = static_cast<int32_t>(_next);
+        }
+    }
+
+    // Longest match for `position` (0 when shorter than MinMatch); `distance` receives its offset.
+    std::size_t Find(std::size_t position, std::size_t& distance)
+    {
+        const std::size_t limit = std::min(MaxMatch, _data.size() - position);
+        if (limit < MinMatch)
+            return 0;
+        InsertUpTo(position);
+
+        const uint8_t* current = _data.data() + position;
+        std::size_t best = 0;
+        int32_t candidate = _head[Hash(position)];
+        for (std::size_t chain = 0; candidate >= 0 && chain < _maxChain; ++chain)
+        {
+            const auto start = static_cast<std::size_t>(candidate);
+            if (position - start > WindowSize)
+                break;
+
+            const uint8_t* match = _data.data() + start;
+            if (match[best] == current[best])
+            {
+                std::size_t length = 0;
+                while (length < limit && match[length] == current[length])
+                    ++length;
+                if (length > best)
+                {
+                    best = length;
+                    distance = position - start;
+                    if (best == limit)
+                        break;
+                }
+            }
+
+            const int32_t next = _prev[start & kWindowMask];
+            if (next >= candidate)
+                break; // slot reused by a newer position: the chain ends here
+            candidate = next;
+        }
+        return best >= MinMatch ? best : 0;
+    }
+
+private:
+    uint32_t Hash(std::size_t position) const
+    {
+        const uint8_t* p = _data.data() + position;
+        const uint32_t key = (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) | p[2];
+        return (key * 2654435761u) >> (32 - kHashBits);
+    }
+
+    std::span<const uint8_t> _data;
+    std::size_t _maxChain = 0;
+    std::vector<int32_t> _head;
+    std::vector<int32_t> _prev;
+    std::size_t _next = 0;
+};
+
+} // namespace
+
+namespace detail {
+
+void CopyMatch(uint8_t* out, std::size_t distance, std::size_t length)
+{
+    const uint8_t* from = out - distance;
+    if (distance >= length)
+    {
+        std::memcpy(out, from, length);
+        return;
+    }
+    if (distance == 1)
+    {
+        std::memset(out, *from, length);
+        return;
+    }
+    if (distance >= 8)
+    {
+        // Each 8-byte block reads only bytes that are already written.
+        std::size_t i = 0;
+        for (; i + 8 <= length; i += 8)
+            std::memcpy(out + i, from + i, 8);
+        for (; i < length; ++i)
+            out[i] = from[i];
+        return;
+    }
+
+    // Short period: lay down one period, then keep doubling the copied run.
+    std::memcpy(out, from, distance);
+    std::size_t written = distance;
+    while (written < length)
+    {
+        const std::size_t chunk = std::min(written, length - written);
+        std::memcpy(out + written, out, chunk);
+        written += chunk;
+    }
+}
+
+} // namespace detail
+
+bool HasHeader(std::span<const uint8_t> data)
+{
+    return data.size() >= HeaderSize && data[0] == 'Y' && data[1] == 'a' && data[2] == 'z' &&
+           (data[3] == '0' || data[3] == '1');
+}
+
+uint32_t DecodedSize(std::span<const uint8_t> data)
+{
+    if (!HasHeader(data))
+        throw std::invalid_argument("Data is not SZS (\"YAZ0\" or \"YAZ1\") compressed.");
+    return ReadBigEndian32(data.data() + 4);
+}
+
+void DecodeInto(std::span<const uint8_t> data, std::span<uint8_t> output)
+{
+    const uint32_t expected = DecodedSize(data);
+    if (output.size() != expected)
+        throw std::invalid_argument("Yaz0 output buffer is " + std::to_string(output.size()) + " bytes, expected " +
+                                    std::to_string(expected) + ".");
+
+    const uint8_t* src = data.data() + HeaderSize;
+    const uint8_t* const srcEnd = data.data() + data.size();
+    uint8_t* out = output.data();
+    uint8_t* const outBegin = out;
+    uint8_t* const outEnd = out + output.size();
+
+    // While a whole group fits in what is left of both buffers, skip the per-operation bounds checks and let
+    // back-references copy in whole 8-byte blocks, spilling up to 7 bytes past their end.
+    constexpr std::ptrdiff_t kGroupInput = 1 + 8 * 3;
+    constexpr std::ptrdiff_t kGroupOutput = 8 * (MaxMatch + 8);
+    while (srcEnd - src >= kGroupInput && outEnd - out >= kGroupOutput)
+    {
+        uint8_t code = *src++;
+        if (code == 0xFF)
+        {
+            std::memcpy(out, src, 8);
+            src += 8;
+            out += 8;
+            continue;
+        }
+        for (int bit = 0; bit < 8; ++bit, code = static_cast<uint8_t>(code << 1))
+        {
+            if ((code & 0x80) != 0)
+            {
+                *out++ = *src++;
+                continue;
+            }
+
+            const uint32_t b1 = src[0];
+            const uint32_t b2 = src[1];
+            src += 2;
+            const std::size_t distance = (((b1 & 0x0F) << 8) | b2) + 1;
+            std::size_t length = b1 >> 4;
+            if (length == 0)
+                length = static_cast<std::size_t>(*src++) + 0x12;
+            else
+                length += 2;
+
+            if (distance > static_cast<std::size_t>(out - outBegin))
+                throw std::runtime_error("Yaz0 back-reference points before the start of the output.");
+            if (distance >= 8)
+            {
+                const uint8_t* from = out - distance;
+                for (std::size_t i = 0; i < length; i += 8)
+                    std::memcpy(out + i, from + i, 8);
+            }
+            else
+            {
+                detail::CopyMatch(out, distance, length);
+            }
+            out += length;
+        }
+    }
+
+    while (out < outEnd)
+    {
+        if (src >= srcEnd)
+            ThrowTruncated();
+        uint8_t code = *src++;
+
+        // Eight literals in a row, with room for all of them on both sides.
+        if (code == 0xFF && srcEnd - src >= 8 && outEnd - out >= 8)
+        {
+            std::memcpy(out, src, 8);
+            src += 8;
+            out += 8;
+            continue;
+        }
+
+        for (int bit = 0; bit < 8 && out < outEnd; ++bit, code = static_cast<uint8_t>(code << 1))
+        {
+            if ((code & 0x80) != 0)
+            {
+                if (src >= srcEnd)
+                    ThrowTruncated();
+                *out++ = *src++;
+                continue;
+            }
+
+            if (srcEnd - src < 2)
+                ThrowTruncated();
+            const uint32_t b1 = src[0];
+            const uint32_t b2 = src[1];
+            src += 2;
+            const std::size_t distance = (((b1 & 0x0F) << 8) | b2) + 1;
+            std::size_t length = b1 >> 4;
+            if (length == 0)
+            {
+                if (src >= srcEnd)
+                    ThrowTruncated();
+                length = static_cast<std::size_t>(*src++) + 0x12;
+            }
+            else
+            {
+                length += 2;
+            }
+
+            if (distance > static_cast<std::size_t>(out - outBegin))
+                throw std::runtime_error("Yaz0 back-reference points before the start of the output.");
+            // The game's decoder stops at the declared size even mid-copy.
+            length = std::min(length, static_cast<std::size_t>(outEnd - out));
+            detail::CopyMatch(out, distance, length);
+            out += length;
+        }
+    }
+}
+
+std::vector<uint8_t> Decode(std::span<const uint8_t> data)
+{
+    std::vector<uint8_t> output(DecodedSize(data));
+    DecodeInto(data, output);
+    return output;
+}
+
+std::size_t EncodedUpperBound(std::size_t size)
+{
+    // All literals: one code byte per eight bytes.
+    return HeaderSize + size + (size + 7) / 8;
+}
+
+std::vector<uint8_t> Encode(std::span<const uint8_t> data, Effort effort, uint32_t alignment)
+{
+    if (data.size() > UINT32_MAX)
+        throw std::invalid_argument("Yaz0 cannot hold more than 4 GiB.");
+
+    std::vector<uint8_t> out(EncodedUpperBound(data.size()));
+    std::memcpy(out.data(), "Yaz0", 4);
+    WriteBigEndian32(out.data() + 4, static_cast<uint32_t>(data.size()));
+    WriteBigEndian32(out.data() + 8, alignment);
+    WriteBigEndian32(out.data() + 12, 0);
+
+    std::size_t written = HeaderSize;
+    std::size_t codePosition = 0;
+    int codeBits = 8;
+    auto beginOperation = [&](bool literal) {
+        if (codeBits == 8)
+        {
+            codePosition = written++;
+            out[codePosition] = 0;
+            codeBits = 0;
+        }
+        if (literal)
+            out[codePosition] |= static_cast<uint8_t>(0x80u >> codeBits);
+        ++codeBits;
+    };
+    auto emitLiteral = [&](uint8_t value) {
+        beginOperation(true);
+        out[written++] = value;
+    };
+    auto emitMatch = [&](std::size_t distance, std::size_t length) {
+        beginOperation(false);
+        const auto offset = static_cast<uint32_t>(distance - 1);
+        if (length >= 0x12)
+        {
+            out[written++] = static_cast<uint8_t>(offset >> 8);
+            out[written++] = static_cast<uint8_t>(offset);
+            out[written++] = static_cast<uint8_t>(length - 0x12);
+        }
+        else
+        {
+            out[written++] = static_cast<uint8_t>(((length - 2) << 4) | (offset >> 8));
+            out[written++] = static_cast<uint8_t>(offset);
+        }
+    };
+
+    const EffortSettings settings = SettingsFor(effort);
+    MatchFinder finder(data, settings.MaxChain);
+    std::size_t position = 0;
+    while (position < data.size())
+    {
+        std::size_t distance = 0;
+        std::size_t length = settings.MaxChain > 0 ? finder.Find(position, distance) : 0;
+
+        // Lazy matching: a longer match one byte later is worth a literal now.
+        if (settings.Lazy && length > 0 && length < MaxMatch && position + 1 < data.size())
+        {
+            std::size_t nextDistance = 0;
+            const std::size_t nextLength = finder.Find(position + 1, nextDistance);
+            if (nextLength > length)
+            {
+                emitLiteral(data[position]);
+                ++position;
+                length = nextLength;
+                distance = nextDistance;
+            }
+        }
+
+        if (length == 0)
+        {
+            emitLiteral(data[position]);
+            ++position;
+            continue;
+        }
+        emitMatch(distance, length);
+        position += length;
+    }
+
+    // Matches never cost more than the literals they replace, so this stays within the bound.
+    out.resize(written);
+    return out;
+}
+
+} // namespace SlLib::MarioKart::yaz0
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace SlLib::MarioKart::yaz0 {
+
+// "Yaz0"/"Yaz1" magic, big-endian decoded size, alignment hint and four reserved bytes.
+constexpr std::size_t HeaderSize = 0x10;
+// Back-references reach at most 0x1000 bytes back and copy 3 to 0x111 bytes.
+constexpr std::size_t WindowSize = 0x1000;
+constexpr std::size_t MinMatch = 3;
+constexpr std::size_t MaxMatch = 0x111;
+
+enum class Effort
+{
+    Store,  // literals only
+    Fast,   // short hash chains, greedy
+    Normal, // longer chains, one step of lazy matching
+    Best,   // whole window searched, lazy matching
+};
+
+bool HasHeader(std::span<const uint8_t> data);
+// Decoded size from the header; throws std::invalid_argument when there is no Yaz0/Yaz1 header.
+uint32_t DecodedSize(std::span<const uint8_t> data);
+// Decodes the stream (header included) into `output`, which must be DecodedSize() bytes. Throws
+// std::runtime_error on truncated or corrupt input.
+void DecodeInto(std::span<const uint8_t> data, std::span<uint8_t> output);
+std::vector<uint8_t> Decode(std::span<const uint8_t> data);
+
+std::size_t EncodedUpperBound(std::size_t size);
+std::vector<uint8_t> Encode(std::span<const uint8_t> data, Effort effort = Effort::Normal, uint32_t alignment = 0);
+
+namespace detail {
+// Copies a back-reference of `length` bytes from `distance` bytes behind `out`, repeating the source when the
+// two overlap. All bytes in [out - distance, out + length) must be addressable.
+void CopyMatch(uint8_t* out, std::size_t distance, std::size_t length);
+} // namespace detail
+
+} // namespace SlLib::MarioKart::yaz0
@@ -0,0 +1,262 @@
+#include "Yaz0Stream.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace SlLib::MarioKart::yaz0 {
+
+namespace {
+
+[[noreturn]] void ThrowTruncated()
+{
+    throw std::runtime_error("Yaz0 stream is truncated.");
+}
+
+} // namespace
+
+StreamDecoder::StreamDecoder(std::span<const uint8_t> data, std::span<uint8_t> ring)
+    : _data(data), _ring(ring)
+{
+    _decodedSize = yaz0::DecodedSize(data);
+    if (_ring.empty())
+    {
+        _ownedRing.resize(kDefaultRingSize);
+        _ring = _ownedRing;
+    }
+    if (_ring.size() < 2 * WindowSize || (_ring.size() & (_ring.size() - 1)) != 0)
+        throw std::invalid_argument("Yaz0 ring buffer must be a power of two of at least 8 KiB.");
+    _ringMask = _ring.size() - 1;
+}
+
+void StreamDecoder::Refill()
+{
+    // Called once everything produced so far has been delivered. The batch runs to the end of the ring at
+    // most, so it is contiguous; the previous lap's tail still holds the window for back-references.
+    const std::size_t start = _produced & _ringMask;
+    const std::size_t limit = std::min<std::size_t>(_decodedSize - _produced, _ring.size() - start);
+    uint8_t* const ring = _ring.data();
+    uint8_t* out = ring + start;
+    uint8_t* const end = out + limit;
+    const uint8_t* src = _data.data() + _source;
+    const uint8_t* const srcEnd = _data.data() + _data.size();
+
+    while (out < end)
+    {
+        if (_matchRemaining > 0)
+        {
+            const std::size_t count = std::min(_matchRemaining, static_cast<std::size_t>(end - out));
+            const auto position = static_cast<std::size_t>(out - ring);
+            if (position >= _matchDistance)
+            {
+                detail::CopyMatch(out, _matchDistance, count);
+            }
+            else
+            {
+                // The source starts in the previous lap, at the far end of the ring.
+                for (std::size_t i = 0; i < count; ++i)
+                    out[i] = ring[(position + i - _matchDistance) & _ringMask];
+            }
+            out += count;
+            _matchRemaining -= count;
+            continue;
+        }
+
+        if (_codeBits == 0)
+        {
+            if (src >= srcEnd)
+                ThrowTruncated();
+            _code = *src++;
+            _codeBits = 8;
+        }
+        const bool literal = (_code & 0x80) != 0;
+        _code = static_cast<uint8_t>(_code << 1);
+        --_codeBits;
+
+        if (literal)
+        {
+            if (src >= srcEnd)
+                ThrowTruncated();
+            *out++ = *src++;
+            continue;
+        }
+
+        if (srcEnd - src < 2)
+            ThrowTruncated();
+        const uint32_t b1 = src[0];
+        const uint32_t b2 = src[1];
+        src += 2;
+        const std::size_t distance = (((b1 & 0x0F) << 8) | b2) + 1;
+        std::size_t length = b1 >> 4;
+        if (length == 0)
+        {
+            if (src >= srcEnd)
+                ThrowTruncated();
+            length = static_cast<std::size_t>(*src++) + 0x12;
+        }
+        else
+        {
+            length += 2;
+        }
+
+        const std::size_t produced = _produced + static_cast<std::size_t>(out - (ring + start));
+        if (distance > produced)
+            throw std::runtime_error("Yaz0 back-reference points before the start of the output.");
+        _matchDistance = distance;
+        _matchRemaining = std::min<std::size_t>(length, _decodedSize - produced);
+    }
+
+    _source = static_cast<std::size_t>(src - _data.data());
+    _produced += limit;
+}
+
+std::span<const uint8_t> StreamDecoder::Next(std::size_t maxBytes)
+{
+    if (_delivered == _produced)
+    {
+        if (_produced == _decodedSize)
+            return {};
+        Refill();
+    }
+
+    const std::size_t start = _delivered & _ringMask;
+    const std::size_t count = std::min(maxBytes, _produced - _delivered);
+    _delivered += count;
+    return {_ring.data() + start, count};
+}
+
+std::size_t StreamDecoder::Read(std::span<uint8_t> output)
+{
+    std::size_t copied = 0;
+    while (copied < output.size())
+    {
+        std::span<const uint8_t> run = Next(output.size() - copied);
+        if (run.empty())
+            break;
+        std::memcpy(output.data() + copied, run.data(), run.size());
+        copied += run.size();
+    }
+    return copied;
+}
+
+std::size_t StreamDecoder::Skip(std::size_t count)
+{
+    std::size_t skipped = 0;
+    while (skipped < count)
+    {
+        std::span<const uint8_t> run = Next(count - skipped);
+        if (run.empty())
+            break;
+        skipped += run.size();
+    }
+    return skipped;
+}
+
+void StreamDecoder::DecodeTo(std::function<void(std::span<const uint8_t>)> const& sink)
+{
+    for (std::span<const uint8_t> run = Next(); !run.empty(); run = Next())
+        sink(run);
+}
+
+StreamBuffer::StreamBuffer(std::span<const uint8_t> data, std::span<uint8_t> ring)
+    : _decoder(data, ring)
+{}
+
+StreamBuffer::StreamBuffer(std::vector<uint8_t> data)
+    : _ownedData(std::move(data)), _decoder(_ownedData)
+{}
+
+std::streamoff StreamBuffer::Tell() const
+{
+    return static_cast<std::streamoff>(_decoder.Position()) - (egptr() - gptr());
+}
+
+StreamBuffer::int_type StreamBuffer::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    std::span<const uint8_t> run = _decoder.Next();
+    if (run.empty())
+    {
+        setg(nullptr, nullptr, nullptr);
+        return traits_type::eof();
+    }
+    // The get area is only read from; std::streambuf just wants non-const pointers.
+    auto* begin = reinterpret_cast<char_type*>(const_cast<uint8_t*>(run.data()));
+    setg(begin, begin, begin + run.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+std::streamsize StreamBuffer::xsgetn(char_type* s, std::streamsize count)
+{
+    std::streamsize copied = std::min<std::streamsize>(count, egptr() - gptr());
+    if (copied > 0)
+    {
+        std::memcpy(s, gptr(), static_cast<std::size_t>(copied));
+        gbump(static_cast<int>(copied));
+    }
+    if (copied == count)
+        return copied;
+
+    // Large reads go straight from the decoder; the old get area is invalid after that.
+    setg(nullptr, nullptr, nullptr);
+    copied += static_cast<std::streamsize>(_decoder.Read(
+        std::span<uint8_t>(reinterpret_cast<uint8_t*>(s + copied), static_cast<std::size_t>(count - copied))));
+    return copied;
+}
+
+std::streamsize StreamBuffer::showmanyc()
+{
+    const auto remaining = static_cast<std::streamsize>(_decoder.DecodedSize() - _decoder.Position());
+    const std::streamsize available = remaining + (egptr() - gptr());
+    return available > 0 ? available : -1;
+}
+
+StreamBuffer::pos_type StreamBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if ((which & std::ios_base::in) == 0)
+        return pos_type(off_type(-1));
+
+    off_type target = off;
+    if (dir == std::ios_base::cur)
+        target += Tell();
+    else if (dir == std::ios_base::end)
+        target += static_cast<off_type>(_decoder.DecodedSize());
+    if (target < 0 || target > static_cast<off_type>(_decoder.DecodedSize()))
+        return pos_type(off_type(-1));
+
+    const auto position = static_cast<off_type>(_decoder.Position());
+    const off_type areaStart = position - (egptr() - eback());
+    if (target >= areaStart && target <= position)
+    {
+        setg(eback(), eback() + (target - areaStart), egptr());
+        return pos_type(target);
+    }
+    if (target < areaStart)
+        return pos_type(off_type(-1)); // already decoded past it
+
+    setg(nullptr, nullptr, nullptr);
+    _decoder.Skip(static_cast<std::size_t>(target - position));
+    return pos_type(target);
+}
+
+StreamBuffer::pos_type StreamBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+InputStream::InputStream(std::span<const uint8_t> data, std::span<uint8_t> ring)
+    : std::istream(nullptr), _buffer(data, ring)
+{
+    rdbuf(&_buffer);
+}
+
+InputStream::InputStream(std::vector<uint8_t> data)
+    : std::istream(nullptr), _buffer(std::move(data))
+{
+    rdbuf(&_buffer);
+}
+
+} // namespace SlLib::MarioKart::yaz0
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <span>
+#include <streambuf>
+#include <vector>
+
+#include "Yaz0.hpp"
+
+namespace SlLib::MarioKart::yaz0 {
+
+// Incremental Yaz0 decoder. Output is produced into a ring buffer that only has to hold the 4 KiB
+// back-reference window plus one batch, so a large archive never needs its full decoded size in memory.
+// The compressed data must stay alive and unchanged while the decoder uses it.
+class StreamDecoder
+{
+public:
+    static constexpr std::size_t kDefaultRingSize = std::size_t{1} << 16;
+
+    // `ring` is caller-provided storage: a power of two of at least 2 * WindowSize bytes. When empty the
+    // decoder allocates kDefaultRingSize bytes itself. Throws std::invalid_argument for a missing header or
+    // an unusable ring.
+    explicit StreamDecoder(std::span<const uint8_t> data, std::span<uint8_t> ring = {});
+
+    [[nodiscard]] uint32_t DecodedSize() const { return _decodedSize; }
+    [[nodiscard]] std::size_t Position() const { return _delivered; }
+    [[nodiscard]] bool Done() const { return _delivered == _decodedSize; }
+
+    // The next run of decoded bytes, at most `maxBytes` long and empty at the end. It points into the ring
+    // and stays valid until the next call. Throws std::runtime_error on truncated or corrupt input.
+    std::span<const uint8_t> Next(std::size_t maxBytes = SIZE_MAX);
+    // Copies up to output.size() decoded bytes out; returns how many (0 at the end).
+    std::size_t Read(std::span<uint8_t> output);
+    std::size_t Skip(std::size_t count);
+    // Hands every remaining decoded run to `sink` in order.
+    void DecodeTo(std::function<void(std::span<const uint8_t>)> const& sink);
+
+private:
+    void Refill();
+
+    std::span<const uint8_t> _data;
+    std::size_t _source = HeaderSize;
+    std::vector<uint8_t> _ownedRing;
+    std::span<uint8_t> _ring;
+    std::size_t _ringMask = 0;
+    uint32_t _decodedSize = 0;
+    std::size_t _produced = 0;
+    std::size_t _delivered = 0;
+
+    // Decoder state carried between refills.
+    uint8_t _code = 0;
+    int _codeBits = 0;
+    std::size_t _matchDistance = 0;
+    std::size_t _matchRemaining = 0;
+};
+
+// std::streambuf over a StreamDecoder, so code that reads from a std::istream can parse an SZS while it is
+// being decompressed. The get area points straight into the decoder's ring. Seeking works forwards (by
+// decoding and discarding) and backwards within the current get area only.
+class StreamBuffer final : public std::streambuf
+{
+public:
+    explicit StreamBuffer(std::span<const uint8_t> data, std::span<uint8_t> ring = {});
+    // Keeps `data` alive for the lifetime of the buffer.
+    explicit StreamBuffer(std::vector<uint8_t> data);
+
+    [[nodiscard]] uint32_t DecodedSize() const { return _decoder.DecodedSize(); }
+
+protected:
+    int_type underflow() override;
+    std::streamsize xsgetn(char_type* s, std::streamsize count) override;
+    std::streamsize showmanyc() override;
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+private:
+    std::streamoff Tell() const;
+
+    std::vector<uint8_t> _ownedData;
+    StreamDecoder _decoder;
+};
+
+// std::istream owning a StreamBuffer.
+class InputStream final : public std::istream
+{
+public:
+    explicit InputStream(std::span<const uint8_t> data, std::span<uint8_t> ring = {});
+    explicit InputStream(std::vector<uint8_t> data);
+
+    [[nodiscard]] uint32_t DecodedSize() const { return _buffer.DecodedSize(); }
+
+private:
+    StreamBuffer _buffer;
+};
+
+} // namespace SlLib::MarioKart::yaz0
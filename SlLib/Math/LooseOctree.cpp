@@ -0,0 +1,376 @@
+#include "LooseOctree.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace SlLib::Math {
+
+namespace {
+
+enum class Overlap
+{
+    Outside,
+    Intersects,
+    Inside,
+};
+
+bool Overlaps(Aabb const& a, Aabb const& b)
+{
+    return a.Min.X <= b.Max.X && a.Max.X >= b.Min.X &&
+           a.Min.Y <= b.Max.Y && a.Max.Y >= b.Min.Y &&
+           a.Min.Z <= b.Max.Z && a.Max.Z >= b.Min.Z;
+}
+
+bool Contains(Aabb const& outer, Aabb const& inner)
+{
+    return inner.Min.X >= outer.Min.X && inner.Max.X <= outer.Max.X &&
+           inner.Min.Y >= outer.Min.Y && inner.Max.Y <= outer.Max.Y &&
+           inner.Min.Z >= outer.Min.Z && inner.Max.Z <= outer.Max.Z;
+}
+
+float DistanceSquared(Aabb const& box, Vector3 point)
+{
+    auto axis = [](float value, float lo, float hi) {
+        float d = value < lo ? lo - value : (value > hi ? value - hi : 0.0f);
+        return d * d;
+    };
+    return axis(point.X, box.Min.X, box.Max.X) + axis(point.Y, box.Min.Y, box.Max.Y) +
+           axis(point.Z, box.Min.Z, box.Max.Z);
+}
+
+Overlap ClassifyFrustum(Aabb const& box, std::span<const Vector4> planes)
+{
+    Overlap result = Overlap::Inside;
+    for (Vector4 const& plane : planes) {
+        // Box corners furthest along and against the plane normal.
+        Vector3 positive{plane.X >= 0.0f ? box.Max.X : box.Min.X,
+                         plane.Y >= 0.0f ? box.Max.Y : box.Min.Y,
+                         plane.Z >= 0.0f ? box.Max.Z : box.Min.Z};
+        Vector3 negative{plane.X >= 0.0f ? box.Min.X : box.Max.X,
+                         plane.Y >= 0.0f ? box.Min.Y : box.Max.Y,
+                         plane.Z >= 0.0f ? box.Min.Z : box.Max.Z};
+        Vector3 normal{plane.X, plane.Y, plane.Z};
+        if (dot(normal, positive) + plane.W < 0.0f)
+            return Overlap::Outside;
+        if (dot(normal, negative) + plane.W < 0.0f)
+            result = Overlap::Intersects;
+    }
+    return result;
+}
+
+// Slab test; returns the entry distance (0 when the origin is inside) or a negative value on a miss.
+float RayEntry(Aabb const& box, Vector3 origin, Vector3 inverseDirection, float maxDistance)
+{
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+    const float o[3] = {origin.X, origin.Y, origin.Z};
+    const float inv[3] = {inverseDirection.X, inverseDirection.Y, inverseDirection.Z};
+    const float lo[3] = {box.Min.X, box.Min.Y, box.Min.Z};
+    const float hi[3] = {box.Max.X, box.Max.Y, box.Max.Z};
+    for (int axis = 0; axis < 3; ++axis) {
+        if (std::isinf(inv[axis])) {
+            if (o[axis] < lo[axis] || o[axis] > hi[axis])
+                return -1.0f;
+            continue;
+        }
+        float t0 = (lo[axis] - o[axis]) * inv[axis];
+        float t1 = (hi[axis] - o[axis]) * inv[axis];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax)
+            return -1.0f;
+    }
+    return tMin;
+}
+
+// Best-first search entry: a node (Item == InvalidHandle) or an item, keyed by a lower bound on its distance.
+struct QueueEntry
+{
+    float Key = 0.0f;
+    std::int32_t Node = -1;
+    LooseOctree::Handle Item = LooseOctree::InvalidHandle;
+    bool Exact = false;
+
+    bool operator>(QueueEntry const& other) const { return Key > other.Key; }
+};
+
+using MinQueue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+} // namespace
+
+LooseOctree::LooseOctree(Vector3 center, float halfSize, int maxDepth)
+    : _maxDepth(std::clamp(maxDepth, 0, 20))
+{
+    Node root;
+    root.Center = center;
+    root.HalfSize = halfSize > 0.0f ? halfSize : 1.0f;
+    _nodes.push_back(std::move(root));
+}
+
+LooseOctree LooseOctree::FromBounds(Aabb const& bounds, int maxDepth)
+{
+    Vector3 center = (bounds.Min + bounds.Max) * 0.5f;
+    Vector3 size = bounds.Max - bounds.Min;
+    float halfSize = std::max({size.X, size.Y, size.Z}) * 0.5f;
+    return LooseOctree(center, halfSize * 1.01f + 1.0f, maxDepth);
+}
+
+LooseOctree::Handle LooseOctree::Insert(Aabb const& bounds, std::uint32_t userData)
+{
+    Handle handle;
+    if (!_freeItems.empty()) {
+        handle = _freeItems.back();
+        _freeItems.pop_back();
+    } else {
+        handle = static_cast<Handle>(_items.size());
+        _items.emplace_back();
+    }
+
+    Item& item = _items[handle];
+    item.Bounds = bounds;
+    item.UserData = userData;
+    Link(handle, FindOrCreateNode(bounds));
+    return handle;
+}
+
+void LooseOctree::Move(Handle item, Aabb const& bounds)
+{
+    if (item >= _items.size() || _items[item].Node < 0)
+        return;
+
+    // Small moves stay inside the current loose cell; only the depth check can force a relink then.
+    Item& entry = _items[item];
+    entry.Bounds = bounds;
+    std::int32_t target = FindOrCreateNode(bounds);
+    if (target == entry.Node)
+        return;
+    Unlink(item);
+    Link(item, target);
+}
+
+void LooseOctree::Remove(Handle item)
+{
+    if (item >= _items.size() || _items[item].Node < 0)
+        return;
+
+    Unlink(item);
+    _freeItems.push_back(item);
+}
+
+void LooseOctree::Clear()
+{
+    Node root;
+    root.Center = _nodes.front().Center;
+    root.HalfSize = _nodes.front().HalfSize;
+    _nodes.clear();
+    _nodes.push_back(std::move(root));
+    _items.clear();
+    _freeItems.clear();
+}
+
+std::int32_t LooseOctree::FindOrCreateNode(Aabb const& bounds)
+{
+    Vector3 center = (bounds.Min + bounds.Max) * 0.5f;
+    Vector3 size = bounds.Max - bounds.Min;
+    float extent = std::max({size.X, size.Y, size.Z});
+
+    Node const& root = _nodes.front();
+    if (std::abs(center.X - root.Center.X) > root.HalfSize || std::abs(center.Y - root.Center.Y) > root.HalfSize ||
+        std::abs(center.Z - root.Center.Z) > root.HalfSize) {
+        return 0;
+    }
+
+    std::int32_t index = 0;
+    for (int depth = 0; depth < _maxDepth; ++depth) {
+        // A child's loose bounds hold anything no larger than the child cell whose centre lies in it.
+        float childHalf = _nodes[static_cast<std::size_t>(index)].HalfSize * 0.5f;
+        if (extent > childHalf * 2.0f)
+            break;
+
+        Node const& node = _nodes[static_cast<std::size_t>(index)];
+        int octant = (center.X >= node.Center.X ? 1 : 0) | (center.Y >= node.Center.Y ? 2 : 0) |
+                     (center.Z >= node.Center.Z ? 4 : 0);
+        std::int32_t child = node.Children[static_cast<std::size_t>(octant)];
+        if (child < 0) {
+            Node created;
+            created.Center = {node.Center.X + ((octant & 1) ? childHalf : -childHalf),
+                              node.Center.Y + ((octant & 2) ? childHalf : -childHalf),
+                              node.Center.Z + ((octant & 4) ? childHalf : -childHalf)};
+            created.HalfSize = childHalf;
+            created.Parent = index;
+            child = static_cast<std::int32_t>(_nodes.size());
+            _nodes[static_cast<std::size_t>(index)].Children[static_cast<std::size_t>(octant)] = child;
+            _nodes.push_back(std::move(created));
+        }
+        index = child;
+    }
+    return index;
+}
+
+void LooseOctree::Link(Handle item, std::int32_t node)
+{
+    Node& target = _nodes[static_cast<std::size_t>(node)];
+    _items[item].Node = node;
+    _items[item].Slot = static_cast<std::uint32_t>(target.Items.size());
+    target.Items.push_back(item);
+    for (std::int32_t n = node; n >= 0; n = _nodes[static_cast<std::size_t>(n)].Parent)
+        ++_nodes[static_cast<std::size_t>(n)].SubtreeCount;
+}
+
+void LooseOctree::Unlink(Handle item)
+{
+    Item& entry = _items[item];
+    Node& node = _nodes[static_cast<std::size_t>(entry.Node)];
+    Handle moved = node.Items.back();
+    node.Items[entry.Slot] = moved;
+    _items[moved].Slot = entry.Slot;
+    node.Items.pop_back();
+    for (std::int32_t n = entry.Node; n >= 0; n = _nodes[static_cast<std::size_t>(n)].Parent)
+        --_nodes[static_cast<std::size_t>(n)].SubtreeCount;
+    entry.Node = -1;
+}
+
+Aabb LooseOctree::LooseBounds(Node const& node) const
+{
+    float h = node.HalfSize * 2.0f;
+    return {{node.Center.X - h, node.Center.Y - h, node.Center.Z - h},
+            {node.Center.X + h, node.Center.Y + h, node.Center.Z + h}};
+}
+
+template <typename NodeTest, typename ItemVisitor>
+void LooseOctree::Visit(NodeTest const& nodeTest, ItemVisitor const& visitor) const
+{
+    // The root's own items may lie anywhere, so the root is always opened.
+    std::vector<std::pair<std::int32_t, bool>> stack{{0, false}};
+    while (!stack.empty()) {
+        auto [index, inside] = stack.back();
+        stack.pop_back();
+        Node const& node = _nodes[static_cast<std::size_t>(index)];
+        for (Handle item : node.Items)
+            visitor(_items[item], inside);
+        for (std::int32_t child : node.Children) {
+            if (child < 0 || _nodes[static_cast<std::size_t>(child)].SubtreeCount == 0)
+                continue;
+            if (inside) {
+                stack.emplace_back(child, true);
+                continue;
+            }
+            Overlap overlap = nodeTest(LooseBounds(_nodes[static_cast<std::size_t>(child)]));
+            if (overlap != Overlap::Outside)
+                stack.emplace_back(child, overlap == Overlap::Inside);
+        }
+    }
+}
+
+void LooseOctree::QueryFrustum(std::span<const Vector4> planes, std::vector<std::uint32_t>& out) const
+{
+    Visit([&](Aabb const& box) { return ClassifyFrustum(box, planes); },
+          [&](Item const& item, bool inside) {
+              if (inside || ClassifyFrustum(item.Bounds, planes) != Overlap::Outside)
+                  out.push_back(item.UserData);
+          });
+}
+
+void LooseOctree::QuerySphere(Vector3 center, float radius, std::vector<std::uint32_t>& out) const
+{
+    const float radiusSquared = radius * radius;
+    Visit([&](Aabb const& box) {
+              return DistanceSquared(box, center) <= radiusSquared ? Overlap::Intersects : Overlap::Outside;
+          },
+          [&](Item const& item, bool) {
+              if (DistanceSquared(item.Bounds, center) <= radiusSquared)
+                  out.push_back(item.UserData);
+          });
+}
+
+void LooseOctree::QueryBox(Aabb const& box, std::vector<std::uint32_t>& out) const
+{
+    Visit([&](Aabb const& nodeBox) {
+              if (Contains(box, nodeBox))
+                  return Overlap::Inside;
+              return Overlaps(box, nodeBox) ? Overlap::Intersects : Overlap::Outside;
+          },
+          [&](Item const& item, bool inside) {
+              if (inside || Overlaps(box, item.Bounds))
+                  out.push_back(item.UserData);
+          });
+}
+
+bool LooseOctree::Raycast(Vector3 origin, Vector3 direction, float maxDistance, RayHit& hit, RayFilter const& filter) const
+{
+    const Vector3 inverse{1.0f / direction.X, 1.0f / direction.Y, 1.0f / direction.Z};
+    MinQueue queue;
+    queue.push({0.0f, 0});
+    while (!queue.empty()) {
+        QueueEntry entry = queue.top();
+        queue.pop();
+
+        if (entry.Item != InvalidHandle) {
+            Item const& item = _items[entry.Item];
+            if (entry.Exact || !filter) {
+                hit = {entry.Item, item.UserData, entry.Key};
+                return true;
+            }
+            // Everything still queued is at least as far as this box, so a refined hit re-enters the queue.
+            float distance = entry.Key;
+            if (filter(item.UserData, distance) && distance <= maxDistance)
+                queue.push({std::max(distance, entry.Key), -1, entry.Item, true});
+            continue;
+        }
+
+        Node const& node = _nodes[static_cast<std::size_t>(entry.Node)];
+        for (Handle item : node.Items) {
+            float t = RayEntry(_items[item].Bounds, origin, inverse, maxDistance);
+            if (t >= 0.0f)
+                queue.push({t, -1, item});
+        }
+        for (std::int32_t child : node.Children) {
+            if (child < 0 || _nodes[static_cast<std::size_t>(child)].SubtreeCount == 0)
+                continue;
+            float t = RayEntry(LooseBounds(_nodes[static_cast<std::size_t>(child)]), origin, inverse, maxDistance);
+            if (t >= 0.0f)
+                queue.push({t, child});
+        }
+    }
+    return false;
+}
+
+void LooseOctree::QueryNearest(Vector3 point, std::size_t count, std::vector<NearestHit>& out, float maxDistance) const
+{
+    if (count == 0)
+        return;
+
+    const float limit = std::isinf(maxDistance) ? maxDistance : maxDistance * maxDistance;
+    std::size_t found = 0;
+    MinQueue queue;
+    queue.push({0.0f, 0});
+    while (!queue.empty() && found < count) {
+        QueueEntry entry = queue.top();
+        queue.pop();
+
+        if (entry.Item != InvalidHandle) {
+            out.push_back({entry.Item, _items[entry.Item].UserData, entry.Key});
+            ++found;
+            continue;
+        }
+
+        Node const& node = _nodes[static_cast<std::size_t>(entry.Node)];
+        for (Handle item : node.Items) {
+            float d = DistanceSquared(_items[item].Bounds, point);
+            if (d <= limit)
+                queue.push({d, -1, item});
+        }
+        for (std::int32_t child : node.Children) {
+            if (child < 0 || _nodes[static_cast<std::size_t>(child)].SubtreeCount == 0)
+                continue;
+            float d = DistanceSquared(LooseBounds(_nodes[static_cast<std::size_t>(child)]), point);
+            if (d <= limit)
+                queue.push({d, child});
+        }
+    }
+}
+
+} // namespace SlLib::Math
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Vector.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace SlLib::Math {
+
+struct Aabb
+{
+    Vector3 Min{};
+    Vector3 Max{};
+};
+
+// Loose octree over axis-aligned boxes. Every cell's bounds are doubled, so an item is stored at the deepest
+// level whose cells are at least as large as the item and in the cell holding its centre; it never straddles
+// cells and moving it only relinks it when it leaves its loose cell. Items whose centre is outside the world
+// bounds live in the root and are tested by every query.
+class LooseOctree
+{
+public:
+    using Handle = std::uint32_t;
+    static constexpr Handle InvalidHandle = std::numeric_limits<Handle>::max();
+
+    struct RayHit
+    {
+        Handle Item = InvalidHandle;
+        std::uint32_t UserData = 0;
+        float Distance = 0.0f;
+    };
+
+    struct NearestHit
+    {
+        Handle Item = InvalidHandle;
+        std::uint32_t UserData = 0;
+        float DistanceSquared = 0.0f;
+    };
+
+    // Refines a ray hit against the item's real shape. Called with the distance at which the ray enters the
+    // item's box; return false for a miss, or true after setting `distance` to the hit distance.
+    using RayFilter = std::function<bool(std::uint32_t userData, float& distance)>;
+
+    LooseOctree(Vector3 center, float halfSize, int maxDepth = 8);
+
+    // Smallest cube around `bounds` (padded slightly) with the given depth limit.
+    static LooseOctree FromBounds(Aabb const& bounds, int maxDepth = 8);
+
+    Handle Insert(Aabb const& bounds, std::uint32_t userData);
+    void Move(Handle item, Aabb const& bounds);
+    void Remove(Handle item);
+    void Clear();
+
+    [[nodiscard]] std::size_t Size() const { return _items.size() - _freeItems.size(); }
+    [[nodiscard]] Aabb const& GetBounds(Handle item) const { return _items[item].Bounds; }
+    [[nodiscard]] std::uint32_t GetUserData(Handle item) const { return _items[item].UserData; }
+
+    // Planes are (normal, d) with the inside where dot(normal, p) + d >= 0.
+    void QueryFrustum(std::span<const Vector4> planes, std::vector<std::uint32_t>& out) const;
+    void QuerySphere(Vector3 center, float radius, std::vector<std::uint32_t>& out) const;
+    void QueryBox(Aabb const& box, std::vector<std::uint32_t>& out) const;
+    // Closest hit along the ray within `maxDistance`; `direction` need not be normalised (distances are then
+    // in units of its length).
+    bool Raycast(Vector3 origin,
+                 Vector3 direction,
+                 float maxDistance,
+                 RayHit& hit,
+                 RayFilter const& filter = {}) const;
+    // Up to `count` items nearest to `point` (by distance to their box), closest first.
+    void QueryNearest(Vector3 point,
+                      std::size_t count,
+                      std::vector<NearestHit>& out,
+                      float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+private:
+    struct Node
+    {
+        Vector3 Center{};
+        float HalfSize = 0.0f;
+        std::int32_t Parent = -1;
+        std::array<std::int32_t, 8> Children{-1, -1, -1, -1, -1, -1, -1, -1};
+        std::vector<Handle> Items;
+        std::uint32_t SubtreeCount = 0;
+    };
+
+    struct Item
+    {
+        Aabb Bounds{};
+        std::uint32_t UserData = 0;
+        std::int32_t Node = -1;
+        std::uint32_t Slot = 0;
+    };
+
+    std::int32_t FindOrCreateNode(Aabb const& bounds);
+    void Link(Handle item, std::int32_t node);
+    void Unlink(Handle item);
+    Aabb LooseBounds(Node const& node) const;
+    template <typename NodeTest, typename ItemVisitor>
+    void Visit(NodeTest const& nodeTest, ItemVisitor const& visitor) const;
+
+    int _maxDepth = 8;
+    std::vector<Node> _nodes;
+    std::vector<Item> _items;
+    std::vector<Handle> _freeItems;
+};
+
+} // namespace SlLib::Math
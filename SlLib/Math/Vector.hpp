@@ -151,6 +151,21 @@ inline Matrix4x4 CreateFromQuaternion(Quaternion const& q)
     return result;
 }
 
+// Translation * Rotation * Scale, for column vectors (translation in column 3).
+inline Matrix4x4 CreateTransform(Vector3 const& translation, Quaternion const& rotation, Vector3 const& scale)
+{
+    Matrix4x4 result = CreateFromQuaternion(rotation);
+    for (std::size_t row = 0; row < 3; ++row) {
+        result(row, 0) *= scale.X;
+        result(row, 1) *= scale.Y;
+        result(row, 2) *= scale.Z;
+    }
+    result(0, 3) = translation.X;
+    result(1, 3) = translation.Y;
+    result(2, 3) = translation.Z;
+    return result;
+}
+
 inline Vector3 operator+(Vector3 const& a, Vector3 const& b)
 {
     return {a.X + b.X, a.Y + b.Y, a.Z + b.Z};
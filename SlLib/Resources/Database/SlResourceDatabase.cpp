@@ -12,45 +12,124 @@ SlResourceDatabase::SlResourceDatabase()
 SlLib::Resources::Scene::SeNodeBase* SlResourceDatabase::FindNode(int uid) const
 {
     auto it = _nodeMap.find(uid);
-    return it != _nodeMap.end() ? it->second : nullptr;
+    return it != _nodeMap.end() ? GetNode(it->second) : nullptr;
+}
+
+SlLib::Resources::Scene::SeNodeBase* SlResourceDatabase::GetNode(SlNodeHandle handle) const
+{
+    if (handle.Index >= _nodeSlots.size())
+        return nullptr;
+    NodeSlot const& slot = _nodeSlots[handle.Index];
+    return slot.Generation == handle.Generation ? slot.Node.get() : nullptr;
+}
+
+SlNodeHandle SlResourceDatabase::FindNodeHandle(int uid) const
+{
+    auto it = _nodeMap.find(uid);
+    return it != _nodeMap.end() ? it->second : SlNodeHandle{};
 }
 
 SlResourceChunk* SlResourceDatabase::FindChunkById(int id)
 {
-    auto it = std::find_if(Chunks.begin(), Chunks.end(), [id](SlResourceChunk const& chunk) { return chunk.Id == id; });
-    return it != Chunks.end() ? &(*it) : nullptr;
+    auto it = _chunkById.find(id);
+    return it != _chunkById.end() ? &_chunks[it->second] : nullptr;
 }
 
 SlResourceChunk* SlResourceDatabase::FindChunkByName(std::string const& name)
 {
-    auto it = std::find_if(Chunks.begin(), Chunks.end(), [&name](SlResourceChunk const& chunk) {
-        return chunk.Name == name;
-    });
-    return it != Chunks.end() ? &(*it) : nullptr;
+    auto it = _chunkByName.find(name);
+    return it != _chunkByName.end() ? &_chunks[it->second] : nullptr;
 }
 
-void SlResourceDatabase::AddOwnedNode(std::unique_ptr<SlLib::Resources::Scene::SeNodeBase> node)
+SlNodeHandle SlResourceDatabase::AddOwnedNode(std::unique_ptr<SlLib::Resources::Scene::SeNodeBase> node)
 {
     if (!node)
-        return;
+        return {};
+
+    SlNodeHandle handle;
+    if (!_freeSlots.empty()) {
+        handle.Index = _freeSlots.back();
+        _freeSlots.pop_back();
+    } else {
+        handle.Index = static_cast<std::uint32_t>(_nodeSlots.size());
+        _nodeSlots.emplace_back();
+    }
 
-    _nodeMap[node->Uid] = node.get();
-    _ownedNodes.push_back(std::move(node));
+    NodeSlot& slot = _nodeSlots[handle.Index];
+    handle.Generation = slot.Generation;
+
+    auto [it, inserted] = _nodeMap.try_emplace(node->Uid, handle);
+    slot.Shadowed = inserted ? SlNodeHandle{} : it->second;
+    it->second = handle;
+    slot.Node = std::move(node);
+    return handle;
 }
 
 void SlResourceDatabase::RemoveNode(int uid)
 {
-    _nodeMap.erase(uid);
-    _ownedNodes.erase(std::remove_if(_ownedNodes.begin(), _ownedNodes.end(),
-        [uid](auto const& entry) {
-            return entry->Uid == uid;
-        }), _ownedNodes.end());
+    auto it = _nodeMap.find(uid);
+    if (it == _nodeMap.end())
+        return;
+
+    SlNodeHandle handle = it->second;
+    _nodeMap.erase(it);
+    while (GetNode(handle) != nullptr) {
+        SlNodeHandle next = _nodeSlots[handle.Index].Shadowed;
+        FreeSlot(handle);
+        handle = next;
+    }
+}
+
+void SlResourceDatabase::RemoveNode(SlNodeHandle handle)
+{
+    auto* node = GetNode(handle);
+    if (node == nullptr)
+        return;
+
+    // Unlink from the uid's chain; the chain is almost always a single node.
+    auto it = _nodeMap.find(node->Uid);
+    if (it != _nodeMap.end()) {
+        SlNodeHandle const shadowed = _nodeSlots[handle.Index].Shadowed;
+        if (it->second == handle) {
+            if (GetNode(shadowed) != nullptr)
+                it->second = shadowed;
+            else
+                _nodeMap.erase(it);
+        } else {
+            for (SlNodeHandle cur = it->second; GetNode(cur) != nullptr; cur = _nodeSlots[cur.Index].Shadowed) {
+                if (_nodeSlots[cur.Index].Shadowed == handle) {
+                    _nodeSlots[cur.Index].Shadowed = shadowed;
+                    break;
+                }
+            }
+        }
+    }
+    FreeSlot(handle);
+}
+
+void SlResourceDatabase::FreeSlot(SlNodeHandle handle)
+{
+    NodeSlot& slot = _nodeSlots[handle.Index];
+    slot.Node.reset();
+    slot.Shadowed = {};
+    ++slot.Generation;
+    _freeSlots.push_back(handle.Index);
 }
 
 void SlResourceDatabase::ClearOwnedNodes()
 {
+    // Slots are kept and their generations bumped, so handles taken before the clear stay invalid after the
+    // slots are reused.
     _nodeMap.clear();
-    _ownedNodes.clear();
+    _freeSlots.clear();
+    _freeSlots.reserve(_nodeSlots.size());
+    for (std::size_t i = _nodeSlots.size(); i-- > 0;) {
+        NodeSlot& slot = _nodeSlots[i];
+        slot.Node.reset();
+        slot.Shadowed = {};
+        ++slot.Generation;
+        _freeSlots.push_back(static_cast<std::uint32_t>(i));
+    }
 }
 
 void SlResourceDatabase::AddDefinition(SlLib::Resources::Scene::SeDefinitionNode* definition)
@@ -61,7 +140,48 @@ void SlResourceDatabase::AddDefinition(SlLib::Resources::Scene::SeDefinitionNode
 
 void SlResourceDatabase::AddChunk(SlResourceChunk chunk)
 {
-    Chunks.push_back(std::move(chunk));
+    _chunks.push_back(std::move(chunk));
+    IndexChunk(_chunks.size() - 1);
+}
+
+bool SlResourceDatabase::RemoveChunk(std::size_t index)
+{
+    if (index >= _chunks.size())
+        return false;
+    _chunks.erase(_chunks.begin() + static_cast<std::ptrdiff_t>(index));
+    // Every later chunk moved, and a removed first match may uncover a later chunk with the same key.
+    ReindexChunks();
+    return true;
+}
+
+bool SlResourceDatabase::RemoveChunkById(int id)
+{
+    auto it = _chunkById.find(id);
+    return it != _chunkById.end() && RemoveChunk(it->second);
+}
+
+void SlResourceDatabase::ClearChunks()
+{
+    _chunks.clear();
+    _chunkById.clear();
+    _chunkByName.clear();
+}
+
+void SlResourceDatabase::ReindexChunks()
+{
+    _chunkById.clear();
+    _chunkByName.clear();
+    _chunkById.reserve(_chunks.size());
+    _chunkByName.reserve(_chunks.size());
+    for (std::size_t i = 0; i < _chunks.size(); ++i)
+        IndexChunk(i);
+}
+
+void SlResourceDatabase::IndexChunk(std::size_t index)
+{
+    SlResourceChunk const& chunk = _chunks[index];
+    _chunkById.try_emplace(chunk.Id, index);
+    _chunkByName.try_emplace(chunk.Name, index);
 }
 
 } // namespace SlLib::Resources::Database
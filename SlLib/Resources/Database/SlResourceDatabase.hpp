@@ -6,6 +6,8 @@
 #include "SlResourceChunk.hpp"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -14,6 +16,17 @@
 
 namespace SlLib::Resources::Database {
 
+// Stable reference to an owned node. The generation changes when the slot is reused, so a handle to a
+// removed node never resolves to whatever took its place.
+struct SlNodeHandle
+{
+    std::uint32_t Index = UINT32_MAX;
+    std::uint32_t Generation = 0;
+
+    [[nodiscard]] bool IsValid() const { return Index != UINT32_MAX; }
+    bool operator==(SlNodeHandle const&) const = default;
+};
+
 class SlResourceDatabase
 {
 public:
@@ -24,23 +37,51 @@ public:
     SlResourceDatabase& operator=(SlResourceDatabase&&) = default;
 
     [[nodiscard]] SlLib::Resources::Scene::SeNodeBase* FindNode(int uid) const;
+    [[nodiscard]] SlLib::Resources::Scene::SeNodeBase* GetNode(SlNodeHandle handle) const;
+    [[nodiscard]] SlNodeHandle FindNodeHandle(int uid) const;
+    // First chunk with the id/name. The chunk's contents may be edited through the pointer, but not its Id
+    // or Name, which key the indexes.
     [[nodiscard]] SlResourceChunk* FindChunkById(int id);
     [[nodiscard]] SlResourceChunk* FindChunkByName(std::string const& name);
+    [[nodiscard]] std::vector<SlResourceChunk> const& GetChunks() const { return _chunks; }
 
-    void AddOwnedNode(std::unique_ptr<SlLib::Resources::Scene::SeNodeBase> node);
+    SlNodeHandle AddOwnedNode(std::unique_ptr<SlLib::Resources::Scene::SeNodeBase> node);
     void RemoveNode(int uid);
+    void RemoveNode(SlNodeHandle handle);
     void ClearOwnedNodes();
+    [[nodiscard]] std::size_t OwnedNodeCount() const { return _nodeSlots.size() - _freeSlots.size(); }
 
     void AddDefinition(SlLib::Resources::Scene::SeDefinitionNode* definition);
     void AddChunk(SlResourceChunk chunk);
+    // Removes the chunk at `index`; later chunks move down one place. Returns false when out of range.
+    bool RemoveChunk(std::size_t index);
+    bool RemoveChunkById(int id);
+    void ClearChunks();
 
     SlLib::Resources::Scene::SeInstanceSceneNode Scene;
     std::vector<SlLib::Resources::Scene::SeDefinitionNode*> RootDefinitions;
-    std::vector<SlResourceChunk> Chunks;
 
 private:
-    std::unordered_map<int, SlLib::Resources::Scene::SeNodeBase*> _nodeMap;
-    std::vector<std::unique_ptr<SlLib::Resources::Scene::SeNodeBase>> _ownedNodes;
+    struct NodeSlot
+    {
+        std::unique_ptr<SlLib::Resources::Scene::SeNodeBase> Node;
+        std::uint32_t Generation = 0;
+        // Earlier node registered under the same uid; removing the uid frees the whole chain.
+        SlNodeHandle Shadowed;
+    };
+
+    void IndexChunk(std::size_t index);
+    void ReindexChunks();
+    void FreeSlot(SlNodeHandle handle);
+
+    std::unordered_map<int, SlNodeHandle> _nodeMap;
+    std::vector<NodeSlot> _nodeSlots;
+    std::vector<std::uint32_t> _freeSlots;
+
+    std::vector<SlResourceChunk> _chunks;
+    // First chunk with each id/name, matching the old front-to-back scan.
+    std::unordered_map<int, std::size_t> _chunkById;
+    std::unordered_map<std::string, std::size_t> _chunkByName;
 };
 
 } // namespace SlLib::Resources::Database
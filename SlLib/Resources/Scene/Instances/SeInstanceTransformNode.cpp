@@ -24,4 +24,9 @@ int SeInstanceTransformNode::GetSizeForSerialization() const
     return SeInstanceNode::GetSizeForSerialization();
 }
 
+Math::Matrix4x4 SeInstanceTransformNode::GetLocalMatrix() const
+{
+    return Math::CreateTransform(Translation, Rotation, Scale);
+}
+
 } // namespace SlLib::Resources::Scene
@@ -24,6 +24,9 @@ public:
     int InheritTransforms = 1;
     int TransformFlags = 0x7fe;
 
+    Math::Matrix4x4 GetLocalMatrix() const override;
+    bool InheritsParentTransform() const override { return (InheritTransforms & 1) != 0; }
+
     int LoadInternal(Serialization::ResourceLoadContext& context, int offset) override;
     void Save(Serialization::ResourceSaveContext& context, Serialization::ISaveBuffer& buffer) override;
     int GetSizeForSerialization() const override;
@@ -14,10 +14,16 @@ int SeDefinitionTransformNode::LoadInternal(Serialization::ResourceLoadContext&
 
     InheritTransforms = context.ReadBitset32(0xc0);
     TransformFlags = context.ReadBitset32(0xc4);
+    MarkTransformDirty();
 
     return offset + 0x50;
 }
 
+Math::Matrix4x4 SeDefinitionTransformNode::GetLocalMatrix() const
+{
+    return Math::CreateTransform(Translation, Rotation, Scale);
+}
+
 void SeDefinitionTransformNode::Save(Serialization::ResourceSaveContext& context, Serialization::ISaveBuffer& buffer)
 {
     SeDefinitionNode::Save(context, buffer);
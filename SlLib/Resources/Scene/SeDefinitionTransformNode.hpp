@@ -21,6 +21,9 @@ public:
     int InheritTransforms = 1;
     int TransformFlags = 0x7fe;
 
+    Math::Matrix4x4 GetLocalMatrix() const override;
+    bool InheritsParentTransform() const override { return (InheritTransforms & 1) != 0; }
+
 protected:
     int LoadInternal(Serialization::ResourceLoadContext& context, int offset) override;
 
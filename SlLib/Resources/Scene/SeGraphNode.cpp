@@ -1,11 +1,23 @@
 #include "SeGraphNode.hpp"
 
+#include <vector>
+
 namespace SlLib::Resources::Scene {
 
 SeGraphNode::~SeGraphNode()
 {
     SetParent(nullptr);
+    // Orphan the children so they do not unlink themselves from a destroyed parent later.
+    for (SeGraphNode* child = FirstChild; child != nullptr;) {
+        SeGraphNode* next = child->NextSibling;
+        child->Parent = nullptr;
+        child->PrevSibling = nullptr;
+        child->NextSibling = nullptr;
+        child->MarkTransformDirty();
+        child = next;
+    }
     FirstChild = nullptr;
+    LastChild = nullptr;
     PrevSibling = nullptr;
     NextSibling = nullptr;
 }
@@ -20,6 +32,9 @@ void SeGraphNode::SetParent(SeGraphNode* parent)
         if (Parent->FirstChild == this) {
             Parent->FirstChild = NextSibling;
         }
+        if (Parent->LastChild == this) {
+            Parent->LastChild = PrevSibling;
+        }
         if (PrevSibling != nullptr) {
             PrevSibling->NextSibling = NextSibling;
         }
@@ -32,17 +47,95 @@ void SeGraphNode::SetParent(SeGraphNode* parent)
 
     Parent = parent;
     if (parent != nullptr) {
-        if (parent->FirstChild == nullptr) {
+        if (parent->LastChild == nullptr) {
             parent->FirstChild = this;
         } else {
-            SeGraphNode* child = parent->FirstChild;
-            while (child->NextSibling != nullptr) {
-                child = child->NextSibling;
+            parent->LastChild->NextSibling = this;
+            PrevSibling = parent->LastChild;
+        }
+        parent->LastChild = this;
+    }
+
+    MarkTransformDirty();
+}
+
+Math::Matrix4x4 SeGraphNode::GetLocalMatrix() const
+{
+    Math::Matrix4x4 identity{};
+    for (std::size_t i = 0; i < 4; ++i) {
+        identity(i, i) = 1.0f;
+    }
+    return identity;
+}
+
+Math::Matrix4x4 const& SeGraphNode::GetWorldMatrix()
+{
+    if (!_worldDirty) {
+        return _worldMatrix;
+    }
+
+    // Clean ancestors are never below dirty ones, so find the topmost dirty ancestor and work back down.
+    std::vector<SeGraphNode*> chain;
+    for (SeGraphNode* node = this; node != nullptr && node->_worldDirty; node = node->Parent) {
+        chain.push_back(node);
+    }
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        (*it)->RecomputeWorldMatrix();
+    }
+    return _worldMatrix;
+}
+
+void SeGraphNode::MarkTransformDirty()
+{
+    if (_worldDirty) {
+        return;
+    }
+
+    std::vector<SeGraphNode*> stack{this};
+    while (!stack.empty()) {
+        SeGraphNode* node = stack.back();
+        stack.pop_back();
+        node->_worldDirty = true;
+        for (SeGraphNode* child = node->FirstChild; child != nullptr; child = child->NextSibling) {
+            if (!child->_worldDirty) {
+                stack.push_back(child);
             }
-            child->NextSibling = this;
-            PrevSibling = child;
         }
     }
 }
 
+void SeGraphNode::UpdateWorldTransforms(SeGraphNode* root)
+{
+    if (root == nullptr) {
+        return;
+    }
+
+    root->GetWorldMatrix();
+    // Pre-order walk: a node is visited only after its parent has been refreshed.
+    std::vector<SeGraphNode*> stack;
+    for (SeGraphNode* child = root->LastChild; child != nullptr; child = child->PrevSibling) {
+        stack.push_back(child);
+    }
+    while (!stack.empty()) {
+        SeGraphNode* node = stack.back();
+        stack.pop_back();
+        if (node->_worldDirty) {
+            node->RecomputeWorldMatrix();
+        }
+        for (SeGraphNode* child = node->LastChild; child != nullptr; child = child->PrevSibling) {
+            stack.push_back(child);
+        }
+    }
+}
+
+void SeGraphNode::RecomputeWorldMatrix()
+{
+    if (Parent != nullptr && InheritsParentTransform()) {
+        _worldMatrix = Math::Multiply(Parent->_worldMatrix, GetLocalMatrix());
+    } else {
+        _worldMatrix = GetLocalMatrix();
+    }
+    _worldDirty = false;
+}
+
 } // namespace SlLib::Resources::Scene
@@ -2,6 +2,8 @@
 
 #include "SeNodeBase.hpp"
 
+#include "SlLib/Math/Vector.hpp"
+
 namespace SlLib::Resources::Scene {
 
 class SeGraphNode : public SeNodeBase
@@ -9,12 +11,34 @@ class SeGraphNode : public SeNodeBase
 public:
     SeGraphNode* Parent = nullptr;
     SeGraphNode* FirstChild = nullptr;
+    SeGraphNode* LastChild = nullptr;
     SeGraphNode* PrevSibling = nullptr;
     SeGraphNode* NextSibling = nullptr;
 
     virtual ~SeGraphNode();
 
     void SetParent(SeGraphNode* parent);
+
+    // Local transform relative to the parent; identity for nodes without one.
+    virtual Math::Matrix4x4 GetLocalMatrix() const;
+    // When false the local transform is used as the world transform.
+    virtual bool InheritsParentTransform() const { return true; }
+
+    // Cached local-to-world matrix, recomputed along the dirty part of the parent chain on demand.
+    Math::Matrix4x4 const& GetWorldMatrix();
+    // Call after changing the local transform; invalidates this node and every descendant.
+    void MarkTransformDirty();
+    [[nodiscard]] bool IsTransformDirty() const { return _worldDirty; }
+
+    // Refreshes every dirty world matrix under `root` (inclusive), parents before children.
+    static void UpdateWorldTransforms(SeGraphNode* root);
+
+private:
+    void RecomputeWorldMatrix();
+
+    // Invariant: a dirty node's descendants are all dirty, so invalidation can stop at a dirty subtree.
+    Math::Matrix4x4 _worldMatrix{};
+    bool _worldDirty = true;
 };
 
 } // namespace SlLib::Resources::Scene
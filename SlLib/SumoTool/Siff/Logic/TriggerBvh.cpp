@@ -0,0 +1,372 @@
+#include "TriggerBvh.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Trigger.hpp"
+
+namespace SlLib::SumoTool::Siff::Logic {
+
+namespace {
+
+using SlLib::Math::Aabb;
+using SlLib::Math::Vector3;
+
+constexpr std::size_t kMaxTraversalDepth = 64;
+
+Vector3 ToVector3(SlLib::Math::Vector4 const& value)
+{
+    return {value.X, value.Y, value.Z};
+}
+
+void Expand(Aabb& box, Vector3 const& point)
+{
+    box.Min = {std::min(box.Min.X, point.X), std::min(box.Min.Y, point.Y), std::min(box.Min.Z, point.Z)};
+    box.Max = {std::max(box.Max.X, point.X), std::max(box.Max.Y, point.Y), std::max(box.Max.Z, point.Z)};
+}
+
+void Expand(Aabb& box, Aabb const& other)
+{
+    Expand(box, other.Min);
+    Expand(box, other.Max);
+}
+
+float Axis(Vector3 const& value, int axis)
+{
+    return axis == 0 ? value.X : (axis == 1 ? value.Y : value.Z);
+}
+
+bool BoxContains(Aabb const& box, Vector3 const& point)
+{
+    return point.X >= box.Min.X && point.X <= box.Max.X && point.Y >= box.Min.Y && point.Y <= box.Max.Y &&
+           point.Z >= box.Min.Z && point.Z <= box.Max.Z;
+}
+
+bool SegmentOverlapsBox(Aabb const& box, Vector3 const& a, Vector3 const& b)
+{
+    float enter = 0.0f;
+    float exit = 1.0f;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const float origin = Axis(a, axis);
+        const float delta = Axis(b, axis) - origin;
+        const float lo = Axis(box.Min, axis);
+        const float hi = Axis(box.Max, axis);
+        if (delta == 0.0f)
+        {
+            if (origin < lo || origin > hi)
+                return false;
+            continue;
+        }
+        float t0 = (lo - origin) / delta;
+        float t1 = (hi - origin) / delta;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        enter = std::max(enter, t0);
+        exit = std::min(exit, t1);
+        if (enter > exit)
+            return false;
+    }
+    return true;
+}
+
+struct Plane
+{
+    Vector3 Normal{};
+    float W = 0.0f;
+};
+
+// The trigger's prism as inward planes (inside where dot(Normal, p) + W >= 0) and its bounds. Matches the
+// box CharmyBee draws: the quad pushed along the normal by max(1, |normal|).
+bool MakeVolume(Trigger const& trigger, std::array<Plane, 6>& planes, Aabb& bounds)
+{
+    const std::array<Vector3, 4> quad{ToVector3(trigger.Vertex0), ToVector3(trigger.Vertex1),
+                                      ToVector3(trigger.Vertex2), ToVector3(trigger.Vertex3)};
+    const Vector3 position = ToVector3(trigger.Position);
+    bounds = {position, position};
+
+    Vector3 normal = ToVector3(trigger.Normal);
+    float length = SlLib::Math::length(normal);
+    const float depth = std::max(1.0f, length);
+    if (length <= 1e-4f)
+    {
+        normal = SlLib::Math::cross(quad[1] - quad[0], quad[3] - quad[0]);
+        length = SlLib::Math::length(normal);
+        if (length <= 1e-4f)
+            return false;
+    }
+    const Vector3 direction = normal * (1.0f / length);
+
+    // The slab starts at the lowest corner so a quad not quite square to its normal still lies inside.
+    float base = std::numeric_limits<float>::max();
+    for (Vector3 const& corner : quad)
+        base = std::min(base, SlLib::Math::dot(direction, corner));
+    planes[0] = {direction, -base};
+    planes[1] = {direction * -1.0f, base + depth};
+
+    const Vector3 centroid = (quad[0] + quad[1] + quad[2] + quad[3]) * 0.25f;
+    for (std::size_t k = 0; k < 4; ++k)
+    {
+        Vector3 side = SlLib::Math::cross(direction, quad[(k + 1) % 4] - quad[k]);
+        const float sideLength = SlLib::Math::length(side);
+        if (sideLength <= 1e-6f)
+        {
+            planes[2 + k] = {{0.0f, 0.0f, 0.0f}, 0.0f}; // collapsed edge: no constraint
+            continue;
+        }
+        side = side * (1.0f / sideLength);
+        if (SlLib::Math::dot(side, centroid - quad[k]) < 0.0f)
+            side = side * -1.0f;
+        planes[2 + k] = {side, -SlLib::Math::dot(side, quad[k])};
+    }
+
+    // The volume's corners: each quad corner moved along the normal onto both slab faces.
+    for (Vector3 const& corner : quad)
+    {
+        const Vector3 bottom = corner + direction * (base - SlLib::Math::dot(direction, corner));
+        Expand(bounds, bottom);
+        Expand(bounds, bottom + direction * depth);
+    }
+    return true;
+}
+
+} // namespace
+
+void TriggerBvh::Clear()
+{
+    _nodes.clear();
+    _triggerOf.clear();
+    _slotOf.clear();
+    for (PlaneLanes& plane : _planes)
+    {
+        for (std::vector<float>& lane : plane)
+            lane.clear();
+    }
+}
+
+void TriggerBvh::Build(std::span<const std::shared_ptr<Trigger>> triggers)
+{
+    Clear();
+    const auto count = static_cast<std::uint32_t>(triggers.size());
+    _slotOf.assign(count, 0);
+    if (count == 0)
+        return;
+
+    std::vector<std::array<Plane, 6>> volumes(count);
+    std::vector<Aabb> bounds(count);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        bool valid = triggers[i] != nullptr && MakeVolume(*triggers[i], volumes[i], bounds[i]);
+        if (!valid)
+        {
+            // Never contains anything: a zero normal with a negative offset fails every point.
+            volumes[i].fill(Plane{{0.0f, 0.0f, 0.0f}, -1.0f});
+            if (triggers[i] == nullptr)
+                bounds[i] = {};
+        }
+    }
+
+    std::vector<std::uint32_t> order(count);
+    for (std::uint32_t i = 0; i < count; ++i)
+        order[i] = i;
+    _nodes.reserve(2 * (count / kLeafSize + 1));
+    BuildNode(order, bounds, 0, count);
+
+    _triggerOf = std::move(order);
+    for (PlaneLanes& plane : _planes)
+    {
+        for (std::vector<float>& lane : plane)
+            lane.resize(count);
+    }
+    for (std::uint32_t slot = 0; slot < count; ++slot)
+    {
+        const std::uint32_t trigger = _triggerOf[slot];
+        _slotOf[trigger] = slot;
+        for (std::size_t j = 0; j < kPlaneCount; ++j)
+        {
+            Plane const& plane = volumes[trigger][j];
+            _planes[j][0][slot] = plane.Normal.X;
+            _planes[j][1][slot] = plane.Normal.Y;
+            _planes[j][2][slot] = plane.Normal.Z;
+            _planes[j][3][slot] = plane.W;
+        }
+    }
+}
+
+std::uint32_t TriggerBvh::BuildNode(std::vector<std::uint32_t>& order,
+                                    std::vector<Aabb> const& bounds,
+                                    std::uint32_t start,
+                                    std::uint32_t count)
+{
+    const auto index = static_cast<std::uint32_t>(_nodes.size());
+    _nodes.emplace_back();
+
+    Aabb box = bounds[order[start]];
+    Aabb centers{box.Min + (box.Max - box.Min) * 0.5f, box.Min + (box.Max - box.Min) * 0.5f};
+    for (std::uint32_t i = start; i < start + count; ++i)
+    {
+        Aabb const& item = bounds[order[i]];
+        Expand(box, item);
+        Expand(centers, item.Min + (item.Max - item.Min) * 0.5f);
+    }
+    _nodes[index].Bounds = box;
+
+    if (count <= kLeafSize)
+    {
+        _nodes[index].Start = start;
+        _nodes[index].Count = count;
+        return index;
+    }
+
+    // Median split on the axis where the item centres spread furthest.
+    const Vector3 extent = centers.Max - centers.Min;
+    const int axis = extent.X >= extent.Y && extent.X >= extent.Z ? 0 : (extent.Y >= extent.Z ? 1 : 2);
+    const std::uint32_t half = count / 2;
+    std::nth_element(order.begin() + start, order.begin() + start + half, order.begin() + start + count,
+                     [&](std::uint32_t a, std::uint32_t b) {
+                         return Axis(bounds[a].Min, axis) + Axis(bounds[a].Max, axis) <
+                                Axis(bounds[b].Min, axis) + Axis(bounds[b].Max, axis);
+                     });
+
+    BuildNode(order, bounds, start, half);
+    const std::uint32_t right = BuildNode(order, bounds, start + half, count - half);
+    _nodes[index].Start = right;
+    _nodes[index].Count = 0;
+    return index;
+}
+
+template <typename NodeTest, typename LeafVisitor>
+void TriggerBvh::Traverse(NodeTest const& nodeTest, LeafVisitor const& visitor) const
+{
+    if (_nodes.empty())
+        return;
+
+    std::array<std::uint32_t, kMaxTraversalDepth> stack;
+    std::size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const std::uint32_t index = stack[--top];
+        Node const& node = _nodes[index];
+        if (!nodeTest(node.Bounds))
+            continue;
+        if (node.Count > 0)
+        {
+            visitor(node.Start, node.Count);
+            continue;
+        }
+        stack[top++] = node.Start;
+        stack[top++] = index + 1;
+    }
+}
+
+void TriggerBvh::LeafDistances(std::uint32_t start,
+                               std::uint32_t count,
+                               Vector3 point,
+                               std::array<float, kLeafSize>& distances) const
+{
+    distances.fill(std::numeric_limits<float>::max());
+    for (std::size_t j = 0; j < kPlaneCount; ++j)
+    {
+        float const* nx = _planes[j][0].data() + start;
+        float const* ny = _planes[j][1].data() + start;
+        float const* nz = _planes[j][2].data() + start;
+        float const* w = _planes[j][3].data() + start;
+        for (std::uint32_t s = 0; s < count; ++s)
+            distances[s] = std::min(distances[s], nx[s] * point.X + ny[s] * point.Y + nz[s] * point.Z + w[s]);
+    }
+}
+
+float TriggerBvh::SlotEnter(std::uint32_t slot, Vector3 a, Vector3 b) const
+{
+    // Clip the segment against each plane in turn.
+    float enter = 0.0f;
+    float exit = 1.0f;
+    for (std::size_t j = 0; j < kPlaneCount; ++j)
+    {
+        PlaneLanes const& plane = _planes[j];
+        const float da = plane[0][slot] * a.X + plane[1][slot] * a.Y + plane[2][slot] * a.Z + plane[3][slot];
+        const float db = plane[0][slot] * b.X + plane[1][slot] * b.Y + plane[2][slot] * b.Z + plane[3][slot];
+        if (da < 0.0f && db < 0.0f)
+            return -1.0f;
+        if (da < 0.0f)
+            enter = std::max(enter, da / (da - db));
+        else if (db < 0.0f)
+            exit = std::min(exit, da / (da - db));
+        if (enter > exit)
+            return -1.0f;
+    }
+    return enter;
+}
+
+bool TriggerBvh::Contains(std::uint32_t trigger, Vector3 point) const
+{
+    if (trigger >= _slotOf.size())
+        return false;
+    std::array<float, kLeafSize> distances;
+    LeafDistances(_slotOf[trigger], 1, point, distances);
+    return distances[0] >= 0.0f;
+}
+
+void TriggerBvh::QueryPoint(Vector3 point, std::vector<std::uint32_t>& triggers) const
+{
+    triggers.clear();
+    std::array<float, kLeafSize> distances;
+    Traverse([&](Aabb const& box) { return BoxContains(box, point); },
+             [&](std::uint32_t start, std::uint32_t count) {
+                 LeafDistances(start, count, point, distances);
+                 for (std::uint32_t s = 0; s < count; ++s)
+                 {
+                     if (distances[s] >= 0.0f)
+                         triggers.push_back(_triggerOf[start + s]);
+                 }
+             });
+    std::sort(triggers.begin(), triggers.end());
+}
+
+void TriggerBvh::ContainsBatch(std::span<const Vector3> points, std::vector<TriggerHit>& hits) const
+{
+    hits.clear();
+    std::vector<std::uint32_t> inside;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        QueryPoint(points[i], inside);
+        for (std::uint32_t trigger : inside)
+            hits.push_back({static_cast<std::uint32_t>(i), trigger, 0.0f});
+    }
+}
+
+void TriggerBvh::SweepBatch(std::span<const Vector3> path, std::vector<TriggerHit>& hits) const
+{
+    hits.clear();
+    if (path.size() < 2)
+        return;
+
+    std::array<float, kLeafSize> distances;
+    for (std::size_t i = 0; i + 1 < path.size(); ++i)
+    {
+        const Vector3 a = path[i];
+        const Vector3 b = path[i + 1];
+        const std::size_t first = hits.size();
+        Traverse([&](Aabb const& box) { return SegmentOverlapsBox(box, a, b); },
+                 [&](std::uint32_t start, std::uint32_t count) {
+                     LeafDistances(start, count, a, distances);
+                     for (std::uint32_t s = 0; s < count; ++s)
+                     {
+                         // Already inside at the segment start: that entry belongs to an earlier segment.
+                         if (distances[s] >= 0.0f && i > 0)
+                             continue;
+                         const float enter = SlotEnter(start + s, a, b);
+                         if (enter >= 0.0f)
+                             hits.push_back({static_cast<std::uint32_t>(i), _triggerOf[start + s], enter});
+                     }
+                 });
+        std::sort(hits.begin() + static_cast<std::ptrdiff_t>(first), hits.end(),
+                  [](TriggerHit const& x, TriggerHit const& y) {
+                      return x.T != y.T ? x.T < y.T : x.Trigger < y.Trigger;
+                  });
+    }
+}
+
+} // namespace SlLib::SumoTool::Siff::Logic
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "SlLib/Math/LooseOctree.hpp"
+#include "SlLib/Math/Vector.hpp"
+
+namespace SlLib::SumoTool::Siff::Logic {
+
+class Trigger;
+
+struct TriggerHit
+{
+    std::uint32_t Sample = 0;  // index of the point, or of the segment's start point
+    std::uint32_t Trigger = 0; // index into the trigger list the BVH was built from
+    float T = 0.0f;            // where along the segment the trigger is entered; 0 for point tests
+};
+
+// Bounding volume hierarchy over logic trigger volumes for bulk containment tests. A trigger's volume is
+// its quad extruded along the normal by the normal's length (at least 1 unit), as the editor draws it,
+// stored as six inward-facing planes. Leaves hold a few triggers whose planes sit side by side
+// in structure-of-arrays form, so a leaf is tested with straight-line loops the compiler can vectorise.
+class TriggerBvh
+{
+public:
+    void Build(std::span<const std::shared_ptr<Trigger>> triggers);
+    void Clear();
+
+    [[nodiscard]] bool Empty() const { return _nodes.empty(); }
+    [[nodiscard]] std::size_t TriggerCount() const { return _slotOf.size(); }
+
+    bool Contains(std::uint32_t trigger, SlLib::Math::Vector3 point) const;
+    // Indices of the triggers containing `point`, ascending.
+    void QueryPoint(SlLib::Math::Vector3 point, std::vector<std::uint32_t>& triggers) const;
+    // Every (point, trigger) containment pair, ordered by point then trigger.
+    void ContainsBatch(std::span<const SlLib::Math::Vector3> points, std::vector<TriggerHit>& hits) const;
+    // Treats consecutive points as a path and reports each time a segment enters a trigger: the segment
+    // starts outside the volume and reaches it, or, for the first segment only, starts inside. Hits are
+    // ordered by segment, then by entry point along it.
+    void SweepBatch(std::span<const SlLib::Math::Vector3> path, std::vector<TriggerHit>& hits) const;
+
+private:
+    static constexpr std::size_t kPlaneCount = 6;
+    static constexpr std::uint32_t kLeafSize = 4;
+
+    struct Node
+    {
+        SlLib::Math::Aabb Bounds{};
+        std::uint32_t Start = 0; // first slot of a leaf, right child of an inner node
+        std::uint32_t Count = 0; // 0 for inner nodes, whose left child directly follows them
+    };
+
+    // Component k of plane j of the trigger in slot s is _planes[j][k][s].
+    using PlaneLanes = std::array<std::vector<float>, 4>;
+
+    std::uint32_t BuildNode(std::vector<std::uint32_t>& order,
+                            std::vector<SlLib::Math::Aabb> const& bounds,
+                            std::uint32_t start,
+                            std::uint32_t count);
+    template <typename NodeTest, typename LeafVisitor>
+    void Traverse(NodeTest const& nodeTest, LeafVisitor const& visitor) const;
+    // Smallest plane distance of `point` for each slot of a leaf; the point is inside where it is >= 0.
+    void LeafDistances(std::uint32_t start,
+                       std::uint32_t count,
+                       SlLib::Math::Vector3 point,
+                       std::array<float, kLeafSize>& distances) const;
+    // Entry parameter of segment a->b into the slot's volume, or a negative value when it misses.
+    float SlotEnter(std::uint32_t slot, SlLib::Math::Vector3 a, SlLib::Math::Vector3 b) const;
+
+    std::vector<Node> _nodes;
+    std::vector<std::uint32_t> _triggerOf; // slot -> trigger index
+    std::vector<std::uint32_t> _slotOf;    // trigger index -> slot
+    std::array<PlaneLanes, kPlaneCount> _planes;
+};
+
+} // namespace SlLib::SumoTool::Siff::Logic
@@ -0,0 +1,256 @@
+#include "NavGraph.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include "NavWaypoint.hpp"
+#include "NavWaypointLink.hpp"
+#include "SlLib/SumoTool/Siff/Navigation.hpp"
+
+namespace SlLib::SumoTool::Siff::NavData {
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+using QueueEntry = std::pair<float, std::uint32_t>;
+using MinQueue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+struct RawEdge
+{
+    std::uint32_t From = 0;
+    std::uint32_t To = 0;
+    float Weight = 0.0f;
+    std::uint32_t Link = 0;
+};
+
+// Counting sort of the edges by `key` into CSR offsets and edge records.
+template <typename Key, typename Target>
+void BuildRows(std::vector<RawEdge> const& raw,
+               std::size_t nodeCount,
+               Key key,
+               Target target,
+               std::vector<std::uint32_t>& offsets,
+               std::vector<NavGraph::Edge>& edges)
+{
+    offsets.assign(nodeCount + 1, 0);
+    for (RawEdge const& edge : raw)
+        ++offsets[key(edge) + 1];
+    for (std::size_t i = 1; i <= nodeCount; ++i)
+        offsets[i] += offsets[i - 1];
+
+    edges.resize(raw.size());
+    std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (RawEdge const& edge : raw)
+        edges[cursor[key(edge)]++] = NavGraph::Edge{target(edge), edge.Weight, edge.Link};
+}
+
+} // namespace
+
+void NavGraph::Clear()
+{
+    _positions.clear();
+    _waypoints.clear();
+    _offsets.assign(1, 0);
+    _edges.clear();
+    _reverseOffsets.assign(1, 0);
+    _reverseEdges.clear();
+    _indexByWaypoint.clear();
+    _heuristicScale = 1.0f;
+}
+
+void NavGraph::Build(SlLib::SumoTool::Siff::Navigation const& navigation)
+{
+    Clear();
+
+    auto addNode = [&](NavWaypoint const* waypoint) {
+        auto [it, inserted] = _indexByWaypoint.emplace(waypoint, static_cast<std::uint32_t>(_positions.size()));
+        if (inserted)
+        {
+            _positions.push_back(waypoint->Pos);
+            _waypoints.push_back(waypoint);
+        }
+        return it->second;
+    };
+    for (auto const& waypoint : navigation.Waypoints)
+    {
+        if (waypoint)
+            addNode(waypoint.get());
+    }
+
+    std::vector<RawEdge> raw;
+    raw.reserve(navigation.Links.size());
+    for (std::size_t i = 0; i < navigation.Links.size(); ++i)
+    {
+        NavWaypointLink const* link = navigation.Links[i].get();
+        if (link == nullptr || link->From == nullptr || link->To == nullptr)
+            continue;
+
+        RawEdge edge;
+        edge.From = addNode(link->From);
+        edge.To = addNode(link->To);
+        edge.Link = static_cast<std::uint32_t>(i);
+        const float straight = SlLib::Math::length(link->To->Pos - link->From->Pos);
+        edge.Weight = link->Length > 0.0f ? link->Length : straight;
+        if (straight > 0.0f)
+            _heuristicScale = std::min(_heuristicScale, edge.Weight / straight);
+        raw.push_back(edge);
+    }
+
+    const std::size_t nodeCount = _positions.size();
+    BuildRows(
+        raw, nodeCount, [](RawEdge const& e) { return e.From; }, [](RawEdge const& e) { return e.To; }, _offsets,
+        _edges);
+    BuildRows(
+        raw, nodeCount, [](RawEdge const& e) { return e.To; }, [](RawEdge const& e) { return e.From; },
+        _reverseOffsets, _reverseEdges);
+}
+
+std::uint32_t NavGraph::IndexOf(NavWaypoint const* waypoint) const
+{
+    auto it = _indexByWaypoint.find(waypoint);
+    return it != _indexByWaypoint.end() ? it->second : InvalidIndex;
+}
+
+std::span<const NavGraph::Edge> NavGraph::OutEdges(std::uint32_t node) const
+{
+    if (node >= NodeCount())
+        return {};
+    return std::span<const Edge>(_edges).subspan(_offsets[node], _offsets[node + 1] - _offsets[node]);
+}
+
+std::span<const NavGraph::Edge> NavGraph::InEdges(std::uint32_t node) const
+{
+    if (node >= NodeCount())
+        return {};
+    return std::span<const Edge>(_reverseEdges)
+        .subspan(_reverseOffsets[node], _reverseOffsets[node + 1] - _reverseOffsets[node]);
+}
+
+bool NavGraph::FindPath(std::uint32_t start, std::uint32_t goal, NavPath& path) const
+{
+    path = {};
+    const std::size_t nodeCount = NodeCount();
+    if (start >= nodeCount || goal >= nodeCount)
+        return false;
+
+    const SlLib::Math::Vector3 goalPosition = _positions[goal];
+    auto heuristic = [&](std::uint32_t node) {
+        return SlLib::Math::length(goalPosition - _positions[node]) * _heuristicScale;
+    };
+
+    std::vector<float> cost(nodeCount, kInfinity);
+    std::vector<std::uint32_t> parent(nodeCount, InvalidIndex);
+    std::vector<std::uint32_t> parentLink(nodeCount, InvalidIndex);
+    MinQueue open;
+    cost[start] = 0.0f;
+    open.emplace(heuristic(start), start);
+    while (!open.empty())
+    {
+        auto [estimate, node] = open.top();
+        open.pop();
+        if (node == goal)
+            break;
+        if (estimate > cost[node] + heuristic(node))
+            continue; // stale entry
+
+        for (std::uint32_t i = _offsets[node]; i < _offsets[node + 1]; ++i)
+        {
+            Edge const& edge = _edges[i];
+            const float next = cost[node] + edge.Weight;
+            if (next < cost[edge.Target])
+            {
+                cost[edge.Target] = next;
+                parent[edge.Target] = node;
+                parentLink[edge.Target] = edge.Link;
+                open.emplace(next + heuristic(edge.Target), edge.Target);
+            }
+        }
+    }
+    if (cost[goal] == kInfinity)
+        return false;
+
+    for (std::uint32_t node = goal; node != start; node = parent[node])
+    {
+        path.Waypoints.push_back(node);
+        path.Links.push_back(parentLink[node]);
+    }
+    path.Waypoints.push_back(start);
+    std::reverse(path.Waypoints.begin(), path.Waypoints.end());
+    std::reverse(path.Links.begin(), path.Links.end());
+    path.Length = cost[goal];
+    return true;
+}
+
+void NavGraph::ShortestPaths(std::span<const std::uint32_t> sources,
+                             NavShortestPaths& result,
+                             bool reverse,
+                             float maxDistance) const
+{
+    const std::size_t nodeCount = NodeCount();
+    result.Distance.assign(nodeCount, kInfinity);
+    result.Parent.assign(nodeCount, InvalidIndex);
+    result.ParentLink.assign(nodeCount, InvalidIndex);
+    result.Source.assign(nodeCount, InvalidIndex);
+    result.Reverse = reverse;
+
+    std::vector<std::uint32_t> const& offsets = reverse ? _reverseOffsets : _offsets;
+    std::vector<Edge> const& edges = reverse ? _reverseEdges : _edges;
+
+    MinQueue open;
+    for (std::uint32_t source : sources)
+    {
+        if (source >= nodeCount || result.Distance[source] == 0.0f)
+            continue;
+        result.Distance[source] = 0.0f;
+        result.Source[source] = source;
+        open.emplace(0.0f, source);
+    }
+
+    while (!open.empty())
+    {
+        auto [distance, node] = open.top();
+        open.pop();
+        if (distance > result.Distance[node])
+            continue; // stale entry
+
+        for (std::uint32_t i = offsets[node]; i < offsets[node + 1]; ++i)
+        {
+            Edge const& edge = edges[i];
+            const float next = distance + edge.Weight;
+            if (next < result.Distance[edge.Target] && next <= maxDistance)
+            {
+                result.Distance[edge.Target] = next;
+                result.Parent[edge.Target] = node;
+                result.ParentLink[edge.Target] = edge.Link;
+                result.Source[edge.Target] = result.Source[node];
+                open.emplace(next, edge.Target);
+            }
+        }
+    }
+}
+
+bool NavShortestPaths::PathTo(std::uint32_t node, NavPath& path) const
+{
+    path = {};
+    if (!Reached(node))
+        return false;
+
+    for (std::uint32_t current = node; Parent[current] != NavGraph::InvalidIndex; current = Parent[current])
+    {
+        path.Waypoints.push_back(current);
+        path.Links.push_back(ParentLink[current]);
+    }
+    path.Waypoints.push_back(Source[node]);
+    if (!Reverse)
+    {
+        std::reverse(path.Waypoints.begin(), path.Waypoints.end());
+        std::reverse(path.Links.begin(), path.Links.end());
+    }
+    path.Length = Distance[node];
+    return true;
+}
+
+} // namespace SlLib::SumoTool::Siff::NavData
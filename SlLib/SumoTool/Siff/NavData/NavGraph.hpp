@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "../../../Math/Vector.hpp"
+
+namespace SlLib::SumoTool::Siff {
+class Navigation;
+}
+
+namespace SlLib::SumoTool::Siff::NavData {
+
+class NavWaypoint;
+
+struct NavPath
+{
+    std::vector<std::uint32_t> Waypoints; // graph node indices, start to goal
+    std::vector<std::uint32_t> Links;     // Navigation::Links index of each step
+    float Length = 0.0f;
+};
+
+// Result of a multi-source search. Following Parent from a node leads back to the source it was reached from.
+struct NavShortestPaths
+{
+    std::vector<float> Distance;
+    std::vector<std::uint32_t> Parent;
+    std::vector<std::uint32_t> ParentLink;
+    std::vector<std::uint32_t> Source;
+    bool Reverse = false;
+
+    [[nodiscard]] bool Reached(std::uint32_t node) const
+    {
+        return node < Distance.size() && Distance[node] != std::numeric_limits<float>::infinity();
+    }
+    // Path between `node` and its source, in travel order (source first for forward searches, `node` first for
+    // reverse ones). False when the node was not reached.
+    bool PathTo(std::uint32_t node, NavPath& path) const;
+};
+
+// Directed waypoint graph in compressed sparse row form: node i's outgoing edges are
+// Edges[Offsets[i] .. Offsets[i + 1]), with the incoming edges kept the same way for reverse searches. Nodes
+// are Navigation::Waypoints in order, followed by any waypoint reached only through a link. Edge weights are
+// link lengths (the endpoint distance when a link has none).
+class NavGraph
+{
+public:
+    static constexpr std::uint32_t InvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+    struct Edge
+    {
+        std::uint32_t Target = InvalidIndex;
+        float Weight = 0.0f;
+        std::uint32_t Link = InvalidIndex;
+    };
+
+    void Build(SlLib::SumoTool::Siff::Navigation const& navigation);
+    void Clear();
+
+    [[nodiscard]] std::size_t NodeCount() const { return _positions.size(); }
+    [[nodiscard]] std::size_t EdgeCount() const { return _edges.size(); }
+    [[nodiscard]] std::uint32_t IndexOf(NavWaypoint const* waypoint) const;
+    [[nodiscard]] SlLib::Math::Vector3 const& Position(std::uint32_t node) const { return _positions[node]; }
+    // The waypoint node `node` was built from; valid as long as the Navigation passed to Build.
+    [[nodiscard]] NavWaypoint const* WaypointOf(std::uint32_t node) const { return _waypoints[node]; }
+    [[nodiscard]] std::span<const Edge> OutEdges(std::uint32_t node) const;
+    [[nodiscard]] std::span<const Edge> InEdges(std::uint32_t node) const;
+
+    // A* with a straight-line heuristic, scaled down where links are shorter than their endpoint distance so
+    // it stays admissible. Returns false when `goal` cannot be reached.
+    bool FindPath(std::uint32_t start, std::uint32_t goal, NavPath& path) const;
+
+    // Dijkstra from every source at once: each node gets its distance from the nearest source. `reverse`
+    // follows links backwards, giving the distance from each node to the nearest source instead. Nodes
+    // further than `maxDistance` are left unreached.
+    void ShortestPaths(std::span<const std::uint32_t> sources,
+                       NavShortestPaths& result,
+                       bool reverse = false,
+                       float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+private:
+    std::vector<SlLib::Math::Vector3> _positions;
+    std::vector<NavWaypoint const*> _waypoints;
+    std::vector<std::uint32_t> _offsets;
+    std::vector<Edge> _edges;
+    std::vector<std::uint32_t> _reverseOffsets;
+    std::vector<Edge> _reverseEdges;
+    std::unordered_map<NavWaypoint const*, std::uint32_t> _indexByWaypoint;
+    float _heuristicScale = 1.0f;
+};
+
+} // namespace SlLib::SumoTool::Siff::NavData
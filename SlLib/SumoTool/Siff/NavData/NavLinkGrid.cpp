@@ -0,0 +1,235 @@
+#include "NavLinkGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "NavWaypoint.hpp"
+#include "NavWaypointLink.hpp"
+#include "SlLib/SumoTool/Siff/Navigation.hpp"
+
+namespace SlLib::SumoTool::Siff::NavData {
+
+namespace {
+
+using SlLib::Math::Vector3;
+
+constexpr std::size_t kMaxCells = std::size_t{1} << 22;
+
+} // namespace
+
+void NavLinkGrid::Clear()
+{
+    _links.clear();
+    _cellStart.clear();
+    _cellLinks.clear();
+    _cellsX = 0;
+    _cellsZ = 0;
+}
+
+void NavLinkGrid::Build(SlLib::SumoTool::Siff::Navigation const& navigation, float cellSize)
+{
+    Clear();
+    _totalTrackDist = navigation.TotalTrackDist;
+
+    for (std::size_t i = 0; i < navigation.Links.size(); ++i)
+    {
+        NavWaypointLink const* link = navigation.Links[i].get();
+        if (link == nullptr || link->From == nullptr || link->To == nullptr)
+            continue;
+
+        Segment segment;
+        segment.LinkIndex = static_cast<int>(i);
+        segment.From = link->From->Pos;
+        segment.Delta = link->To->Pos - link->From->Pos;
+        const float lengthSquared = SlLib::Math::dot(segment.Delta, segment.Delta);
+        segment.InvLengthSquared = lengthSquared > 0.0f ? 1.0f / lengthSquared : 0.0f;
+
+        // Lateral axis: the cross-section direction with any along-track component removed.
+        Vector3 forward = SlLib::Math::normalize(segment.Delta);
+        Vector3 across = link->Right - link->Left;
+        across = across - forward * SlLib::Math::dot(across, forward);
+        if (SlLib::Math::dot(across, across) < 1e-8f)
+            across = SlLib::Math::cross(link->From->Up, forward);
+        segment.Lateral = SlLib::Math::normalize(across);
+
+        segment.StartDist = link->From->TrackDist;
+        float span = link->To->TrackDist - link->From->TrackDist;
+        if (span < 0.0f && _totalTrackDist > 0.0f)
+            span += _totalTrackDist; // link crossing the start line
+        if (span <= 0.0f)
+            span = std::sqrt(lengthSquared);
+        segment.TrackLength = span;
+        _links.push_back(segment);
+    }
+    if (_links.empty())
+        return;
+
+    float minX = std::numeric_limits<float>::max();
+    float minZ = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxZ = std::numeric_limits<float>::lowest();
+    for (Segment const& segment : _links)
+    {
+        Vector3 to = segment.From + segment.Delta;
+        minX = std::min({minX, segment.From.X, to.X});
+        maxX = std::max({maxX, segment.From.X, to.X});
+        minZ = std::min({minZ, segment.From.Z, to.Z});
+        maxZ = std::max({maxZ, segment.From.Z, to.Z});
+    }
+
+    const float width = std::max(maxX - minX, 1.0f);
+    const float depth = std::max(maxZ - minZ, 1.0f);
+    if (cellSize <= 0.0f)
+        cellSize = std::sqrt(width * depth / static_cast<float>(_links.size()));
+    cellSize = std::max(cellSize, 1.0f);
+    while (static_cast<std::size_t>(width / cellSize + 1.0f) * static_cast<std::size_t>(depth / cellSize + 1.0f) > kMaxCells)
+        cellSize *= 2.0f;
+
+    _minX = minX;
+    _minZ = minZ;
+    _cellSize = cellSize;
+    _cellsX = static_cast<int>(width / cellSize) + 1;
+    _cellsZ = static_cast<int>(depth / cellSize) + 1;
+
+    // Two passes over the links' XZ bounds: count per cell, then fill the flattened lists.
+    auto cellRange = [&](Segment const& segment, int& x0, int& z0, int& x1, int& z1) {
+        Vector3 to = segment.From + segment.Delta;
+        x0 = static_cast<int>((std::min(segment.From.X, to.X) - _minX) / _cellSize);
+        x1 = static_cast<int>((std::max(segment.From.X, to.X) - _minX) / _cellSize);
+        z0 = static_cast<int>((std::min(segment.From.Z, to.Z) - _minZ) / _cellSize);
+        z1 = static_cast<int>((std::max(segment.From.Z, to.Z) - _minZ) / _cellSize);
+        x0 = std::clamp(x0, 0, _cellsX - 1);
+        x1 = std::clamp(x1, 0, _cellsX - 1);
+        z0 = std::clamp(z0, 0, _cellsZ - 1);
+        z1 = std::clamp(z1, 0, _cellsZ - 1);
+    };
+
+    const std::size_t cellCount = static_cast<std::size_t>(_cellsX) * static_cast<std::size_t>(_cellsZ);
+    _cellStart.assign(cellCount + 1, 0);
+    for (Segment const& segment : _links)
+    {
+        int x0, z0, x1, z1;
+        cellRange(segment, x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                ++_cellStart[static_cast<std::size_t>(z) * _cellsX + x + 1];
+    }
+    for (std::size_t i = 1; i <= cellCount; ++i)
+        _cellStart[i] += _cellStart[i - 1];
+
+    _cellLinks.resize(_cellStart.back());
+    std::vector<std::uint32_t> cursor(_cellStart.begin(), _cellStart.end() - 1);
+    for (std::size_t i = 0; i < _links.size(); ++i)
+    {
+        int x0, z0, x1, z1;
+        cellRange(_links[i], x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                _cellLinks[cursor[static_cast<std::size_t>(z) * _cellsX + x]++] = static_cast<std::uint32_t>(i);
+    }
+}
+
+float NavLinkGrid::DistanceSquared(Segment const& segment, Vector3 position, float& t) const
+{
+    Vector3 offset = position - segment.From;
+    t = std::clamp(SlLib::Math::dot(offset, segment.Delta) * segment.InvLengthSquared, 0.0f, 1.0f);
+    Vector3 diff = offset - segment.Delta * t;
+    return SlLib::Math::dot(diff, diff);
+}
+
+void NavLinkGrid::Resolve(std::size_t index, Vector3 position, float t, NavTrackPosition& result) const
+{
+    Segment const& segment = _links[index];
+    result.Link = segment.LinkIndex;
+    result.LinkT = t;
+    result.Projected = segment.From + segment.Delta * t;
+    result.Distance = SlLib::Math::length(position - result.Projected);
+    result.LateralOffset = SlLib::Math::dot(position - result.Projected, segment.Lateral);
+    result.TrackDist = segment.StartDist + segment.TrackLength * t;
+    if (_totalTrackDist > 0.0f && result.TrackDist >= _totalTrackDist)
+        result.TrackDist -= _totalTrackDist;
+}
+
+int NavLinkGrid::Search(Vector3 position, int seed, NavTrackPosition& result) const
+{
+    if (_links.empty())
+        return -1;
+
+    float best = std::numeric_limits<float>::max();
+    float bestT = 0.0f;
+    std::size_t bestIndex = 0;
+    auto consider = [&](std::size_t index) {
+        float t = 0.0f;
+        float d = DistanceSquared(_links[index], position, t);
+        if (d < best)
+        {
+            best = d;
+            bestT = t;
+            bestIndex = index;
+        }
+    };
+    if (seed >= 0 && static_cast<std::size_t>(seed) < _links.size())
+        consider(static_cast<std::size_t>(seed));
+
+    const int cx = std::clamp(static_cast<int>(std::floor((position.X - _minX) / _cellSize)), 0, _cellsX - 1);
+    const int cz = std::clamp(static_cast<int>(std::floor((position.Z - _minZ) / _cellSize)), 0, _cellsZ - 1);
+    const int maxRing = std::max(_cellsX, _cellsZ);
+    for (int ring = 0; ring <= maxRing; ++ring)
+    {
+        const int x0 = std::max(cx - ring, 0);
+        const int x1 = std::min(cx + ring, _cellsX - 1);
+        const int z0 = std::max(cz - ring, 0);
+        const int z1 = std::min(cz + ring, _cellsZ - 1);
+        for (int z = z0; z <= z1; ++z)
+        {
+            const bool edgeRow = z == cz - ring || z == cz + ring;
+            for (int x = x0; x <= x1; ++x)
+            {
+                if (!edgeRow && x != cx - ring && x != cx + ring)
+                    continue;
+                const std::size_t cell = static_cast<std::size_t>(z) * _cellsX + x;
+                for (std::uint32_t i = _cellStart[cell]; i < _cellStart[cell + 1]; ++i)
+                    consider(_cellLinks[i]);
+            }
+        }
+
+        // Links not seen yet lie entirely outside the visited block of cells.
+        float bound = std::numeric_limits<float>::max();
+        if (x0 > 0)
+            bound = std::min(bound, position.X - (_minX + static_cast<float>(x0) * _cellSize));
+        if (x1 < _cellsX - 1)
+            bound = std::min(bound, _minX + static_cast<float>(x1 + 1) * _cellSize - position.X);
+        if (z0 > 0)
+            bound = std::min(bound, position.Z - (_minZ + static_cast<float>(z0) * _cellSize));
+        if (z1 < _cellsZ - 1)
+            bound = std::min(bound, _minZ + static_cast<float>(z1 + 1) * _cellSize - position.Z);
+        if (bound == std::numeric_limits<float>::max())
+            break; // whole grid visited
+        bound = std::max(bound, 0.0f);
+        if (best <= bound * bound)
+            break;
+    }
+
+    Resolve(bestIndex, position, bestT, result);
+    return static_cast<int>(bestIndex);
+}
+
+bool NavLinkGrid::Query(Vector3 position, NavTrackPosition& result) const
+{
+    return Search(position, -1, result) >= 0;
+}
+
+void NavLinkGrid::QueryBatch(std::span<const Vector3> positions, std::span<NavTrackPosition> results) const
+{
+    const std::size_t count = std::min(positions.size(), results.size());
+    int seed = -1;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        seed = Search(positions[i], seed, results[i]);
+        if (seed < 0)
+            results[i] = {};
+    }
+}
+
+} // namespace SlLib::SumoTool::Siff::NavData
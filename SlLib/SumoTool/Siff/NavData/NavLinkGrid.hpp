@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "../../../Math/Vector.hpp"
+
+namespace SlLib::SumoTool::Siff {
+class Navigation;
+}
+
+namespace SlLib::SumoTool::Siff::NavData {
+
+// Where a world position lies on the track: the nearest waypoint link, how far along it, and the resulting
+// track distance and signed lateral offset (positive towards the link's Right edge).
+struct NavTrackPosition
+{
+    int Link = -1;
+    float LinkT = 0.0f;
+    float TrackDist = 0.0f;
+    float LateralOffset = 0.0f;
+    float Distance = 0.0f;
+    SlLib::Math::Vector3 Projected{};
+};
+
+// Uniform XZ grid over the waypoint links of a Navigation. Each cell lists the links whose segment bounds
+// overlap it; a query searches rings of cells outwards from the position and stops once no unvisited cell
+// can hold a closer link.
+class NavLinkGrid
+{
+public:
+    // `cellSize` <= 0 picks one from the track area and link count. The link geometry is copied, so the grid
+    // has to be rebuilt after the navigation is edited.
+    void Build(SlLib::SumoTool::Siff::Navigation const& navigation, float cellSize = 0.0f);
+    void Clear();
+
+    [[nodiscard]] bool Empty() const { return _links.empty(); }
+    [[nodiscard]] std::size_t LinkCount() const { return _links.size(); }
+
+    // Returns false when the navigation has no usable links.
+    bool Query(SlLib::Math::Vector3 position, NavTrackPosition& result) const;
+    // Samples are usually consecutive points of one path, so each query starts from the previous answer.
+    void QueryBatch(std::span<const SlLib::Math::Vector3> positions, std::span<NavTrackPosition> results) const;
+
+private:
+    struct Segment
+    {
+        SlLib::Math::Vector3 From{};
+        SlLib::Math::Vector3 Delta{};
+        SlLib::Math::Vector3 Lateral{};
+        float InvLengthSquared = 0.0f;
+        float StartDist = 0.0f;
+        float TrackLength = 0.0f;
+        int LinkIndex = -1;
+    };
+
+    float DistanceSquared(Segment const& segment, SlLib::Math::Vector3 position, float& t) const;
+    // Index of the nearest segment, or -1 when there are none. `seed` is a segment tried before the grid.
+    int Search(SlLib::Math::Vector3 position, int seed, NavTrackPosition& result) const;
+    void Resolve(std::size_t segment, SlLib::Math::Vector3 position, float t, NavTrackPosition& result) const;
+
+    std::vector<Segment> _links;
+    std::vector<std::uint32_t> _cellStart;
+    std::vector<std::uint32_t> _cellLinks;
+    float _minX = 0.0f;
+    float _minZ = 0.0f;
+    float _cellSize = 1.0f;
+    int _cellsX = 0;
+    int _cellsZ = 0;
+    float _totalTrackDist = 0.0f;
+};
+
+} // namespace SlLib::SumoTool::Siff::NavData
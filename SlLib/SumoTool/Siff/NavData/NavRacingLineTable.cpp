@@ -0,0 +1,393 @@
+#include "NavRacingLineTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "NavRacingLine.hpp"
+
+namespace SlLib::SumoTool::Siff::NavData {
+
+namespace {
+
+using SlLib::Math::Vector3;
+
+// Spans stepped over before SampleBatch falls back to a binary search.
+constexpr std::size_t kMaxForwardSteps = 8;
+constexpr std::size_t kMaxCells = std::size_t{1} << 22;
+
+} // namespace
+
+void NavRacingLineTable::Clear()
+{
+    _points.clear();
+    _sourceIndex.clear();
+    _pointIndex.clear();
+    _distances.clear();
+    _looping = false;
+    _cellStart.clear();
+    _cellSpans.clear();
+    _cellsX = 0;
+    _cellsZ = 0;
+}
+
+void NavRacingLineTable::Build(NavRacingLine const& line)
+{
+    Clear();
+    _pointIndex.assign(line.Segments.size(), -1);
+    for (std::size_t i = 0; i < line.Segments.size(); ++i)
+    {
+        NavRacingLineSeg const* segment = line.Segments[i].get();
+        if (segment == nullptr)
+            continue;
+
+        Point point;
+        point.Position = segment->RacingLine;
+        point.SafePosition = segment->SafeRacingLine;
+        point.RacingLineScalar = segment->RacingLineScalar;
+        point.SafeRacingLineScalar = segment->SafeRacingLineScalar;
+        point.SmoothSideLeft = segment->SmoothSideLeft;
+        point.SmoothSideRight = segment->SmoothSideRight;
+        point.TurnType = segment->TurnType;
+        _pointIndex[i] = static_cast<int>(_points.size());
+        _sourceIndex.push_back(static_cast<int>(i));
+        _points.push_back(point);
+    }
+    if (_points.size() < 2)
+    {
+        Clear();
+        return;
+    }
+
+    _looping = line.Looping;
+    _distances.reserve(_points.size() + 1);
+    _distances.push_back(0.0f);
+    for (std::size_t i = 1; i < _points.size(); ++i)
+        _distances.push_back(_distances.back() + SlLib::Math::length(_points[i].Position - _points[i - 1].Position));
+    if (_looping)
+        _distances.push_back(_distances.back() + SlLib::Math::length(_points.front().Position - _points.back().Position));
+    BuildGrid();
+}
+
+void NavRacingLineTable::BuildGrid()
+{
+    const std::size_t spans = SpanCount();
+    float minX = std::numeric_limits<float>::max();
+    float minZ = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxZ = std::numeric_limits<float>::lowest();
+    for (Point const& point : _points)
+    {
+        minX = std::min(minX, point.Position.X);
+        maxX = std::max(maxX, point.Position.X);
+        minZ = std::min(minZ, point.Position.Z);
+        maxZ = std::max(maxZ, point.Position.Z);
+    }
+
+    const float width = std::max(maxX - minX, 1.0f);
+    const float depth = std::max(maxZ - minZ, 1.0f);
+    float cellSize = std::max(std::sqrt(width * depth / static_cast<float>(spans)), 1.0f);
+    while (static_cast<std::size_t>(width / cellSize + 1.0f) * static_cast<std::size_t>(depth / cellSize + 1.0f) > kMaxCells)
+        cellSize *= 2.0f;
+
+    _minX = minX;
+    _minZ = minZ;
+    _cellSize = cellSize;
+    _cellsX = static_cast<int>(width / cellSize) + 1;
+    _cellsZ = static_cast<int>(depth / cellSize) + 1;
+
+    // Two passes over the spans' XZ bounds: count per cell, then fill the flattened lists.
+    auto cellRange = [&](std::size_t span, int& x0, int& z0, int& x1, int& z1) {
+        Vector3 from = _points[span].Position;
+        Vector3 to = _points[(span + 1) % _points.size()].Position;
+        x0 = std::clamp(static_cast<int>((std::min(from.X, to.X) - _minX) / _cellSize), 0, _cellsX - 1);
+        x1 = std::clamp(static_cast<int>((std::max(from.X, to.X) - _minX) / _cellSize), 0, _cellsX - 1);
+        z0 = std::clamp(static_cast<int>((std::min(from.Z, to.Z) - _minZ) / _cellSize), 0, _cellsZ - 1);
+        z1 = std::clamp(static_cast<int>((std::max(from.Z, to.Z) - _minZ) / _cellSize), 0, _cellsZ - 1);
+    };
+
+    const std::size_t cellCount = static_cast<std::size_t>(_cellsX) * static_cast<std::size_t>(_cellsZ);
+    _cellStart.assign(cellCount + 1, 0);
+    for (std::size_t span = 0; span < spans; ++span)
+    {
+        int x0, z0, x1, z1;
+        cellRange(span, x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                ++_cellStart[static_cast<std::size_t>(z) * _cellsX + x + 1];
+    }
+    for (std::size_t i = 1; i <= cellCount; ++i)
+        _cellStart[i] += _cellStart[i - 1];
+
+    _cellSpans.resize(_cellStart.back());
+    std::vector<std::uint32_t> cursor(_cellStart.begin(), _cellStart.end() - 1);
+    for (std::size_t span = 0; span < spans; ++span)
+    {
+        int x0, z0, x1, z1;
+        cellRange(span, x0, z0, x1, z1);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                _cellSpans[cursor[static_cast<std::size_t>(z) * _cellsX + x]++] = static_cast<std::uint32_t>(span);
+    }
+}
+
+float NavRacingLineTable::WrapDistance(float distance) const
+{
+    const float length = Length();
+    if (length <= 0.0f)
+        return 0.0f;
+    if (!_looping)
+        return std::clamp(distance, 0.0f, length);
+
+    distance = std::fmod(distance, length);
+    if (distance < 0.0f)
+        distance += length;
+    // fmod of a value just below a multiple of the length can round up to it.
+    return distance < length ? distance : 0.0f;
+}
+
+std::size_t NavRacingLineTable::FindSpan(float wrappedDistance) const
+{
+    auto it = std::upper_bound(_distances.begin(), _distances.end(), wrappedDistance);
+    std::size_t span = it == _distances.begin() ? 0 : static_cast<std::size_t>(it - _distances.begin()) - 1;
+    return std::min(span, SpanCount() - 1);
+}
+
+bool NavRacingLineTable::Locate(float distance, std::size_t& span, float& t) const
+{
+    if (Empty())
+        return false;
+    distance = WrapDistance(distance);
+    span = FindSpan(distance);
+    const float spanLength = _distances[span + 1] - _distances[span];
+    t = spanLength > 0.0f ? std::clamp((distance - _distances[span]) / spanLength, 0.0f, 1.0f) : 0.0f;
+    return true;
+}
+
+void NavRacingLineTable::Fill(std::size_t span, float t, float distance, NavRacingLineSample& sample) const
+{
+    Point const& a = _points[span];
+    Point const& b = _points[(span + 1) % _points.size()];
+    auto lerp = [t](float x, float y) { return x + (y - x) * t; };
+
+    sample.Distance = distance;
+    sample.Segment = _sourceIndex[span];
+    sample.T = t;
+    sample.Position = a.Position + (b.Position - a.Position) * t;
+    sample.SafePosition = a.SafePosition + (b.SafePosition - a.SafePosition) * t;
+    sample.Tangent = SlLib::Math::normalize(b.Position - a.Position);
+    sample.RacingLineScalar = lerp(a.RacingLineScalar, b.RacingLineScalar);
+    sample.SafeRacingLineScalar = lerp(a.SafeRacingLineScalar, b.SafeRacingLineScalar);
+    sample.SmoothSideLeft = lerp(a.SmoothSideLeft, b.SmoothSideLeft);
+    sample.SmoothSideRight = lerp(a.SmoothSideRight, b.SmoothSideRight);
+    sample.TurnType = a.TurnType;
+}
+
+float NavRacingLineTable::DistanceAt(int segment, float t) const
+{
+    if (Empty() || segment < 0 || static_cast<std::size_t>(segment) >= _pointIndex.size())
+        return 0.0f;
+    const int point = _pointIndex[static_cast<std::size_t>(segment)];
+    if (point < 0)
+        return 0.0f;
+    const auto span = static_cast<std::size_t>(point);
+    if (span >= SpanCount())
+        return _distances[span]; // last point of an open line
+    return _distances[span] + (_distances[span + 1] - _distances[span]) * std::clamp(t, 0.0f, 1.0f);
+}
+
+Vector3 NavRacingLineTable::PositionAt(float distance) const
+{
+    std::size_t span = 0;
+    float t = 0.0f;
+    if (!Locate(distance, span, t))
+        return _points.empty() ? Vector3{} : _points.front().Position;
+    Vector3 a = _points[span].Position;
+    Vector3 b = _points[(span + 1) % _points.size()].Position;
+    return a + (b - a) * t;
+}
+
+bool NavRacingLineTable::Sample(float distance, NavRacingLineSample& sample) const
+{
+    std::size_t span = 0;
+    float t = 0.0f;
+    if (!Locate(distance, span, t))
+        return false;
+    Fill(span, t, WrapDistance(distance), sample);
+    return true;
+}
+
+void NavRacingLineTable::SampleBatch(std::span<const float> distances, std::span<NavRacingLineSample> samples) const
+{
+    const std::size_t count = std::min(distances.size(), samples.size());
+    if (Empty())
+    {
+        std::fill_n(samples.begin(), count, NavRacingLineSample{});
+        return;
+    }
+
+    const std::size_t spans = SpanCount();
+    std::size_t span = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float distance = WrapDistance(distances[i]);
+        bool found = false;
+        if (distance >= _distances[span])
+        {
+            for (std::size_t step = 0; step <= kMaxForwardSteps; ++step)
+            {
+                if (span + 1 >= spans || distance < _distances[span + 1])
+                {
+                    found = true;
+                    break;
+                }
+                ++span;
+            }
+        }
+        if (!found)
+            span = FindSpan(distance);
+
+        const float spanLength = _distances[span + 1] - _distances[span];
+        const float t = spanLength > 0.0f ? std::clamp((distance - _distances[span]) / spanLength, 0.0f, 1.0f) : 0.0f;
+        Fill(span, t, distance, samples[i]);
+    }
+}
+
+void NavRacingLineTable::SampleEvery(float spacing, std::vector<NavRacingLineSample>& samples) const
+{
+    samples.clear();
+    if (Empty() || spacing <= 0.0f)
+        return;
+
+    const float length = Length();
+    std::vector<float> distances;
+    distances.reserve(static_cast<std::size_t>(length / spacing) + 2);
+    for (std::size_t i = 0;; ++i)
+    {
+        const float distance = static_cast<float>(i) * spacing;
+        if (distance >= length)
+            break;
+        distances.push_back(distance);
+    }
+    if (!_looping)
+        distances.push_back(length);
+
+    samples.resize(distances.size());
+    SampleBatch(distances, samples);
+}
+
+float NavRacingLineTable::SpanDistanceSquared(std::size_t span, Vector3 position, float& t) const
+{
+    Vector3 a = _points[span].Position;
+    Vector3 delta = _points[(span + 1) % _points.size()].Position - a;
+    const float lengthSquared = SlLib::Math::dot(delta, delta);
+    t = lengthSquared > 0.0f ? std::clamp(SlLib::Math::dot(position - a, delta) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+    Vector3 offset = position - (a + delta * t);
+    return SlLib::Math::dot(offset, offset);
+}
+
+float NavRacingLineTable::ResolveProjection(std::size_t span, float t, float best, float* distanceToLine) const
+{
+    if (distanceToLine != nullptr)
+        *distanceToLine = std::sqrt(best);
+    const float distance = _distances[span] + (_distances[span + 1] - _distances[span]) * t;
+    return _looping && distance >= Length() ? 0.0f : distance;
+}
+
+float NavRacingLineTable::ProjectSpans(Vector3 position, std::size_t first, std::size_t count, float* distanceToLine) const
+{
+    const std::size_t spans = SpanCount();
+    float best = std::numeric_limits<float>::max();
+    float bestT = 0.0f;
+    std::size_t bestSpan = first % spans;
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        const std::size_t span = (first + k) % spans;
+        float t = 0.0f;
+        const float d = SpanDistanceSquared(span, position, t);
+        if (d < best)
+        {
+            best = d;
+            bestT = t;
+            bestSpan = span;
+        }
+    }
+    return ResolveProjection(bestSpan, bestT, best, distanceToLine);
+}
+
+float NavRacingLineTable::Project(Vector3 position, float* distanceToLine) const
+{
+    if (Empty())
+    {
+        if (distanceToLine != nullptr)
+            *distanceToLine = std::numeric_limits<float>::max();
+        return 0.0f;
+    }
+
+    float best = std::numeric_limits<float>::max();
+    float bestT = 0.0f;
+    std::size_t bestSpan = 0;
+    const int cx = std::clamp(static_cast<int>(std::floor((position.X - _minX) / _cellSize)), 0, _cellsX - 1);
+    const int cz = std::clamp(static_cast<int>(std::floor((position.Z - _minZ) / _cellSize)), 0, _cellsZ - 1);
+    const int maxRing = std::max(_cellsX, _cellsZ);
+    for (int ring = 0; ring <= maxRing; ++ring)
+    {
+        const int x0 = std::max(cx - ring, 0);
+        const int x1 = std::min(cx + ring, _cellsX - 1);
+        const int z0 = std::max(cz - ring, 0);
+        const int z1 = std::min(cz + ring, _cellsZ - 1);
+        for (int z = z0; z <= z1; ++z)
+        {
+            const bool edgeRow = z == cz - ring || z == cz + ring;
+            for (int x = x0; x <= x1; ++x)
+            {
+                if (!edgeRow && x != cx - ring && x != cx + ring)
+                    continue;
+                const std::size_t cell = static_cast<std::size_t>(z) * _cellsX + x;
+                for (std::uint32_t i = _cellStart[cell]; i < _cellStart[cell + 1]; ++i)
+                {
+                    float t = 0.0f;
+                    const float d = SpanDistanceSquared(_cellSpans[i], position, t);
+                    if (d < best)
+                    {
+                        best = d;
+                        bestT = t;
+                        bestSpan = _cellSpans[i];
+                    }
+                }
+            }
+        }
+
+        // Spans not seen yet lie entirely outside the visited block of cells, and the XZ gap to it is a lower
+        // bound on the full distance.
+        float bound = std::numeric_limits<float>::max();
+        if (x0 > 0)
+            bound = std::min(bound, position.X - (_minX + static_cast<float>(x0) * _cellSize));
+        if (x1 < _cellsX - 1)
+            bound = std::min(bound, _minX + static_cast<float>(x1 + 1) * _cellSize - position.X);
+        if (z0 > 0)
+            bound = std::min(bound, position.Z - (_minZ + static_cast<float>(z0) * _cellSize));
+        if (z1 < _cellsZ - 1)
+            bound = std::min(bound, _minZ + static_cast<float>(z1 + 1) * _cellSize - position.Z);
+        if (bound == std::numeric_limits<float>::max())
+            break; // whole grid visited
+        bound = std::max(bound, 0.0f);
+        if (best <= bound * bound)
+            break;
+    }
+    return ResolveProjection(bestSpan, bestT, best, distanceToLine);
+}
+
+float NavRacingLineTable::ProjectNear(Vector3 position, float hintDistance, float window, float* distanceToLine) const
+{
+    if (Empty() || window < 0.0f || window * 2.0f >= Length())
+        return Project(position, distanceToLine);
+
+    const std::size_t spans = SpanCount();
+    const std::size_t first = FindSpan(WrapDistance(hintDistance - window));
+    const std::size_t last = FindSpan(WrapDistance(hintDistance + window));
+    const std::size_t count = _looping ? (last + spans - first) % spans + 1 : last - first + 1;
+    return ProjectSpans(position, first, count, distanceToLine);
+}
+
+} // namespace SlLib::SumoTool::Siff::NavData
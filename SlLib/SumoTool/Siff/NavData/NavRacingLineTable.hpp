@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "../../../Math/Vector.hpp"
+
+namespace SlLib::SumoTool::Siff::NavData {
+
+class NavRacingLine;
+
+// A racing line evaluated at some arc-length distance. `Segment` is the index into NavRacingLine::Segments
+// the sample lies after, `T` the fraction of the way to the next point.
+struct NavRacingLineSample
+{
+    float Distance = 0.0f;
+    int Segment = -1;
+    float T = 0.0f;
+    SlLib::Math::Vector3 Position{};
+    SlLib::Math::Vector3 SafePosition{};
+    SlLib::Math::Vector3 Tangent{};
+    float RacingLineScalar = 0.0f;
+    float SafeRacingLineScalar = 0.0f;
+    float SmoothSideLeft = 0.0f;
+    float SmoothSideRight = 0.0f;
+    int TurnType = 0;
+};
+
+// Cumulative arc-length table over a racing line's points, so a distance maps to a position by binary
+// search instead of walking the segments. Looping lines wrap distances into [0, Length()); open lines clamp
+// them to the ends. A uniform XZ grid over the spans, laid out like NavLinkGrid's, answers position queries.
+// The points are copied: rebuild after editing the line.
+class NavRacingLineTable
+{
+public:
+    void Build(NavRacingLine const& line);
+    void Clear();
+
+    [[nodiscard]] bool Empty() const { return _points.size() < 2; }
+    [[nodiscard]] bool Looping() const { return _looping; }
+    [[nodiscard]] float Length() const { return _distances.empty() ? 0.0f : _distances.back(); }
+    [[nodiscard]] std::size_t PointCount() const { return _points.size(); }
+
+    float WrapDistance(float distance) const;
+    // Arc-length distance of a point on segment `segment` (index into NavRacingLine::Segments).
+    float DistanceAt(int segment, float t) const;
+    SlLib::Math::Vector3 PositionAt(float distance) const;
+    bool Sample(float distance, NavRacingLineSample& sample) const;
+    // Ascending distances (the usual case) are resolved by stepping forward from the previous sample.
+    void SampleBatch(std::span<const float> distances, std::span<NavRacingLineSample> samples) const;
+    // Samples every `spacing` units from distance 0, including the end of open lines.
+    void SampleEvery(float spacing, std::vector<NavRacingLineSample>& samples) const;
+
+    // Linear interpolation of a caller-supplied attribute with one value per NavRacingLine segment.
+    template <typename T>
+    T Interpolate(std::span<const T> perSegment, float distance) const
+    {
+        std::size_t span = 0;
+        float t = 0.0f;
+        if (!Locate(distance, span, t))
+            return T{};
+        const auto next = (span + 1) % _points.size();
+        if (static_cast<std::size_t>(_sourceIndex[span]) >= perSegment.size() ||
+            static_cast<std::size_t>(_sourceIndex[next]) >= perSegment.size())
+            return T{};
+        const T& a = perSegment[_sourceIndex[span]];
+        const T& b = perSegment[_sourceIndex[next]];
+        return a + (b - a) * t;
+    }
+
+    // Distance along the line of the point closest to `position`; `distanceToLine` receives how far away
+    // it is. The first form searches rings of grid cells outwards from the position until no unvisited cell
+    // can hold a closer span; the second checks only the spans within `window` of `hintDistance`, for
+    // positions known to be near an earlier answer (consecutive frames of a ghost, say).
+    float Project(SlLib::Math::Vector3 position, float* distanceToLine = nullptr) const;
+    float ProjectNear(SlLib::Math::Vector3 position,
+                      float hintDistance,
+                      float window,
+                      float* distanceToLine = nullptr) const;
+
+private:
+    struct Point
+    {
+        SlLib::Math::Vector3 Position{};
+        SlLib::Math::Vector3 SafePosition{};
+        float RacingLineScalar = 0.0f;
+        float SafeRacingLineScalar = 0.0f;
+        float SmoothSideLeft = 0.0f;
+        float SmoothSideRight = 0.0f;
+        int TurnType = 0;
+    };
+
+    std::size_t SpanCount() const { return _distances.empty() ? 0 : _distances.size() - 1; }
+    std::size_t FindSpan(float wrappedDistance) const;
+    bool Locate(float distance, std::size_t& span, float& t) const;
+    void Fill(std::size_t span, float t, float distance, NavRacingLineSample& sample) const;
+    void BuildGrid();
+    float SpanDistanceSquared(std::size_t span, SlLib::Math::Vector3 position, float& t) const;
+    float ResolveProjection(std::size_t span, float t, float best, float* distanceToLine) const;
+    float ProjectSpans(SlLib::Math::Vector3 position,
+                       std::size_t first,
+                       std::size_t count,
+                       float* distanceToLine) const;
+
+    std::vector<Point> _points;
+    std::vector<int> _sourceIndex;  // NavRacingLine::Segments index of each point
+    std::vector<int> _pointIndex;   // point of each NavRacingLine::Segments entry, -1 for null segments
+    std::vector<float> _distances;  // arc length at each point, plus the closing point of a looping line
+    bool _looping = false;
+
+    // Spans overlapping each grid cell, flattened: cell i owns _cellSpans[_cellStart[i], _cellStart[i + 1]).
+    std::vector<std::uint32_t> _cellStart;
+    std::vector<std::uint32_t> _cellSpans;
+    float _minX = 0.0f;
+    float _minZ = 0.0f;
+    float _cellSize = 1.0f;
+    int _cellsX = 0;
+    int _cellsZ = 0;
+};
+
+} // namespace SlLib::SumoTool::Siff::NavData
@@ -1,7 +1,808 @@
 #include "Gx2Util.hpp"
 
+#include "ParallelFor.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
 namespace SlLib::Utilities {
 
-void Gx2Util::Convert() {}
+namespace {
+
+// Wii U (R7xx) memory configuration, as used by addrlib.
+constexpr std::uint32_t kBanks = 4;
+constexpr std::uint32_t kPipes = 2;
+constexpr std::uint32_t kPipeInterleaveBytes = 256;
+constexpr std::uint32_t kRowSize = 2048;
+constexpr std::uint32_t kSwapSize = 256;
+constexpr std::uint32_t kSplitSize = 2048;
+constexpr std::uint32_t kGroupBits = 8;
+constexpr std::uint32_t kPipeBits = 1;
+
+constexpr std::uint32_t kMicroTilePixels = 64;
+constexpr std::uint32_t kBandRows = 64; // rows per work item; a multiple of every macro tile height
+
+// addrlib tile modes.
+constexpr std::uint32_t kLinearGeneral = 0;
+constexpr std::uint32_t kLinearAligned = 1;
+constexpr std::uint32_t k1dThin1 = 2;
+constexpr std::uint32_t k1dThick = 3;
+constexpr std::uint32_t k2dThin1 = 4;
+constexpr std::uint32_t k2dThin2 = 5;
+constexpr std::uint32_t k2dThin4 = 6;
+constexpr std::uint32_t k2dThick = 7;
+constexpr std::uint32_t k3dThin1 = 12;
+constexpr std::uint32_t k3dThick = 13;
+constexpr std::uint32_t kGx2LinearSpecial = 16;
+
+constexpr std::uint32_t kGx2UseDepthBuffer = 4;
+
+std::uint32_t NextPow2(std::uint32_t value)
+{
+    std::uint32_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+std::uint32_t AlignUp(std::uint32_t value, std::uint32_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool IsBlockCompressed(std::uint32_t format)
+{
+    const std::uint32_t hw = format & 0x3F;
+    return hw >= 0x31 && hw <= 0x35;
+}
+
+std::uint32_t Thickness(std::uint32_t tileMode)
+{
+    switch (tileMode)
+    {
+    case 3:
+    case 7:
+    case 11:
+    case 13:
+    case 15:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+bool IsMacroTiled(std::uint32_t tileMode)
+{
+    return tileMode >= k2dThin1;
+}
+
+bool IsThickMacroTiled(std::uint32_t tileMode)
+{
+    return tileMode == 7 || tileMode == 11 || tileMode == 13 || tileMode == 15;
+}
+
+bool IsBankSwapped(std::uint32_t tileMode)
+{
+    return (tileMode >= 8 && tileMode <= 11) || tileMode == 14 || tileMode == 15;
+}
+
+std::uint32_t NonBankSwapped(std::uint32_t tileMode)
+{
+    switch (tileMode)
+    {
+    case 8:
+    case 9:
+    case 10:
+    case 11:
+        return tileMode - 4;
+    case 14:
+    case 15:
+        return tileMode - 2;
+    default:
+        return tileMode;
+    }
+}
+
+std::uint32_t MacroTileAspectRatio(std::uint32_t tileMode)
+{
+    switch (tileMode)
+    {
+    case 5:
+    case 9:
+        return 2;
+    case 6:
+    case 10:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+std::uint32_t SurfaceRotation(std::uint32_t tileMode)
+{
+    if (tileMode >= 4 && tileMode <= 11)
+        return kPipes * ((kBanks >> 1) - 1);
+    if (tileMode >= 12 && tileMode <= 15)
+        return 1;
+    return 0;
+}
+
+std::uint32_t TileSlices(std::uint32_t tileMode, std::uint32_t bpp)
+{
+    const std::uint32_t bytesPerSample = ((bpp << 6) + 7) >> 3;
+    const std::uint32_t numSamples = Thickness(tileMode) > 1 ? 4 : 1;
+    const std::uint32_t samplesPerTile = kSplitSize / bytesPerSample;
+    return samplesPerTile != 0 ? std::max(1u, numSamples / samplesPerTile) : 1;
+}
+
+// Position of a pixel within its 8x8 (x thickness) micro tile.
+std::uint32_t PixelIndexWithinMicroTile(std::uint32_t x,
+                                        std::uint32_t y,
+                                        std::uint32_t z,
+                                        std::uint32_t bpp,
+                                        std::uint32_t tileMode,
+                                        bool isDepth)
+{
+    std::uint32_t b0, b1, b2, b3, b4, b5;
+    const std::uint32_t x0 = x & 1, x1 = (x >> 1) & 1, x2 = (x >> 2) & 1;
+    const std::uint32_t y0 = y & 1, y1 = (y >> 1) & 1, y2 = (y >> 2) & 1;
+    if (isDepth)
+    {
+        b0 = x0, b1 = y0, b2 = x1, b3 = y1, b4 = x2, b5 = y2;
+    }
+    else
+    {
+        switch (bpp)
+        {
+        case 8:
+            b0 = x0, b1 = x1, b2 = x2, b3 = y1, b4 = y0, b5 = y2;
+            break;
+        case 16:
+            b0 = x0, b1 = x1, b2 = x2, b3 = y0, b4 = y1, b5 = y2;
+            break;
+        case 64:
+            b0 = x0, b1 = y0, b2 = x1, b3 = x2, b4 = y1, b5 = y2;
+            break;
+        case 128:
+            b0 = y0, b1 = x0, b2 = x1, b3 = x2, b4 = y1, b5 = y2;
+            break;
+        default: // 32 and 96
+            b0 = x0, b1 = x1, b2 = y0, b3 = x2, b4 = y1, b5 = y2;
+            break;
+        }
+    }
+
+    std::uint32_t index = b0 | (b1 << 1) | (b2 << 2) | (b3 << 3) | (b4 << 4) | (b5 << 5);
+    const std::uint32_t thickness = Thickness(tileMode);
+    if (thickness > 1)
+        index |= ((z & 1) << 6) | (((z >> 1) & 1) << 7);
+    return index;
+}
+
+std::uint32_t BankSwappedWidth(std::uint32_t tileMode, std::uint32_t bpp, std::uint32_t pitch)
+{
+    if (!IsBankSwapped(tileMode))
+        return 0;
+
+    const std::uint32_t bytesPerSample = 8 * bpp;
+    const std::uint32_t samplesPerTile = kSplitSize / bytesPerSample;
+    const std::uint32_t slicesPerTile = std::max(1u, samplesPerTile != 0 ? 1 / samplesPerTile : 1);
+    const std::uint32_t numSamples = IsThickMacroTiled(tileMode) ? 4 : 1;
+    const std::uint32_t bytesPerTileSlice = numSamples * bytesPerSample / slicesPerTile;
+    const std::uint32_t factor = MacroTileAspectRatio(tileMode);
+    const std::uint32_t swapTiles = std::max(1u, (kSwapSize >> 1) / bpp);
+    const std::uint32_t swapWidth = swapTiles * 8 * kBanks;
+    const std::uint32_t heightBytes = numSamples * factor * kPipes * bpp / slicesPerTile;
+    const std::uint32_t swapMax = kPipes * kBanks * kRowSize / heightBytes;
+    const std::uint32_t swapMin = kPipeInterleaveBytes * 8 * kBanks / bytesPerTileSlice;
+
+    std::uint32_t width = std::min(swapMax, std::max(swapMin, swapWidth));
+    while (width >= 2 * pitch && width > 1)
+        width >>= 1;
+    return width;
+}
+
+std::uint64_t LinearAddress(std::uint32_t x,
+                            std::uint32_t y,
+                            std::uint32_t slice,
+                            std::uint32_t bpp,
+                            std::uint32_t pitch,
+                            std::uint32_t height)
+{
+    const std::uint64_t sliceOffset = static_cast<std::uint64_t>(pitch) * height * slice;
+    return (static_cast<std::uint64_t>(y) * pitch + x + sliceOffset) * (bpp / 8);
+}
+
+std::uint64_t MicroTiledAddress(std::uint32_t x,
+                                std::uint32_t y,
+                                std::uint32_t slice,
+                                std::uint32_t bpp,
+                                std::uint32_t pitch,
+                                std::uint32_t height,
+                                std::uint32_t tileMode,
+                                bool isDepth)
+{
+    const std::uint32_t thickness = tileMode == k1dThick ? 4 : 1;
+    const std::uint64_t microTileBytes = (kMicroTilePixels * thickness * bpp + 7) / 8;
+    const std::uint64_t microTileOffset =
+        microTileBytes * ((x >> 3) + static_cast<std::uint64_t>(y >> 3) * (pitch >> 3));
+    const std::uint64_t sliceBytes = (static_cast<std::uint64_t>(pitch) * height * thickness * bpp + 7) / 8;
+    const std::uint64_t sliceOffset = (slice / thickness) * sliceBytes;
+    const std::uint32_t pixelIndex = PixelIndexWithinMicroTile(x, y, slice, bpp, tileMode, isDepth);
+    return ((bpp * pixelIndex) >> 3) + microTileOffset + sliceOffset;
+}
+
+std::uint64_t MacroTiledAddress(std::uint32_t x,
+                                std::uint32_t y,
+                                std::uint32_t slice,
+                                std::uint32_t bpp,
+                                std::uint32_t pitch,
+                                std::uint32_t height,
+                                std::uint32_t tileMode,
+                                bool isDepth,
+                                std::uint32_t pipeSwizzle,
+                                std::uint32_t bankSwizzle)
+{
+    const std::uint32_t thickness = Thickness(tileMode);
+    const std::uint32_t pixelIndex = PixelIndexWithinMicroTile(x, y, slice, bpp, tileMode, isDepth);
+    const std::uint64_t elemOffset = (static_cast<std::uint64_t>(bpp) * pixelIndex) >> 3;
+
+    // Each micro tile of a macro tile sits in its own pipe/bank channel.
+    const std::uint32_t pipe = ((y >> 3) ^ (x >> 3)) & 1;
+    const std::uint32_t bank = (((y / (16 * kPipes)) ^ (x >> 3)) & 1) | (2 * (((y / (8 * kPipes)) ^ (x >> 4)) & 1));
+    std::uint32_t bankPipe = pipe + kPipes * bank;
+    const std::uint32_t swizzle = pipeSwizzle + kPipes * bankSwizzle;
+    const std::uint32_t sliceIn = IsThickMacroTiled(tileMode) ? slice >> 2 : slice;
+    bankPipe ^= swizzle + sliceIn * SurfaceRotation(tileMode);
+    bankPipe %= kPipes * kBanks;
+    const std::uint32_t finalPipe = bankPipe % kPipes;
+    std::uint32_t finalBank = bankPipe / kPipes;
+
+    const std::uint64_t sliceBytes = (static_cast<std::uint64_t>(height) * pitch * thickness * bpp + 7) / 8;
+    const std::uint64_t sliceOffset = sliceBytes * (slice / thickness);
+
+    const std::uint32_t aspect = MacroTileAspectRatio(tileMode);
+    const std::uint32_t macroTilePitch = 8 * kBanks / aspect;
+    const std::uint32_t macroTileHeight = 8 * kPipes * aspect;
+    const std::uint64_t macroTilesPerRow = pitch / macroTilePitch;
+    const std::uint64_t macroTileBytes =
+        (static_cast<std::uint64_t>(thickness) * bpp * macroTileHeight * macroTilePitch + 7) / 8;
+    const std::uint32_t macroTileIndexX = x / macroTilePitch;
+    const std::uint32_t macroTileIndexY = y / macroTileHeight;
+    const std::uint64_t macroTileOffset = (macroTileIndexX + macroTilesPerRow * macroTileIndexY) * macroTileBytes;
+
+    if (IsBankSwapped(tileMode))
+    {
+        static constexpr std::uint32_t kBankSwapOrder[] = {0, 1, 3, 2, 6, 7, 5, 4, 0, 0};
+        const std::uint32_t swapIndex = macroTilePitch * macroTileIndexX / BankSwappedWidth(tileMode, bpp, pitch);
+        finalBank ^= kBankSwapOrder[swapIndex & (kBanks - 1)];
+    }
+
+    constexpr std::uint64_t groupMask = (1u << kGroupBits) - 1;
+    constexpr std::uint32_t swizzleBits = kPipeBits + 2;
+    const std::uint64_t totalOffset = elemOffset + ((macroTileOffset + sliceOffset) >> swizzleBits);
+    const std::uint64_t offsetHigh = (totalOffset & ~groupMask) << swizzleBits;
+    const std::uint64_t offsetLow = totalOffset & groupMask;
+    return (static_cast<std::uint64_t>(finalBank) << (kPipeBits + kGroupBits)) |
+           (static_cast<std::uint64_t>(finalPipe) << kGroupBits) | offsetLow | offsetHigh;
+}
+
+// Tile-mode changes that do not depend on the level's size.
+std::uint32_t AdjustTileMode(std::uint32_t tileMode, std::uint32_t bpp, bool isDepth)
+{
+    switch (tileMode)
+    {
+    case 7:
+    case 11:
+    case 13:
+    case 15:
+        // A thick tile that would be split across slices is stored thin instead.
+        if (TileSlices(tileMode, bpp) > 1 || isDepth)
+            return tileMode == 7 ? 4 : tileMode == 11 ? 8 : tileMode - 1;
+        return tileMode;
+    case k1dThick:
+        return isDepth ? k1dThin1 : tileMode;
+    default:
+        return tileMode;
+    }
+}
+
+// Small mip levels drop from 2D/3D tiling to 1D once they no longer fill a macro tile.
+std::uint32_t MipLevelTileMode(std::uint32_t baseTileMode,
+                               std::uint32_t bpp,
+                               std::uint32_t level,
+                               std::uint32_t width,
+                               std::uint32_t height,
+                               std::uint32_t slices,
+                               bool isDepth)
+{
+    std::uint32_t tileMode = AdjustTileMode(baseTileMode, bpp, isDepth);
+    if (level == 0)
+        return tileMode;
+
+    if (bpp == 24 || bpp == 48 || bpp == 96)
+        bpp /= 3;
+    const std::uint32_t widthPow2 = NextPow2(width);
+    const std::uint32_t heightPow2 = NextPow2(height);
+    const std::uint32_t slicesPow2 = NextPow2(slices);
+
+    tileMode = NonBankSwapped(tileMode);
+    const std::uint32_t microTileBytes = (bpp * (Thickness(tileMode) << 6) + 7) >> 3;
+    const std::uint32_t widthAlignFactor =
+        microTileBytes < kPipeInterleaveBytes ? kPipeInterleaveBytes / microTileBytes : 1;
+    const std::uint32_t aspect = MacroTileAspectRatio(tileMode);
+    const std::uint32_t macroTileWidth = 8 * kBanks / aspect;
+    const std::uint32_t macroTileHeight = 8 * kPipes * aspect;
+    const bool tooSmall = widthPow2 < widthAlignFactor * macroTileWidth || heightPow2 < macroTileHeight;
+
+    switch (tileMode)
+    {
+    case k2dThin1:
+    case k2dThin2:
+    case k2dThin4:
+    case k3dThin1:
+        if (tooSmall)
+            tileMode = k1dThin1;
+        break;
+    case k2dThick:
+    case k3dThick:
+        if (tooSmall)
+            tileMode = k1dThick;
+        break;
+    default:
+        break;
+    }
+
+    if (slicesPow2 < 4)
+    {
+        if (tileMode == k1dThick)
+            tileMode = k1dThin1;
+        else if (tileMode == k2dThick)
+            tileMode = k2dThin1;
+        else if (tileMode == k3dThick)
+            tileMode = k3dThin1;
+    }
+    return AdjustTileMode(tileMode, bpp, isDepth);
+}
+
+struct Alignments
+{
+    std::uint32_t Pitch = 1;
+    std::uint32_t Height = 1;
+};
+
+Alignments LinearAlignments(std::uint32_t tileMode, std::uint32_t bpp)
+{
+    if (tileMode == kLinearAligned)
+        return {std::max(0x40u, kPipeInterleaveBytes * 8 / bpp), 1};
+    return {bpp == 1 ? 8u : 1u, 1};
+}
+
+Alignments MicroTiledAlignments(std::uint32_t tileMode, std::uint32_t bpp)
+{
+    if (bpp == 24 || bpp == 48 || bpp == 96)
+        bpp /= 3;
+    return {std::max(8u, kPipeInterleaveBytes / bpp / Thickness(tileMode)), 8};
+}
+
+Alignments MacroTiledAlignments(std::uint32_t tileMode, std::uint32_t bpp)
+{
+    if (bpp == 24 || bpp == 48 || bpp == 96)
+        bpp /= 3;
+    const std::uint32_t aspect = MacroTileAspectRatio(tileMode);
+    const std::uint32_t macroTileWidth = 8 * kBanks / aspect;
+    const std::uint32_t macroTileHeight = 8 * kPipes * aspect;
+    const std::uint32_t pitch =
+        std::max(macroTileWidth, macroTileWidth * (kPipeInterleaveBytes / bpp / (8 * Thickness(tileMode))));
+    return {pitch, macroTileHeight};
+}
+
+Alignments AlignmentsFor(std::uint32_t tileMode, std::uint32_t bpp)
+{
+    if (tileMode <= kLinearAligned)
+        return LinearAlignments(tileMode, bpp);
+    if (!IsMacroTiled(tileMode))
+        return MicroTiledAlignments(tileMode, bpp);
+    return MacroTiledAlignments(tileMode, bpp);
+}
+
+std::uint32_t LevelSlices(Gx2Surface const& surface, std::uint32_t level)
+{
+    switch (surface.Dim)
+    {
+    case 2:
+        return std::max(1u, surface.Depth >> level);
+    case 3:
+        return std::max(6u, surface.Depth);
+    case 4:
+    case 5:
+        return std::max(1u, surface.Depth);
+    default:
+        return 1;
+    }
+}
+
+// Per-level constants for copying one micro tile at a time: the byte offset of each of its 64 pixels
+// from the tile's base address, and the longest run of pixels along a row that is contiguous in memory.
+struct MicroTileTable
+{
+    std::array<std::uint32_t, kMicroTilePixels> Offsets{};
+    std::uint32_t RunPixels = 1;
+};
+
+MicroTileTable BuildMicroTileTable(Gx2LevelLayout const& layout, std::uint32_t bpp, std::uint32_t slice, bool isDepth)
+{
+    MicroTileTable table;
+    const std::uint32_t bytes = bpp / 8;
+    for (std::uint32_t y = 0; y < 8; ++y)
+    {
+        for (std::uint32_t x = 0; x < 8; ++x)
+        {
+            const std::uint32_t index = PixelIndexWithinMicroTile(x, y, slice, bpp, layout.TileMode, isDepth);
+            std::uint32_t offset = (bpp * index) >> 3;
+            // Macro tiles interleave pipes and banks every 256 bytes, which pushes the upper half of a
+            // 512-byte or larger micro tile up by the channel bits.
+            if (IsMacroTiled(layout.TileMode))
+                offset = (offset & 0xFF) | ((offset & ~0xFFu) << (kPipeBits + 2));
+            table.Offsets[y * 8 + x] = offset;
+        }
+    }
+
+    for (std::uint32_t run = 8; run > 1; run >>= 1)
+    {
+        bool contiguous = true;
+        for (std::uint32_t i = 0; i < kMicroTilePixels && contiguous; i += run)
+        {
+            for (std::uint32_t k = 1; k < run; ++k)
+            {
+                if (table.Offsets[i + k] != table.Offsets[i] + k * bytes)
+                {
+                    contiguous = false;
+                    break;
+                }
+            }
+        }
+        if (contiguous)
+        {
+            table.RunPixels = run;
+            break;
+        }
+    }
+    return table;
+}
+
+// Copies a whole 8x8 micro tile in fixed-size runs, which compile to single vector loads and stores.
+template <std::size_t RunBytes>
+void CopyMicroTile(const std::uint8_t* tile,
+                   MicroTileTable const& table,
+                   std::uint8_t* destination,
+                   std::size_t destinationPitch)
+{
+    const std::uint32_t runPixels = table.RunPixels;
+    for (std::uint32_t y = 0; y < 8; ++y)
+    {
+        std::uint8_t* row = destination + y * destinationPitch;
+        for (std::uint32_t x = 0, out = 0; x < 8; x += runPixels, out += RunBytes)
+            std::memcpy(row + out, tile + table.Offsets[y * 8 + x], RunBytes);
+    }
+}
+
+void CopyMicroTileRuntime(const std::uint8_t* tile,
+                          MicroTileTable const& table,
+                          std::size_t runBytes,
+                          std::uint32_t columns,
+                          std::uint32_t rows,
+                          std::uint32_t bytes,
+                          std::uint8_t* destination,
+                          std::size_t destinationPitch)
+{
+    for (std::uint32_t y = 0; y < rows; ++y)
+    {
+        std::uint8_t* row = destination + y * destinationPitch;
+        for (std::uint32_t x = 0; x < columns; x += table.RunPixels)
+        {
+            const std::size_t count = std::min<std::size_t>(runBytes, static_cast<std::size_t>(columns - x) * bytes);
+            std::memcpy(row + x * bytes, tile + table.Offsets[y * 8 + x], count);
+        }
+    }
+}
+
+struct WorkItem
+{
+    std::uint32_t Level = 0;
+    std::uint32_t Slice = 0;
+    std::uint32_t FirstRow = 0;
+    std::uint32_t RowCount = 0;
+};
+
+} // namespace
+
+std::uint32_t Gx2Util::BitsPerElement(std::uint32_t format)
+{
+    switch (format & 0x3F)
+    {
+    case 0x01: // R8
+        return 8;
+    case 0x07: // R8_G8
+    case 0x08: // R5_G6_B5
+    case 0x0A: // R5_G5_B5_A1
+    case 0x0B: // R4_G4_B4_A4
+        return 16;
+    case 0x19: // R10_G10_B10_A2
+    case 0x1A: // R8_G8_B8_A8
+        return 32;
+    case 0x1F: // R16_G16_B16_A16
+    case 0x20: // R16_G16_B16_A16_FLOAT
+    case 0x31: // BC1
+    case 0x34: // BC4
+        return 64;
+    case 0x22: // R32_G32_B32_A32
+    case 0x23: // R32_G32_B32_A32_FLOAT
+    case 0x32: // BC2
+    case 0x33: // BC3
+    case 0x35: // BC5
+        return 128;
+    default:
+        return 0;
+    }
+}
+
+bool Gx2Util::ComputeLevelLayout(Gx2Surface const& surface,
+                                 std::uint32_t level,
+                                 Gx2LevelLayout& layout,
+                                 std::string& error)
+{
+    const std::uint32_t bpp = BitsPerElement(surface.Format);
+    if (bpp == 0)
+    {
+        error = "Unsupported GX2 surface format.";
+        return false;
+    }
+    if (surface.AA != 0 || surface.Dim > 5)
+    {
+        error = "Multisampled GX2 surfaces are not supported.";
+        return false;
+    }
+    if (surface.TileMode == 0 || surface.TileMode > kGx2LinearSpecial)
+    {
+        error = "Invalid GX2 tile mode.";
+        return false;
+    }
+    if (surface.Width == 0 || surface.Height == 0 || level >= std::min<std::uint32_t>(surface.MipLevels, 14))
+    {
+        error = "Invalid GX2 surface size or mip level.";
+        return false;
+    }
+
+    const bool blocks = IsBlockCompressed(surface.Format);
+    const bool isDepth = (surface.Use & kGx2UseDepthBuffer) != 0;
+    const std::uint32_t width = std::max(1u, surface.Width >> level);
+    const std::uint32_t height = surface.Dim == 0 || surface.Dim == 4 ? 1 : std::max(1u, surface.Height >> level);
+    layout = {};
+    layout.Width = blocks ? (width + 3) / 4 : width;
+    layout.Height = blocks ? (height + 3) / 4 : height;
+    layout.Slices = LevelSlices(surface, level);
+
+    std::uint32_t pitch = layout.Width;
+    std::uint32_t paddedHeight = layout.Height;
+    std::uint32_t slices = layout.Slices;
+    if (surface.TileMode == kGx2LinearSpecial)
+    {
+        layout.TileMode = kLinearGeneral;
+    }
+    else
+    {
+        layout.TileMode = MipLevelTileMode(surface.TileMode, bpp, level, pitch, paddedHeight, slices, isDepth);
+        if (level > 0)
+        {
+            pitch = NextPow2(pitch);
+            paddedHeight = NextPow2(paddedHeight);
+
+            // Thick macro-tiled chains fall back to 1D once a level is smaller than the base mode's tile.
+            if (IsThickMacroTiled(surface.TileMode) && !IsThickMacroTiled(layout.TileMode) &&
+                IsMacroTiled(layout.TileMode))
+            {
+                const Alignments base = MacroTiledAlignments(surface.TileMode, bpp);
+                if (pitch < base.Pitch * std::max(1u, 32 / bpp) || paddedHeight < base.Height)
+                    layout.TileMode = k1dThin1;
+            }
+        }
+
+        Alignments alignments = AlignmentsFor(layout.TileMode, bpp);
+        if (IsMacroTiled(layout.TileMode))
+            alignments.Pitch = std::max(alignments.Pitch, BankSwappedWidth(layout.TileMode, bpp, pitch));
+        pitch = AlignUp(pitch, alignments.Pitch);
+        paddedHeight = AlignUp(paddedHeight, alignments.Height);
+    }
+
+    // The header records the pitch level 0 was actually allocated with.
+    if (level == 0 && surface.Pitch != 0)
+    {
+        if (surface.Pitch < layout.Width)
+        {
+            error = "GX2 surface pitch is smaller than its width.";
+            return false;
+        }
+        pitch = surface.Pitch;
+    }
+
+    layout.Pitch = pitch;
+    layout.PaddedHeight = paddedHeight;
+    const std::uint32_t thickness = layout.TileMode == kLinearGeneral || layout.TileMode == kLinearAligned
+                                        ? 1
+                                        : Thickness(layout.TileMode);
+    const std::size_t sliceBytes = static_cast<std::size_t>(pitch) * paddedHeight * bpp / 8;
+    layout.Size = sliceBytes * AlignUp(layout.Slices, thickness);
+
+    if (level == 0)
+        layout.Offset = 0;
+    else if (level == 1)
+        layout.Offset = surface.MipOffsets[0] >= surface.ImageSize ? surface.MipOffsets[0] - surface.ImageSize : 0;
+    else
+        layout.Offset = surface.MipOffsets[level - 1];
+    return true;
+}
+
+std::uint64_t Gx2Util::ComputeElementAddress(Gx2Surface const& surface,
+                                             Gx2LevelLayout const& layout,
+                                             std::uint32_t x,
+                                             std::uint32_t y,
+                                             std::uint32_t slice)
+{
+    const std::uint32_t bpp = BitsPerElement(surface.Format);
+    const bool isDepth = (surface.Use & kGx2UseDepthBuffer) != 0;
+    if (layout.TileMode <= kLinearAligned)
+        return LinearAddress(x, y, slice, bpp, layout.Pitch, layout.PaddedHeight);
+    if (!IsMacroTiled(layout.TileMode))
+        return MicroTiledAddress(x, y, slice, bpp, layout.Pitch, layout.PaddedHeight, layout.TileMode, isDepth);
+    return MacroTiledAddress(x,
+                             y,
+                             slice,
+                             bpp,
+                             layout.Pitch,
+                             layout.PaddedHeight,
+                             layout.TileMode,
+                             isDepth,
+                             (surface.Swizzle >> 8) & 1,
+                             (surface.Swizzle >> 9) & 3);
+}
+
+bool Gx2Util::Convert(Gx2Surface const& surface,
+                      std::span<const std::uint8_t> imageData,
+                      std::span<const std::uint8_t> mipData,
+                      Gx2Image& output,
+                      std::string& error,
+                      std::size_t threadCount)
+{
+    const std::uint32_t levelCount = std::max(1u, surface.MipLevels);
+    std::vector<Gx2LevelLayout> levels(levelCount);
+    for (std::uint32_t level = 0; level < levelCount; ++level)
+    {
+        if (!ComputeLevelLayout(surface, level, levels[level], error))
+            return false;
+        std::span<const std::uint8_t> source = level == 0 ? imageData : mipData;
+        if (levels[level].Offset + levels[level].Size > source.size())
+        {
+            error = "GX2 surface data is too small for mip level " + std::to_string(level) + ".";
+            return false;
+        }
+    }
+
+    const std::uint32_t bpp = BitsPerElement(surface.Format);
+    const std::uint32_t bytes = bpp / 8;
+    const bool isVolume = surface.Dim == 2;
+    const std::uint32_t sliceCount = levels[0].Slices;
+
+    output = {};
+    output.Width = surface.Width;
+    output.Height = surface.Height;
+    output.Slices = sliceCount;
+    output.MipLevels = levelCount;
+    output.BytesPerElement = bytes;
+    output.BlockCompressed = IsBlockCompressed(surface.Format);
+    switch (surface.Format & 0x3F)
+    {
+    case 0x31:
+        output.Format = DdsFormat::BC1;
+        break;
+    case 0x32:
+        output.Format = DdsFormat::BC2;
+        break;
+    case 0x33:
+        output.Format = DdsFormat::BC3;
+        break;
+    case 0x1A:
+        output.Format = DdsFormat::RGBA8;
+        break;
+    default:
+        output.Format = DdsFormat::Unknown;
+        break;
+    }
+
+    // Output offset of every (level, slice) pair, in DDS order.
+    std::vector<std::size_t> outputOffsets(static_cast<std::size_t>(levelCount) * sliceCount, SIZE_MAX);
+    std::size_t total = 0;
+    auto place = [&](std::uint32_t level, std::uint32_t slice) {
+        Gx2LevelLayout const& layout = levels[level];
+        outputOffsets[static_cast<std::size_t>(level) * sliceCount + slice] = total;
+        total += static_cast<std::size_t>(layout.Width) * layout.Height * bytes;
+    };
+    if (isVolume)
+    {
+        for (std::uint32_t level = 0; level < levelCount; ++level)
+            for (std::uint32_t slice = 0; slice < levels[level].Slices; ++slice)
+                place(level, slice);
+    }
+    else
+    {
+        for (std::uint32_t slice = 0; slice < sliceCount; ++slice)
+            for (std::uint32_t level = 0; level < levelCount; ++level)
+                place(level, slice);
+    }
+    output.Data.resize(total);
+
+    std::vector<WorkItem> items;
+    for (std::uint32_t level = 0; level < levelCount; ++level)
+        for (std::uint32_t slice = 0; slice < levels[level].Slices; ++slice)
+            for (std::uint32_t row = 0; row < levels[level].Height; row += kBandRows)
+                items.push_back({level, slice, row, std::min(kBandRows, levels[level].Height - row)});
+
+    const bool isDepth = (surface.Use & kGx2UseDepthBuffer) != 0;
+    ParallelFor(items.size(), threadCount, [&](std::size_t index) {
+        WorkItem const& item = items[index];
+        Gx2LevelLayout const& layout = levels[item.Level];
+        const std::uint8_t* source = (item.Level == 0 ? imageData : mipData).data() + layout.Offset;
+        std::uint8_t* destination =
+            output.Data.data() + outputOffsets[static_cast<std::size_t>(item.Level) * sliceCount + item.Slice];
+        const std::size_t destinationPitch = static_cast<std::size_t>(layout.Width) * bytes;
+        const std::uint32_t lastRow = item.FirstRow + item.RowCount;
+
+        if (layout.TileMode <= kLinearAligned)
+        {
+            for (std::uint32_t y = item.FirstRow; y < lastRow; ++y)
+            {
+                const std::uint64_t address = LinearAddress(0, y, item.Slice, bpp, layout.Pitch, layout.PaddedHeight);
+                std::memcpy(destination + y * destinationPitch, source + address, destinationPitch);
+            }
+            return;
+        }
+
+        const MicroTileTable table = BuildMicroTileTable(layout, bpp, item.Slice, isDepth);
+        const std::size_t runBytes = static_cast<std::size_t>(table.RunPixels) * bytes;
+        for (std::uint32_t tileY = item.FirstRow; tileY < lastRow; tileY += 8)
+        {
+            const std::uint32_t rows = std::min(8u, layout.Height - tileY);
+            for (std::uint32_t tileX = 0; tileX < layout.Width; tileX += 8)
+            {
+                const std::uint32_t columns = std::min(8u, layout.Width - tileX);
+                const std::uint8_t* tile =
+                    source + ComputeElementAddress(surface, layout, tileX, tileY, item.Slice) - table.Offsets[0];
+                std::uint8_t* target = destination + tileY * destinationPitch + tileX * bytes;
+                if (rows < 8 || columns < 8)
+                {
+                    CopyMicroTileRuntime(tile, table, runBytes, columns, rows, bytes, target, destinationPitch);
+                    continue;
+                }
+                switch (runBytes)
+                {
+                case 4:
+                    CopyMicroTile<4>(tile, table, target, destinationPitch);
+                    break;
+                case 8:
+                    CopyMicroTile<8>(tile, table, target, destinationPitch);
+                    break;
+                case 16:
+                    CopyMicroTile<16>(tile, table, target, destinationPitch);
+                    break;
+                default:
+                    CopyMicroTileRuntime(tile, table, runBytes, 8, 8, bytes, target, destinationPitch);
+                    break;
+                }
+            }
+        }
+    });
+    return true;
+}
 
 } // namespace SlLib::Utilities
@@ -1,11 +1,86 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "DdsUtil.hpp"
+
 namespace SlLib::Utilities {
 
+// The fields of a GX2Surface header that describe how its image and mip data are laid out.
+struct Gx2Surface
+{
+    std::uint32_t Dim = 1; // GX2SurfaceDim: 0 1D, 1 2D, 2 3D, 3 cube, 4 1D array, 5 2D array
+    std::uint32_t Width = 0;
+    std::uint32_t Height = 0;
+    std::uint32_t Depth = 1; // slices for arrays and cubes
+    std::uint32_t MipLevels = 1;
+    std::uint32_t Format = 0; // GX2SurfaceFormat
+    std::uint32_t AA = 0;
+    std::uint32_t Use = 0;
+    std::uint32_t ImageSize = 0;
+    std::uint32_t MipSize = 0;
+    std::uint32_t TileMode = 0; // GX2TileMode
+    std::uint32_t Swizzle = 0;
+    std::uint32_t Pitch = 0; // level 0 pitch in elements
+    std::array<std::uint32_t, 13> MipOffsets{};
+};
+
+// Where one mip level lives and how it is tiled. Sizes are in elements, i.e. 4x4 blocks for BCn formats.
+struct Gx2LevelLayout
+{
+    std::uint32_t TileMode = 0; // addrlib tile mode after mip degradation; 0 and 1 are linear
+    std::uint32_t Width = 0;
+    std::uint32_t Height = 0;
+    std::uint32_t Slices = 1;
+    std::uint32_t Pitch = 0;
+    std::uint32_t PaddedHeight = 0;
+    std::size_t Offset = 0; // into the image data for level 0, into the mip data otherwise
+    std::size_t Size = 0;   // bytes spanned by the level's slices
+};
+
+// Untiled texture. Data is ordered like a DDS payload: per slice, every mip level, except for 3D
+// textures, which store every slice of a level before the next level.
+struct Gx2Image
+{
+    std::uint32_t Width = 0;
+    std::uint32_t Height = 0;
+    std::uint32_t Slices = 1;
+    std::uint32_t MipLevels = 1;
+    std::uint32_t BytesPerElement = 0;
+    bool BlockCompressed = false;
+    DdsFormat Format = DdsFormat::Unknown; // Unknown for formats DdsUtil does not describe
+    std::vector<std::uint8_t> Data;
+};
+
 class Gx2Util
 {
 public:
-    static void Convert();
+    // Bits per element of a GX2 surface format, or 0 for formats Convert does not handle.
+    static std::uint32_t BitsPerElement(std::uint32_t format);
+    static bool ComputeLevelLayout(Gx2Surface const& surface,
+                                   std::uint32_t level,
+                                   Gx2LevelLayout& layout,
+                                   std::string& error);
+    // Byte offset of element (x, y) of `slice` within the level's data.
+    static std::uint64_t ComputeElementAddress(Gx2Surface const& surface,
+                                               Gx2LevelLayout const& layout,
+                                               std::uint32_t x,
+                                               std::uint32_t y,
+                                               std::uint32_t slice);
+
+    // Untiles every level and slice of `surface`. Work is split over levels, slices and bands of rows
+    // on up to `threadCount` threads (0 = one per hardware thread).
+    static bool Convert(Gx2Surface const& surface,
+                        std::span<const std::uint8_t> imageData,
+                        std::span<const std::uint8_t> mipData,
+                        Gx2Image& output,
+                        std::string& error,
+                        std::size_t threadCount = 0);
 };
 
 } // namespace SlLib::Utilities
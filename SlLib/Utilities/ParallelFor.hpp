@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SlLib::Utilities {
+
+// Resolves a requested worker count: 0 means one per hardware thread.
+inline std::size_t ResolveThreadCount(std::size_t requested)
+{
+    if (requested != 0)
+        return requested;
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+// Calls `fn(index)` for every index in [0, count) on up to `threadCount` workers (0 = hardware threads).
+// Indices are handed out in order from a shared counter; with one worker everything runs on the calling
+// thread. The first exception thrown by `fn` is rethrown after all workers have joined.
+template <typename Fn>
+void ParallelFor(std::size_t count, std::size_t threadCount, Fn&& fn)
+{
+    if (count == 0)
+        return;
+
+    const std::size_t workerCount = std::min(ResolveThreadCount(threadCount), count);
+    if (workerCount == 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            fn(i);
+        return;
+    }
+
+    std::atomic<std::size_t> nextIndex{0};
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        for (;;)
+        {
+            std::size_t index = nextIndex.fetch_add(1);
+            if (index >= count)
+                break;
+            try
+            {
+                fn(index);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError)
+                    firstError = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount - 1);
+    for (std::size_t i = 1; i < workerCount; ++i)
+        workers.emplace_back(worker);
+    worker();
+    for (auto& t : workers)
+        t.join();
+
+    if (firstError)
+        std::rethrow_exception(firstError);
+}
+
+} // namespace SlLib::Utilities
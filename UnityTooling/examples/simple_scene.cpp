@@ -1,7 +1,5 @@
 #include "UnityTooling/SceneBuilder.h"
 
-#include <fstream>
-
 int main() {
     UnityTooling::SceneBuilder builder;
     builder.addDefaultSceneDocuments();
@@ -21,9 +19,5 @@ int main() {
     camera.components.push_back(UnityTooling::makeCameraComponent());
     builder.addGameObject(camera);
 
-    const auto sceneData = builder.serialize();
-    std::ofstream output("UnityTooling/examples/generated_scene.unity", std::ios::binary);
-    output << sceneData;
-
-    return 0;
+    return builder.serializeToFile("UnityTooling/examples/generated_scene.unity") ? 0 : 1;
 }
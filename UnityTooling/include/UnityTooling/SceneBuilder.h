@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <iosfwd>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace UnityTooling {
@@ -19,10 +23,61 @@ struct Quaternion {
     float w = 1.0f;
 };
 
+// Buffered text sink for scene YAML. Numbers go through std::to_chars, so output does not depend on the
+// locale. Bound to a stream it flushes one buffer at a time; without a stream it accumulates everything.
+class YamlSink {
+public:
+    static constexpr std::size_t kDefaultBufferSize = std::size_t{1} << 20;
+
+    YamlSink() = default;
+    explicit YamlSink(std::ostream& out, std::size_t bufferSize = kDefaultBufferSize);
+    ~YamlSink();
+
+    YamlSink(const YamlSink&) = delete;
+    YamlSink& operator=(const YamlSink&) = delete;
+
+    void reserve(std::size_t bytes);
+    void flush();
+    bool good() const { return good_; }
+    // Accumulated text (everything, when not bound to a stream).
+    std::string release();
+
+    void write(char c) {
+        ensure(1);
+        buffer_.push_back(c);
+    }
+    void write(std::string_view text);
+    void writeInt(long long value);
+    // printf("%.<precision>f")
+    void writeFixed(float value, int precision = 6);
+    // Same text as streaming a float with default ostream flags ("%g").
+    void writeGeneral(float value, int precision = 6);
+    // "{x: 0.000000, y: ...}" as used by m_LocalPosition and friends.
+    void writeVector3(const Vector3& value);
+    void writeQuaternion(const Quaternion& value);
+    void writeQuotedIfNeeded(std::string_view raw);
+
+private:
+    void ensure(std::size_t bytes) {
+        if (out_ && buffer_.size() + bytes > bufferSize_) {
+            flush();
+        }
+    }
+
+    std::ostream* out_ = nullptr;
+    std::size_t bufferSize_ = 0;
+    std::string buffer_;
+    bool good_ = true;
+};
+
 struct ComponentDefinition {
     std::string tag;
     std::string typeName;
+    // Returns the whole document body for the given file ID. Kept for custom components; the built-in ones
+    // use bodyWriter, which streams into the sink without building strings. Either is called while the
+    // scene is serialized, not when the GameObject is added.
     std::function<std::string(int)> bodyBuilder;
+    std::function<void(YamlSink&, int)> bodyWriter;
 };
 
 struct GameObjectDefinition {
@@ -37,10 +92,19 @@ class SceneBuilder {
 public:
     SceneBuilder();
 
+    // Pre-sizes internal storage for scenes built from many GameObjects.
+    void reserve(std::size_t gameObjectCount);
+
     void addDefaultSceneDocuments();
     int addSceneDocument(const std::string& tag, const std::string& typeName, const std::string& body);
     void addGameObject(const GameObjectDefinition& definition);
+    void addGameObject(GameObjectDefinition&& definition);
+
     std::string serialize() const;
+    // Streams the same bytes serialize() returns straight into `out`.
+    bool serialize(std::ostream& out) const;
+    void serialize(YamlSink& sink) const;
+    bool serializeToFile(const std::string& path) const;
 
 private:
     struct SceneDocument {
@@ -50,11 +114,26 @@ private:
         std::string body;
     };
 
+    // Components take consecutive file IDs starting at firstFileID; the GameObject takes the next one.
+    struct SceneObject {
+        GameObjectDefinition definition;
+        int firstFileID;
+    };
+
+    struct DocumentEntry {
+        bool isObject;
+        std::uint32_t index; // into documents_ or objects_
+    };
+
     int allocateFileID();
-    std::string buildGameObjectBody(const GameObjectDefinition& definition, const std::vector<int>& componentIDs) const;
-    static std::string stripTagPrefix(const std::string& tag);
+    void writeGameObject(YamlSink& sink, const SceneObject& object) const;
+    std::size_t estimateSize() const;
+    static std::string_view stripTagPrefix(std::string_view tag);
 
     std::vector<SceneDocument> documents_;
+    std::vector<SceneObject> objects_;
+    std::vector<DocumentEntry> entries_;
+    std::size_t componentCount_ = 0;
     int nextFileID_ = 1;
     bool defaultSceneAdded_ = false;
 };
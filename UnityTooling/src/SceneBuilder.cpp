@@ -1,12 +1,120 @@
 #include "UnityTooling/SceneBuilder.h"
 
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <ostream>
 
 namespace UnityTooling {
 
+namespace {
+
+// Rough document sizes used to pre-size serialization output; exact values do not matter.
+constexpr std::size_t kGameObjectDocumentBytes = 320;
+constexpr std::size_t kComponentDocumentBytes = 420;
+
+} // namespace
+
+YamlSink::YamlSink(std::ostream& out, std::size_t bufferSize)
+    : out_(&out), bufferSize_(std::max<std::size_t>(bufferSize, 4096)) {
+    buffer_.reserve(bufferSize_);
+}
+
+YamlSink::~YamlSink() {
+    flush();
+}
+
+void YamlSink::reserve(std::size_t bytes) {
+    if (!out_) {
+        buffer_.reserve(bytes);
+    }
+}
+
+void YamlSink::flush() {
+    if (!out_ || buffer_.empty()) {
+        return;
+    }
+    if (!out_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()))) {
+        good_ = false;
+    }
+    buffer_.clear();
+}
+
+std::string YamlSink::release() {
+    std::string text = std::move(buffer_);
+    buffer_.clear();
+    return text;
+}
+
+void YamlSink::write(std::string_view text) {
+    if (out_ && text.size() > bufferSize_) {
+        flush();
+        if (!out_->write(text.data(), static_cast<std::streamsize>(text.size()))) {
+            good_ = false;
+        }
+        return;
+    }
+    ensure(text.size());
+    buffer_.append(text);
+}
+
+void YamlSink::writeInt(long long value) {
+    char chars[24];
+    const auto result = std::to_chars(chars, chars + sizeof(chars), value);
+    write(std::string_view(chars, static_cast<std::size_t>(result.ptr - chars)));
+}
+
+void YamlSink::writeFixed(float value, int precision) {
+    char chars[64];
+    const auto result = std::to_chars(chars, chars + sizeof(chars), value, std::chars_format::fixed, precision);
+    write(std::string_view(chars, static_cast<std::size_t>(result.ptr - chars)));
+}
+
+void YamlSink::writeGeneral(float value, int precision) {
+    char chars[64];
+    const auto result = std::to_chars(chars, chars + sizeof(chars), value, std::chars_format::general, precision);
+    write(std::string_view(chars, static_cast<std::size_t>(result.ptr - chars)));
+}
+
+void YamlSink::writeVector3(const Vector3& value) {
+    write("{x: ");
+    writeFixed(value.x);
+    write(", y: ");
+    writeFixed(value.y);
+    write(", z: ");
+    writeFixed(value.z);
+    write('}');
+}
+
+void YamlSink::writeQuaternion(const Quaternion& value) {
+    write("{x: ");
+    writeFixed(value.x);
+    write(", y: ");
+    writeFixed(value.y);
+    write(", z: ");
+    writeFixed(value.z);
+    write(", w: ");
+    writeFixed(value.w);
+    write('}');
+}
+
+void YamlSink::writeQuotedIfNeeded(std::string_view raw) {
+    if (raw.find_first_of(" \t\n\r:") != std::string_view::npos) {
+        write('"');
+        write(raw);
+        write('"');
+        return;
+    }
+    write(raw);
+}
+
 SceneBuilder::SceneBuilder() = default;
 
+void SceneBuilder::reserve(std::size_t gameObjectCount) {
+    objects_.reserve(objects_.size() + gameObjectCount);
+    entries_.reserve(entries_.size() + gameObjectCount);
+}
+
 void SceneBuilder::addDefaultSceneDocuments() {
     if (defaultSceneAdded_) {
         return;
@@ -22,194 +130,274 @@ void SceneBuilder::addDefaultSceneDocuments() {
 
 int SceneBuilder::addSceneDocument(const std::string& tag, const std::string& typeName, const std::string& body) {
     const int fileID = allocateFileID();
+    entries_.push_back({false, static_cast<std::uint32_t>(documents_.size())});
     documents_.push_back({tag, fileID, typeName, body});
     return fileID;
 }
 
 void SceneBuilder::addGameObject(const GameObjectDefinition& definition) {
-    std::vector<int> componentIDs;
-    for (const auto& component : definition.components) {
-        componentIDs.push_back(addSceneDocument(component.tag, component.typeName, component.bodyBuilder(static_cast<int>(nextFileID_))));
-    }
+    addGameObject(GameObjectDefinition(definition));
+}
 
-    addSceneDocument("!u!1", "GameObject", buildGameObjectBody(definition, componentIDs));
+void SceneBuilder::addGameObject(GameObjectDefinition&& definition) {
+    // Components first, then the GameObject, each with the next file ID.
+    const int firstFileID = nextFileID_;
+    nextFileID_ += static_cast<int>(definition.components.size()) + 1;
+    componentCount_ += definition.components.size();
+    entries_.push_back({true, static_cast<std::uint32_t>(objects_.size())});
+    objects_.push_back({std::move(definition), firstFileID});
 }
 
 std::string SceneBuilder::serialize() const {
-    std::ostringstream output;
-    output << "%YAML 1.1\n";
-    output << "%TAG !u! tag:unity3d.com,2011:\n";
+    YamlSink sink;
+    sink.reserve(estimateSize());
+    serialize(sink);
+    return sink.release();
+}
 
-    for (const auto& document : documents_) {
-        output << "--- " << document.tag << " &" << document.fileID << "\n";
-        output << document.body << "\n";
+bool SceneBuilder::serialize(std::ostream& out) const {
+    YamlSink sink(out);
+    serialize(sink);
+    sink.flush();
+    return sink.good();
+}
+
+bool SceneBuilder::serializeToFile(const std::string& path) const {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        return false;
     }
+    return serialize(output);
+}
+
+void SceneBuilder::serialize(YamlSink& sink) const {
+    sink.write("%YAML 1.1\n");
+    sink.write("%TAG !u! tag:unity3d.com,2011:\n");
+
+    for (const auto& entry : entries_) {
+        if (!entry.isObject) {
+            const auto& document = documents_[entry.index];
+            sink.write("--- ");
+            sink.write(document.tag);
+            sink.write(" &");
+            sink.writeInt(document.fileID);
+            sink.write('\n');
+            sink.write(document.body);
+            sink.write('\n');
+            continue;
+        }
 
-    return output.str();
+        const auto& object = objects_[entry.index];
+        const auto& components = object.definition.components;
+        for (std::size_t i = 0; i < components.size(); ++i) {
+            const int fileID = object.firstFileID + static_cast<int>(i);
+            sink.write("--- ");
+            sink.write(components[i].tag);
+            sink.write(" &");
+            sink.writeInt(fileID);
+            sink.write('\n');
+            // Body builders have always been handed the component's own file ID.
+            if (components[i].bodyWriter) {
+                components[i].bodyWriter(sink, fileID);
+            } else if (components[i].bodyBuilder) {
+                sink.write(components[i].bodyBuilder(fileID));
+            }
+            sink.write('\n');
+        }
+        writeGameObject(sink, object);
+    }
 }
 
 int SceneBuilder::allocateFileID() {
     return nextFileID_++;
 }
 
-std::string SceneBuilder::buildGameObjectBody(const GameObjectDefinition& definition, const std::vector<int>& componentIDs) const {
-    std::ostringstream body;
-    body << "GameObject:\n";
-    body << "  m_ObjectHideFlags: 0\n";
-    body << "  m_PrefabParentObject: {fileID: 0}\n";
-    body << "  m_PrefabInternal: {fileID: 0}\n";
-    body << "  importerVersion: 3\n";
-    body << "  m_Component:\n";
+void SceneBuilder::writeGameObject(YamlSink& sink, const SceneObject& object) const {
+    const auto& definition = object.definition;
+    sink.write("--- !u!1 &");
+    sink.writeInt(object.firstFileID + static_cast<int>(definition.components.size()));
+    sink.write('\n');
+    sink.write("GameObject:\n");
+    sink.write("  m_ObjectHideFlags: 0\n");
+    sink.write("  m_PrefabParentObject: {fileID: 0}\n");
+    sink.write("  m_PrefabInternal: {fileID: 0}\n");
+    sink.write("  importerVersion: 3\n");
+    sink.write("  m_Component:\n");
 
-    for (size_t i = 0; i < componentIDs.size(); ++i) {
-        body << "  - " << stripTagPrefix(definition.components[i].tag) << ": {fileID: " << componentIDs[i] << "}\n";
+    for (std::size_t i = 0; i < definition.components.size(); ++i) {
+        sink.write("  - ");
+        sink.write(stripTagPrefix(definition.components[i].tag));
+        sink.write(": {fileID: ");
+        sink.writeInt(object.firstFileID + static_cast<int>(i));
+        sink.write("}\n");
     }
 
-    body << "  m_Layer: " << definition.layer << "\n";
-    body << "  m_Name: " << quoteIfNeeded(definition.name) << "\n";
-    body << "  m_TagString: " << quoteIfNeeded(definition.tagString) << "\n";
-    body << "  m_Icon: {fileID: 0}\n";
-    body << "  m_NavMeshLayer: 0\n";
-    body << "  m_StaticEditorFlags: 0\n";
-    body << "  m_IsActive: " << (definition.isActive ? 1 : 0) << "\n";
+    sink.write("  m_Layer: ");
+    sink.writeInt(definition.layer);
+    sink.write("\n  m_Name: ");
+    sink.writeQuotedIfNeeded(definition.name);
+    sink.write("\n  m_TagString: ");
+    sink.writeQuotedIfNeeded(definition.tagString);
+    sink.write("\n");
+    sink.write("  m_Icon: {fileID: 0}\n");
+    sink.write("  m_NavMeshLayer: 0\n");
+    sink.write("  m_StaticEditorFlags: 0\n");
+    sink.write("  m_IsActive: ");
+    sink.write(definition.isActive ? '1' : '0');
+    sink.write("\n\n");
+}
 
-    return body.str();
+std::size_t SceneBuilder::estimateSize() const {
+    std::size_t bytes = 64;
+    for (const auto& document : documents_) {
+        bytes += document.tag.size() + document.body.size() + 16;
+    }
+    bytes += objects_.size() * kGameObjectDocumentBytes + componentCount_ * kComponentDocumentBytes;
+    return bytes;
 }
 
-std::string SceneBuilder::stripTagPrefix(const std::string& tag) {
+std::string_view SceneBuilder::stripTagPrefix(std::string_view tag) {
     const auto delimiter = tag.find_last_of('!');
-    if (delimiter == std::string::npos) {
+    if (delimiter == std::string_view::npos) {
         return tag;
     }
     return tag.substr(delimiter + 1);
 }
 
 ComponentDefinition makeTransformComponent(Vector3 position, Quaternion rotation, Vector3 scale) {
-    return ComponentDefinition{
-        "!u!4",
-        "Transform",
-        [position, rotation, scale](int fileID) {
-            std::ostringstream body;
-            body << "Transform:\n";
-            body << "  m_ObjectHideFlags: 0\n";
-            body << "  m_PrefabParentObject: {fileID: 0}\n";
-            body << "  m_PrefabInternal: {fileID: 0}\n";
-            body << "  m_GameObject: {fileID: " << fileID << "}\n";
-            body << "  m_LocalRotation: " << formatQuaternion(rotation) << "\n";
-            body << "  m_LocalPosition: " << formatVector3(position) << "\n";
-            body << "  m_LocalScale: " << formatVector3(scale) << "\n";
-            body << "  m_Children: []\n";
-            body << "  m_Father: {fileID: 0}\n";
-            return body.str();
-        }
+    ComponentDefinition component;
+    component.tag = "!u!4";
+    component.typeName = "Transform";
+    component.bodyWriter = [position, rotation, scale](YamlSink& sink, int fileID) {
+        sink.write("Transform:\n");
+        sink.write("  m_ObjectHideFlags: 0\n");
+        sink.write("  m_PrefabParentObject: {fileID: 0}\n");
+        sink.write("  m_PrefabInternal: {fileID: 0}\n");
+        sink.write("  m_GameObject: {fileID: ");
+        sink.writeInt(fileID);
+        sink.write("}\n  m_LocalRotation: ");
+        sink.writeQuaternion(rotation);
+        sink.write("\n  m_LocalPosition: ");
+        sink.writeVector3(position);
+        sink.write("\n  m_LocalScale: ");
+        sink.writeVector3(scale);
+        sink.write("\n");
+        sink.write("  m_Children: []\n");
+        sink.write("  m_Father: {fileID: 0}\n");
     };
+    return component;
 }
 
 ComponentDefinition makeCameraComponent(float nearClip, float farClip, float fieldOfView, int clearFlags) {
-    return ComponentDefinition{
-        "!u!20",
-        "Camera",
-        [=](int fileID) {
-            std::ostringstream body;
-            body << "Camera:\n";
-            body << "  m_ObjectHideFlags: 0\n";
-            body << "  m_PrefabParentObject: {fileID: 0}\n";
-            body << "  m_PrefabInternal: {fileID: 0}\n";
-            body << "  m_GameObject: {fileID: " << fileID << "}\n";
-            body << "  m_Enabled: 1\n";
-            body << "  m_ClearFlags: " << clearFlags << "\n";
-            body << "  m_BackGroundColor: {r: 0.0, g: 0.0, b: 0.0, a: 0.0}\n";
-            body << "  near clip plane: " << nearClip << "\n";
-            body << "  far clip plane: " << farClip << "\n";
-            body << "  field of view: " << fieldOfView << "\n";
-            body << "  orthographic: 0\n";
-            body << "  orthographic size: 100.0\n";
-            body << "  m_Depth: -1.0\n";
-            body << "  m_CullingMask:\n";
-            body << "    importerVersion: 2\n";
-            body << "    m_Bits: 4294967295\n";
-            body << "  m_RenderingPath: -1\n";
-            body << "  m_TargetTexture: {fileID: 0}\n";
-            body << "  m_HDR: 0\n";
-            return body.str();
-        }
+    ComponentDefinition component;
+    component.tag = "!u!20";
+    component.typeName = "Camera";
+    component.bodyWriter = [=](YamlSink& sink, int fileID) {
+        sink.write("Camera:\n");
+        sink.write("  m_ObjectHideFlags: 0\n");
+        sink.write("  m_PrefabParentObject: {fileID: 0}\n");
+        sink.write("  m_PrefabInternal: {fileID: 0}\n");
+        sink.write("  m_GameObject: {fileID: ");
+        sink.writeInt(fileID);
+        sink.write("}\n");
+        sink.write("  m_Enabled: 1\n");
+        sink.write("  m_ClearFlags: ");
+        sink.writeInt(clearFlags);
+        sink.write("\n");
+        sink.write("  m_BackGroundColor: {r: 0.0, g: 0.0, b: 0.0, a: 0.0}\n");
+        sink.write("  near clip plane: ");
+        sink.writeGeneral(nearClip);
+        sink.write("\n  far clip plane: ");
+        sink.writeGeneral(farClip);
+        sink.write("\n  field of view: ");
+        sink.writeGeneral(fieldOfView);
+        sink.write("\n");
+        sink.write("  orthographic: 0\n");
+        sink.write("  orthographic size: 100.0\n");
+        sink.write("  m_Depth: -1.0\n");
+        sink.write("  m_CullingMask:\n");
+        sink.write("    importerVersion: 2\n");
+        sink.write("    m_Bits: 4294967295\n");
+        sink.write("  m_RenderingPath: -1\n");
+        sink.write("  m_TargetTexture: {fileID: 0}\n");
+        sink.write("  m_HDR: 0\n");
     };
+    return component;
 }
 
 ComponentDefinition makeRendererComponent(const std::string& meshFileID, const std::string& materialGuid) {
-    return ComponentDefinition{
-        "!u!23",
-        "Renderer",
-        [=](int fileID) {
-            std::ostringstream body;
-            body << "Renderer:\n";
-            body << "  m_ObjectHideFlags: 0\n";
-            body << "  m_PrefabParentObject: {fileID: 0}\n";
-            body << "  m_PrefabInternal: {fileID: 0}\n";
-            body << "  m_GameObject: {fileID: " << fileID << "}\n";
-            body << "  m_Enabled: 1\n";
-            body << "  m_CastShadows: 1\n";
-            body << "  m_ReceiveShadows: 1\n";
-            body << "  m_LightmapIndex: 255\n";
-            body << "  m_LightmapTilingOffset: {x: 1.000000, y: 1.000000, z: 0.000000, w: 0.000000}\n";
-            body << "  m_Materials:\n";
-            body << "  - {fileID: " << meshFileID << ", guid: " << materialGuid << ", type: 0}\n";
-            body << "  m_SubsetIndices: \n";
-            body << "  m_StaticBatchRoot: {fileID: 0}\n";
-            body << "  m_LightProbeAnchor: {fileID: 0}\n";
-            body << "  m_UseLightProbes: 0\n";
-            body << "  m_ScaleInLightmap: 1.000000\n";
-            return body.str();
-        }
+    ComponentDefinition component;
+    component.tag = "!u!23";
+    component.typeName = "Renderer";
+    component.bodyWriter = [=](YamlSink& sink, int fileID) {
+        sink.write("Renderer:\n");
+        sink.write("  m_ObjectHideFlags: 0\n");
+        sink.write("  m_PrefabParentObject: {fileID: 0}\n");
+        sink.write("  m_PrefabInternal: {fileID: 0}\n");
+        sink.write("  m_GameObject: {fileID: ");
+        sink.writeInt(fileID);
+        sink.write("}\n");
+        sink.write("  m_Enabled: 1\n");
+        sink.write("  m_CastShadows: 1\n");
+        sink.write("  m_ReceiveShadows: 1\n");
+        sink.write("  m_LightmapIndex: 255\n");
+        sink.write("  m_LightmapTilingOffset: {x: 1.000000, y: 1.000000, z: 0.000000, w: 0.000000}\n");
+        sink.write("  m_Materials:\n");
+        sink.write("  - {fileID: ");
+        sink.write(meshFileID);
+        sink.write(", guid: ");
+        sink.write(materialGuid);
+        sink.write(", type: 0}\n");
+        sink.write("  m_SubsetIndices: \n");
+        sink.write("  m_StaticBatchRoot: {fileID: 0}\n");
+        sink.write("  m_LightProbeAnchor: {fileID: 0}\n");
+        sink.write("  m_UseLightProbes: 0\n");
+        sink.write("  m_ScaleInLightmap: 1.000000\n");
     };
+    return component;
 }
 
 ComponentDefinition makeBoxColliderComponent(Vector3 size, Vector3 center) {
-    return ComponentDefinition{
-        "!u!65",
-        "BoxCollider",
-        [=](int fileID) {
-            std::ostringstream body;
-            body << "BoxCollider:\n";
-            body << "  m_ObjectHideFlags: 0\n";
-            body << "  m_PrefabParentObject: {fileID: 0}\n";
-            body << "  m_PrefabInternal: {fileID: 0}\n";
-            body << "  m_GameObject: {fileID: " << fileID << "}\n";
-            body << "  m_Material: {fileID: 0}\n";
-            body << "  m_IsTrigger: 0\n";
-            body << "  m_Enabled: 1\n";
-            body << "  importerVersion: 2\n";
-            body << "  m_Size: " << formatVector3(size) << "\n";
-            body << "  m_Center: " << formatVector3(center) << "\n";
-            return body.str();
-        }
+    ComponentDefinition component;
+    component.tag = "!u!65";
+    component.typeName = "BoxCollider";
+    component.bodyWriter = [=](YamlSink& sink, int fileID) {
+        sink.write("BoxCollider:\n");
+        sink.write("  m_ObjectHideFlags: 0\n");
+        sink.write("  m_PrefabParentObject: {fileID: 0}\n");
+        sink.write("  m_PrefabInternal: {fileID: 0}\n");
+        sink.write("  m_GameObject: {fileID: ");
+        sink.writeInt(fileID);
+        sink.write("}\n");
+        sink.write("  m_Material: {fileID: 0}\n");
+        sink.write("  m_IsTrigger: 0\n");
+        sink.write("  m_Enabled: 1\n");
+        sink.write("  importerVersion: 2\n");
+        sink.write("  m_Size: ");
+        sink.writeVector3(size);
+        sink.write("\n  m_Center: ");
+        sink.writeVector3(center);
+        sink.write("\n");
     };
+    return component;
 }
 
 std::string formatVector3(const Vector3& value) {
-    std::ostringstream stream;
-    stream << "{x: " << std::fixed << std::setprecision(6) << value.x
-           << ", y: " << value.y
-           << ", z: " << value.z << "}";
-    return stream.str();
+    YamlSink sink;
+    sink.writeVector3(value);
+    return sink.release();
 }
 
 std::string formatQuaternion(const Quaternion& value) {
-    std::ostringstream stream;
-    stream << "{x: " << std::fixed << std::setprecision(6) << value.x
-           << ", y: " << value.y
-           << ", z: " << value.z
-           << ", w: " << value.w << "}";
-    return stream.str();
+    YamlSink sink;
+    sink.writeQuaternion(value);
+    return sink.release();
 }
 
 std::string quoteIfNeeded(const std::string& raw) {
-    if (raw.find_first_of(" \t\n\r:") != std::string::npos) {
-        std::ostringstream stream;
-        stream << '"' << raw << '"';
-        return stream.str();
-    }
-    return raw;
+    YamlSink sink;
+    sink.writeQuotedIfNeeded(raw);
+    return sink.release();
 }
 
 } // namespace UnityTooling
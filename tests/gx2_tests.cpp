@@ -0,0 +1,266 @@
+#include "SlLib/Utilities/Gx2Util.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using SlLib::Utilities::Gx2Image;
+using SlLib::Utilities::Gx2LevelLayout;
+using SlLib::Utilities::Gx2Surface;
+using SlLib::Utilities::Gx2Util;
+
+// Wii U addrlib with 2 pipes, 4 banks and 256-byte groups. For a 2D_THIN1 macro tile (32x16 elements) the
+// four 8x8 micro tiles in each 16x16 quadrant land in their own pipe/bank channel:
+//   pipe = (x/8 ^ y/8) & 1
+//   bank = ((y/32 ^ x/8) & 1) | 2 * ((y/16 ^ x/16) & 1)
+// and address bits 8-10 hold (bank << 1 | pipe). Inside a micro tile, elements are ordered by the bit
+// interleave for their size; micro tiles larger than a group continue 0x800 bytes on, above the channel bits.
+std::uint32_t ChannelOffset(std::uint32_t x, std::uint32_t y)
+{
+    const std::uint32_t pipe = ((x >> 3) ^ (y >> 3)) & 1;
+    const std::uint32_t bank = (((y >> 5) ^ (x >> 3)) & 1) | (2 * (((y >> 4) ^ (x >> 4)) & 1));
+    return ((bank << 1) | pipe) << 8;
+}
+
+// 32bpp: x0 x1 y0 x2 y1 y2.
+std::uint32_t PixelIndex32(std::uint32_t x, std::uint32_t y)
+{
+    return (x & 1) | ((x >> 1) & 1) << 1 | (y & 1) << 2 | ((x >> 2) & 1) << 3 | ((y >> 1) & 1) << 4 |
+           ((y >> 2) & 1) << 5;
+}
+
+// 64bpp: x0 y0 x1 x2 y1 y2.
+std::uint32_t PixelIndex64(std::uint32_t x, std::uint32_t y)
+{
+    return (x & 1) | (y & 1) << 1 | ((x >> 1) & 1) << 2 | ((x >> 2) & 1) << 3 | ((y >> 1) & 1) << 4 |
+           ((y >> 2) & 1) << 5;
+}
+
+std::uint32_t Split(std::uint32_t elementOffset)
+{
+    return (elementOffset & 0xFF) | ((elementOffset & ~0xFFu) << 3);
+}
+
+// 2D_THIN1 macro tiles are 2048 bytes at 32bpp and 4096 bytes at 64bpp, laid out row-major by pitch.
+std::uint32_t Thin1Address32(std::uint32_t x, std::uint32_t y, std::uint32_t pitch)
+{
+    const std::uint32_t macroTile = x / 32 + (pitch / 32) * (y / 16);
+    return macroTile * 2048 + ChannelOffset(x, y) + Split(PixelIndex32(x & 7, y & 7) * 4);
+}
+
+std::uint32_t Thin1Address64(std::uint32_t x, std::uint32_t y, std::uint32_t pitch)
+{
+    const std::uint32_t macroTile = x / 32 + (pitch / 32) * (y / 16);
+    return macroTile * 4096 + ChannelOffset(x, y) + Split(PixelIndex64(x & 7, y & 7) * 8);
+}
+
+// 1D_THIN1: 256-byte micro tiles row-major by pitch.
+std::uint32_t MicroAddress32(std::uint32_t x, std::uint32_t y, std::uint32_t pitch)
+{
+    return ((x / 8) + (pitch / 8) * (y / 8)) * 256 + PixelIndex32(x & 7, y & 7) * 4;
+}
+
+std::uint8_t Pattern(std::uint32_t level, std::uint32_t x, std::uint32_t y, std::uint32_t byte)
+{
+    return static_cast<std::uint8_t>(x * 7 + y * 31 + byte * 3 + level * 101 + (x ^ y) * 17);
+}
+
+Gx2Surface MakeSurface(std::uint32_t format, std::uint32_t width, std::uint32_t height, std::uint32_t mipLevels)
+{
+    Gx2Surface surface;
+    surface.Dim = 1;
+    surface.Width = width;
+    surface.Height = height;
+    surface.MipLevels = mipLevels;
+    surface.Format = format;
+    surface.Use = 1;
+    surface.TileMode = 4; // 2D_THIN1
+    return surface;
+}
+
+bool TestBc1Thin1AddressesMatchHandDerived()
+{
+    // 64x64 BC1 is 16x16 blocks of 8 bytes, padded to one 32x16 macro tile.
+    const Gx2Surface surface = MakeSurface(0x31, 64, 64, 1);
+    Gx2LevelLayout layout;
+    std::string error;
+    if (!Gx2Util::ComputeLevelLayout(surface, 0, layout, error))
+        return false;
+    if (layout.TileMode != 4 || layout.Width != 16 || layout.Height != 16 || layout.Pitch != 32 ||
+        layout.PaddedHeight != 16 || layout.Size != 4096)
+        return false;
+
+    // Spot checks worked through by hand.
+    struct Expected
+    {
+        std::uint32_t X, Y, Address;
+    };
+    for (Expected const& e : {Expected{0, 0, 0x000},
+                              Expected{1, 0, 0x008},
+                              Expected{0, 1, 0x010},
+                              Expected{8, 0, 0x300},
+                              Expected{0, 8, 0x100},
+                              Expected{8, 8, 0x200},
+                              Expected{0, 4, 0x800},
+                              Expected{7, 7, 0x8F8}})
+    {
+        if (Gx2Util::ComputeElementAddress(surface, layout, e.X, e.Y, 0) != e.Address)
+            return false;
+    }
+    for (std::uint32_t y = 0; y < 16; ++y)
+        for (std::uint32_t x = 0; x < 16; ++x)
+            if (Gx2Util::ComputeElementAddress(surface, layout, x, y, 0) != Thin1Address64(x, y, 32))
+                return false;
+    return true;
+}
+
+bool TestBc1Thin1Untile()
+{
+    Gx2Surface surface = MakeSurface(0x31, 64, 64, 1);
+    surface.ImageSize = 4096;
+
+    std::vector<std::uint8_t> tiled(4096, 0xCD);
+    std::vector<std::uint8_t> expected;
+    for (std::uint32_t y = 0; y < 16; ++y)
+    {
+        for (std::uint32_t x = 0; x < 16; ++x)
+        {
+            for (std::uint32_t b = 0; b < 8; ++b)
+            {
+                tiled[Thin1Address64(x, y, 32) + b] = Pattern(0, x, y, b);
+                expected.push_back(Pattern(0, x, y, b));
+            }
+        }
+    }
+
+    for (std::size_t threads : {std::size_t{1}, std::size_t{4}})
+    {
+        Gx2Image image;
+        std::string error;
+        if (!Gx2Util::Convert(surface, tiled, {}, image, error, threads))
+            return false;
+        if (image.Format != SlLib::Utilities::DdsFormat::BC1 || !image.BlockCompressed || image.BytesPerElement != 8)
+            return false;
+        if (image.Data != expected)
+            return false;
+    }
+    return true;
+}
+
+bool TestRgba8Thin1WithMipsUntile()
+{
+    // Levels 0 and 1 stay 2D_THIN1; from 16x16 down the chain degrades to 1D_THIN1 with 8-element alignment.
+    struct Level
+    {
+        std::uint32_t Size, TileMode, Pitch, Bytes;
+    };
+    const Level levels[] = {{64, 4, 64, 16384}, {32, 4, 32, 4096}, {16, 2, 16, 1024}, {8, 2, 8, 256}, {4, 2, 8, 256}};
+
+    Gx2Surface surface = MakeSurface(0x1A, 64, 64, 5);
+    surface.ImageSize = 16384;
+    surface.MipSize = 4096 + 1024 + 256 + 256;
+    surface.MipOffsets[0] = 16384; // level 1, counted from the start of the image data
+    surface.MipOffsets[1] = 4096;
+    surface.MipOffsets[2] = 4096 + 1024;
+    surface.MipOffsets[3] = 4096 + 1024 + 256;
+
+    std::vector<std::uint8_t> imageData(surface.ImageSize, 0xEE);
+    std::vector<std::uint8_t> mipData(surface.MipSize, 0xEE);
+    std::vector<std::uint8_t> expected;
+    std::size_t mipOffset = 0;
+    for (std::uint32_t level = 0; level < 5; ++level)
+    {
+        Level const& info = levels[level];
+        Gx2LevelLayout layout;
+        std::string error;
+        if (!Gx2Util::ComputeLevelLayout(surface, level, layout, error))
+            return false;
+        if (layout.TileMode != info.TileMode || layout.Pitch != info.Pitch || layout.Size != info.Bytes ||
+            layout.Offset != (level == 0 ? 0 : mipOffset))
+            return false;
+
+        std::vector<std::uint8_t>& target = level == 0 ? imageData : mipData;
+        const std::size_t base = level == 0 ? 0 : mipOffset;
+        for (std::uint32_t y = 0; y < info.Size; ++y)
+        {
+            for (std::uint32_t x = 0; x < info.Size; ++x)
+            {
+                const std::uint32_t address =
+                    info.TileMode == 4 ? Thin1Address32(x, y, info.Pitch) : MicroAddress32(x, y, info.Pitch);
+                if (Gx2Util::ComputeElementAddress(surface, layout, x, y, 0) != address)
+                    return false;
+                for (std::uint32_t b = 0; b < 4; ++b)
+                {
+                    target[base + address + b] = Pattern(level, x, y, b);
+                    expected.push_back(Pattern(level, x, y, b));
+                }
+            }
+        }
+        if (level > 0)
+            mipOffset += info.Bytes;
+    }
+
+    // A few level 0 addresses worked through by hand: second micro tile column (pipe 1, bank 1), the next
+    // macro tile along the row, and one a macro tile row down.
+    Gx2LevelLayout level0;
+    std::string error;
+    Gx2Util::ComputeLevelLayout(surface, 0, level0, error);
+    if (Gx2Util::ComputeElementAddress(surface, level0, 8, 0, 0) != 0x300 ||
+        Gx2Util::ComputeElementAddress(surface, level0, 32, 0, 0) != 0x800 ||
+        Gx2Util::ComputeElementAddress(surface, level0, 40, 16, 0) != 0x1F00 ||
+        Gx2Util::ComputeElementAddress(surface, level0, 3, 5, 0) != 0x9C)
+        return false;
+
+    for (std::size_t threads : {std::size_t{1}, std::size_t{3}})
+    {
+        Gx2Image image;
+        if (!Gx2Util::Convert(surface, imageData, mipData, image, error, threads))
+            return false;
+        if (image.Format != SlLib::Utilities::DdsFormat::RGBA8 || image.MipLevels != 5 || image.Data != expected)
+            return false;
+    }
+    return true;
+}
+
+bool TestConvertRejectsShortMipData()
+{
+    Gx2Surface surface = MakeSurface(0x1A, 64, 64, 2);
+    surface.ImageSize = 16384;
+    surface.MipOffsets[0] = 16384;
+    std::vector<std::uint8_t> imageData(16384);
+    std::vector<std::uint8_t> mipData(4095);
+    Gx2Image image;
+    std::string error;
+    return !Gx2Util::Convert(surface, imageData, mipData, image, error) && !error.empty();
+}
+
+} // namespace
+
+int main()
+{
+    int failures = 0;
+    auto run = [&](const char* name, bool (*test)()) {
+        if (!test())
+        {
+            std::cerr << "[FAIL] " << name << std::endl;
+            ++failures;
+        }
+        else
+        {
+            std::cout << "[PASS] " << name << std::endl;
+        }
+    };
+
+    run("TestBc1Thin1AddressesMatchHandDerived", TestBc1Thin1AddressesMatchHandDerived);
+    run("TestBc1Thin1Untile", TestBc1Thin1Untile);
+    run("TestRgba8Thin1WithMipsUntile", TestRgba8Thin1WithMipsUntile);
+    run("TestConvertRejectsShortMipData", TestConvertRejectsShortMipData);
+
+    if (failures != 0)
+        return 1;
+
+    return 0;
+}
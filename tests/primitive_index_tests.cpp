@@ -0,0 +1,101 @@
+#include "SeEditor/Forest/ForestTypes.hpp"
+#include "SeEditor/Forest/PrimitiveIndices.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+using SeEditor::Forest::PrimitiveIndexFormat;
+using SeEditor::Forest::SuRenderPrimitive;
+
+void AppendU16(std::vector<std::uint8_t>& data, std::uint16_t value, bool bigEndian)
+{
+    if (bigEndian)
+    {
+        data.push_back(static_cast<std::uint8_t>((value >> 8) & 0xFFu));
+        data.push_back(static_cast<std::uint8_t>(value & 0xFFu));
+    }
+    else
+    {
+        data.push_back(static_cast<std::uint8_t>(value & 0xFFu));
+        data.push_back(static_cast<std::uint8_t>((value >> 8) & 0xFFu));
+    }
+}
+
+bool TestBigEndianStripWithRestart()
+{
+    // Strip 0,1,2,3 | restart | 4,5,6 with 7 vertices, stored big-endian.
+    SuRenderPrimitive prim;
+    for (std::uint16_t idx : {0, 1, 2, 3, 0xFFFF, 4, 5, 6})
+        AppendU16(prim.IndexData, idx, true);
+    prim.NumIndices = 8;
+
+    auto decoded = SeEditor::Forest::GetDecodedPrimitiveIndices(prim, 7);
+    if (decoded->Layout.Format != PrimitiveIndexFormat::U16BE || !decoded->Layout.IsStrip)
+        return false;
+    if (decoded->Layout.Restart != 1 || decoded->Layout.Droppable != 0)
+        return false;
+
+    const std::vector<std::uint32_t> expected = {0, 1, 2, 2, 1, 3, 4, 5, 6};
+    return decoded->Triangles == expected;
+}
+
+bool TestListDropsOutOfRange()
+{
+    SuRenderPrimitive prim;
+    for (std::uint16_t idx : {0, 1, 2, 2, 9, 3})
+        AppendU16(prim.IndexData, idx, false);
+    prim.NumIndices = 6;
+    prim.Unknown_0x9c = 4;
+
+    auto decoded = SeEditor::Forest::GetDecodedPrimitiveIndices(prim, 4);
+    if (decoded->Layout.Format != PrimitiveIndexFormat::U16LE || decoded->Layout.IsStrip)
+        return false;
+    const std::vector<std::uint32_t> expected = {0, 1, 2, 2, 3};
+    return decoded->Triangles == expected && decoded->Layout.Droppable == 1;
+}
+
+bool TestDecodeIsCachedPerVertexLimit()
+{
+    SuRenderPrimitive prim;
+    for (std::uint16_t idx : {0, 1, 2})
+        AppendU16(prim.IndexData, idx, false);
+    prim.Unknown_0x9c = 4;
+
+    auto first = SeEditor::Forest::GetDecodedPrimitiveIndices(prim, 3);
+    auto second = SeEditor::Forest::GetDecodedPrimitiveIndices(prim, 3);
+    if (first != second)
+        return false;
+    auto other = SeEditor::Forest::GetDecodedPrimitiveIndices(prim, 2);
+    return other != first && other->Triangles.size() == 2;
+}
+
+} // namespace
+
+int main()
+{
+    int failures = 0;
+
+    auto run = [&](const char* name, bool (*test)()) {
+        if (!test())
+        {
+            std::cerr << "[FAIL] " << name << std::endl;
+            ++failures;
+        }
+        else
+        {
+            std::cout << "[PASS] " << name << std::endl;
+        }
+    };
+
+    run("TestBigEndianStripWithRestart", TestBigEndianStripWithRestart);
+    run("TestListDropsOutOfRange", TestListDropsOutOfRange);
+    run("TestDecodeIsCachedPerVertexLimit", TestDecodeIsCachedPerVertexLimit);
+
+    if (failures != 0)
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include "SlLib/Resources/Database/SlResourceDatabase.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+using SlLib::Resources::Database::SlNodeHandle;
+using SlLib::Resources::Database::SlResourceChunk;
+using SlLib::Resources::Database::SlResourceDatabase;
+using SlLib::Resources::Database::SlResourceType;
+using SlLib::Resources::Scene::SeNodeBase;
+
+std::unique_ptr<SeNodeBase> MakeNode(int uid)
+{
+    auto node = std::make_unique<SeNodeBase>();
+    node->Uid = uid;
+    return node;
+}
+
+SlResourceChunk MakeChunk(int id, std::string name)
+{
+    return SlResourceChunk(SlResourceType::Invalid, id, std::move(name), true);
+}
+
+bool TestRemovedHandleDoesNotResolve()
+{
+    SlResourceDatabase database;
+    SlNodeHandle first = database.AddOwnedNode(MakeNode(10));
+    SlNodeHandle second = database.AddOwnedNode(MakeNode(20));
+    if (database.GetNode(first) == nullptr || database.FindNode(20) != database.GetNode(second))
+        return false;
+
+    database.RemoveNode(first);
+    if (database.GetNode(first) != nullptr || database.FindNode(10) != nullptr)
+        return false;
+
+    // The freed slot is reused; the old handle must not see the new node.
+    SlNodeHandle reused = database.AddOwnedNode(MakeNode(30));
+    if (reused.Index != first.Index || reused == first)
+        return false;
+    if (database.GetNode(first) != nullptr || database.GetNode(reused) == nullptr)
+        return false;
+
+    database.RemoveNode(20);
+    return database.GetNode(second) == nullptr && database.OwnedNodeCount() == 1;
+}
+
+bool TestClearInvalidatesHandles()
+{
+    SlResourceDatabase database;
+    SlNodeHandle a = database.AddOwnedNode(MakeNode(1));
+    SlNodeHandle b = database.AddOwnedNode(MakeNode(2));
+    database.RemoveNode(b);
+    SlNodeHandle c = database.AddOwnedNode(MakeNode(3));
+
+    database.ClearOwnedNodes();
+    if (database.OwnedNodeCount() != 0 || database.FindNode(1) != nullptr || database.GetNode(a) != nullptr)
+        return false;
+
+    // Refill every slot; none of the handles taken before the clear may resolve.
+    SlNodeHandle d = database.AddOwnedNode(MakeNode(4));
+    SlNodeHandle e = database.AddOwnedNode(MakeNode(5));
+    for (SlNodeHandle old : {a, b, c})
+    {
+        if (database.GetNode(old) != nullptr)
+            return false;
+    }
+    return database.GetNode(d) != nullptr && database.GetNode(e) != nullptr &&
+           database.FindNode(5) == database.GetNode(e);
+}
+
+bool TestChunkLookupsAfterAddAndRemove()
+{
+    SlResourceDatabase database;
+    database.AddChunk(MakeChunk(1, "alpha"));
+    database.AddChunk(MakeChunk(2, "beta"));
+    database.AddChunk(MakeChunk(1, "alpha_dup"));
+    database.AddChunk(MakeChunk(3, "gamma"));
+
+    // First match wins, as with the old front-to-back scan.
+    SlResourceChunk* byId = database.FindChunkById(1);
+    if (byId == nullptr || byId->Name != "alpha")
+        return false;
+    if (database.FindChunkByName("gamma") == nullptr || database.FindChunkByName("gamma")->Id != 3)
+        return false;
+
+    // Removing the first match uncovers the duplicate; later chunks are still found after shifting down.
+    if (!database.RemoveChunk(0) || database.GetChunks().size() != 3)
+        return false;
+    byId = database.FindChunkById(1);
+    if (byId == nullptr || byId->Name != "alpha_dup" || database.FindChunkByName("alpha") != nullptr)
+        return false;
+    SlResourceChunk const* gamma = &database.GetChunks()[2];
+    if (database.FindChunkById(3) != gamma || database.FindChunkByName("gamma") != gamma)
+        return false;
+
+    if (!database.RemoveChunkById(2) || database.FindChunkById(2) != nullptr ||
+        database.FindChunkByName("beta") != nullptr)
+        return false;
+    if (database.RemoveChunkById(2) || database.RemoveChunk(5))
+        return false;
+
+    database.AddChunk(MakeChunk(2, "beta"));
+    if (database.FindChunkByName("beta") == nullptr || database.FindChunkById(2)->Name != "beta")
+        return false;
+
+    database.ClearChunks();
+    return database.GetChunks().empty() && database.FindChunkById(1) == nullptr &&
+           database.FindChunkByName("gamma") == nullptr;
+}
+
+} // namespace
+
+int main()
+{
+    int failures = 0;
+    auto run = [&](const char* name, bool (*test)()) {
+        if (!test())
+        {
+            std::cerr << "[FAIL] " << name << std::endl;
+            ++failures;
+        }
+        else
+        {
+            std::cout << "[PASS] " << name << std::endl;
+        }
+    };
+
+    run("TestRemovedHandleDoesNotResolve", TestRemovedHandleDoesNotResolve);
+    run("TestClearInvalidatesHandles", TestClearInvalidatesHandles);
+    run("TestChunkLookupsAfterAddAndRemove", TestChunkLookupsAfterAddAndRemove);
+
+    if (failures != 0)
+        return 1;
+
+    return 0;
+}
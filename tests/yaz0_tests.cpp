@@ -0,0 +1,333 @@
+#include "SlLib.MarioKart/Yaz0.hpp"
+#include "SlLib.MarioKart/Yaz0Stream.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <ios>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace yaz0 = SlLib::MarioKart::yaz0;
+
+// Header for `decodedSize` bytes followed by the raw stream bytes.
+std::vector<std::uint8_t> MakeStream(std::uint32_t decodedSize, std::initializer_list<std::uint8_t> body)
+{
+    std::vector<std::uint8_t> data = {'Y', 'a', 'z', '0'};
+    for (int shift = 24; shift >= 0; shift -= 8)
+        data.push_back(static_cast<std::uint8_t>((decodedSize >> shift) & 0xFFu));
+    data.resize(yaz0::HeaderSize, 0);
+    data.insert(data.end(), body);
+    return data;
+}
+
+std::vector<std::uint8_t> Bytes(std::string const& text)
+{
+    return {text.begin(), text.end()};
+}
+
+// Text runs, a long zero fill and noise, larger than the window so matches reach across it.
+std::vector<std::uint8_t> MakeSample()
+{
+    std::vector<std::uint8_t> data;
+    const std::string phrase = "The quick brown fox jumps over the lazy dog. ";
+    for (int i = 0; i < 200; ++i)
+        data.insert(data.end(), phrase.begin(), phrase.begin() + static_cast<std::ptrdiff_t>(phrase.size() - i % 7));
+    data.insert(data.end(), 0x900, 0);
+    std::uint32_t state = 0x12345678u;
+    for (int i = 0; i < 0x1800; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        data.push_back(static_cast<std::uint8_t>(state >> 24));
+    }
+    // Repeat a stretch of the noise further back than most matches reach.
+    data.insert(data.end(), data.end() - 0xF00, data.end() - 0x100);
+    return data;
+}
+
+bool ThrowsMessage(std::vector<std::uint8_t> const& stream, std::string const& message)
+{
+    try
+    {
+        yaz0::Decode(stream);
+    }
+    catch (std::runtime_error const& e)
+    {
+        return e.what() == message;
+    }
+    return false;
+}
+
+bool TestRoundTripEachEffort()
+{
+    const std::vector<std::uint8_t> sample = MakeSample();
+    for (yaz0::Effort effort : {yaz0::Effort::Store, yaz0::Effort::Fast, yaz0::Effort::Normal, yaz0::Effort::Best})
+    {
+        for (std::size_t size : {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{300}, sample.size()})
+        {
+            std::vector<std::uint8_t> input(sample.begin(), sample.begin() + static_cast<std::ptrdiff_t>(size));
+            std::vector<std::uint8_t> encoded = yaz0::Encode(input, effort);
+            if (!yaz0::HasHeader(encoded) || yaz0::DecodedSize(encoded) != size)
+                return false;
+            if (encoded.size() > yaz0::EncodedUpperBound(size))
+                return false;
+            if (yaz0::Decode(encoded) != input)
+                return false;
+        }
+    }
+    return true;
+}
+
+bool TestCompressingEffortsShrinkSample()
+{
+    const std::vector<std::uint8_t> sample = MakeSample();
+    const std::size_t stored = yaz0::Encode(sample, yaz0::Effort::Store).size();
+    const std::size_t fast = yaz0::Encode(sample, yaz0::Effort::Fast).size();
+    const std::size_t best = yaz0::Encode(sample, yaz0::Effort::Best).size();
+    return fast < stored && best <= fast;
+}
+
+bool TestOverlappingMatchDistance1()
+{
+    // 'a', then 5 bytes from 1 back.
+    auto stream = MakeStream(6, {0x80, 'a', 0x30, 0x00});
+    return yaz0::Decode(stream) == Bytes("aaaaaa");
+}
+
+bool TestOverlappingMatchDistance2()
+{
+    // 'a', 'b', then 6 bytes from 2 back.
+    auto stream = MakeStream(8, {0xC0, 'a', 'b', 0x40, 0x01});
+    return yaz0::Decode(stream) == Bytes("abababab");
+}
+
+bool TestOverlappingMatchDistance7()
+{
+    // Seven literals, then a long-form match of 0x12 + 2 = 20 bytes from 7 back.
+    auto stream = MakeStream(27, {0xFE, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 0x00, 0x06, 0x02});
+    std::vector<std::uint8_t> decoded(27);
+    yaz0::DecodeInto(stream, decoded);
+    return decoded == Bytes("abcdefgabcdefgabcdefgabcdef") && yaz0::Decode(stream) == decoded;
+}
+
+bool TestTruncatedAtGroupEnd()
+{
+    // A full group of eight literals, but the header promises a ninth byte and no code byte follows.
+    auto stream = MakeStream(9, {0xFF, '0', '1', '2', '3', '4', '5', '6', '7'});
+    return ThrowsMessage(stream, "Yaz0 stream is truncated.");
+}
+
+bool TestBackReferenceBeforeStart()
+{
+    // One literal, then a match from 2 back.
+    auto stream = MakeStream(4, {0x80, 'a', 0x10, 0x01});
+    return ThrowsMessage(stream, "Yaz0 back-reference points before the start of the output.");
+}
+
+// Larger than several laps of an 8 KiB ring, with repeats up to a full window back so that many
+// back-references start in the previous lap.
+std::vector<std::uint8_t> MakeLongSample()
+{
+    std::vector<std::uint8_t> data = MakeSample();
+    for (std::size_t distance : {std::size_t{0x1000}, std::size_t{0xFFF}, std::size_t{0x7F3}, std::size_t{3}})
+    {
+        for (int i = 0; i < 0x1500; ++i)
+            data.push_back(static_cast<std::uint8_t>(data[data.size() - distance] ^ (i % 97 == 0 ? 0x5A : 0)));
+    }
+    return data;
+}
+
+bool TestStreamSmallRingAcrossLaps()
+{
+    const std::vector<std::uint8_t> sample = MakeLongSample();
+    const std::vector<std::uint8_t> encoded = yaz0::Encode(sample, yaz0::Effort::Best);
+    std::vector<std::uint8_t> ring(2 * yaz0::WindowSize);
+    yaz0::StreamDecoder decoder(encoded, ring);
+
+    std::vector<std::uint8_t> decoded;
+    std::vector<std::uint8_t> chunk(1000);
+    while (std::size_t count = decoder.Read(chunk))
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            decoded.push_back(chunk[i]);
+        if (decoder.Position() != decoded.size())
+            return false;
+    }
+    return decoder.Done() && decoded == sample && sample.size() > 4 * ring.size();
+}
+
+bool TestStreamRejectsUnusableRing()
+{
+    const std::vector<std::uint8_t> encoded = yaz0::Encode(Bytes("abc"));
+    std::vector<std::uint8_t> small(yaz0::WindowSize);
+    std::vector<std::uint8_t> odd(3 * yaz0::WindowSize);
+    for (auto* ring : {&small, &odd})
+    {
+        try
+        {
+            yaz0::StreamDecoder decoder(encoded, *ring);
+            return false;
+        }
+        catch (std::invalid_argument const&)
+        {
+        }
+    }
+    return true;
+}
+
+bool TestStreamNextSmallMaxBytes()
+{
+    const std::vector<std::uint8_t> sample = MakeSample();
+    const std::vector<std::uint8_t> encoded = yaz0::Encode(sample, yaz0::Effort::Fast);
+    yaz0::StreamDecoder decoder(encoded);
+
+    std::vector<std::uint8_t> decoded;
+    std::size_t maxBytes = 1;
+    for (auto run = decoder.Next(maxBytes); !run.empty(); run = decoder.Next(maxBytes))
+    {
+        if (run.size() > maxBytes)
+            return false;
+        decoded.insert(decoded.end(), run.begin(), run.end());
+        maxBytes = maxBytes % 5 + 1;
+    }
+    return decoded == sample && decoder.Done() && decoder.Next(3).empty();
+}
+
+bool TestStreamErrorsMatchDecode()
+{
+    const auto truncatedStream = MakeStream(9, {0xFF, '0', '1', '2', '3', '4', '5', '6', '7'});
+    yaz0::StreamDecoder truncated(truncatedStream);
+    std::vector<std::uint8_t> output(9);
+    try
+    {
+        truncated.Read(output);
+        return false;
+    }
+    catch (std::runtime_error const& e)
+    {
+        if (std::string(e.what()) != "Yaz0 stream is truncated.")
+            return false;
+    }
+
+    const auto backwardsStream = MakeStream(4, {0x80, 'a', 0x10, 0x01});
+    yaz0::StreamDecoder backwards(backwardsStream);
+    try
+    {
+        backwards.Read(output);
+        return false;
+    }
+    catch (std::runtime_error const& e)
+    {
+        return std::string(e.what()) == "Yaz0 back-reference points before the start of the output.";
+    }
+}
+
+bool TestInputStreamReadGetSeek()
+{
+    const std::vector<std::uint8_t> sample = MakeLongSample();
+    const std::vector<std::uint8_t> encoded = yaz0::Encode(sample, yaz0::Effort::Normal);
+    std::vector<std::uint8_t> ring(2 * yaz0::WindowSize);
+    yaz0::InputStream stream(encoded, ring);
+    if (stream.DecodedSize() != sample.size())
+        return false;
+
+    // get() fills the get area with the first batch; small reads and seeks then stay inside it.
+    if (stream.get() != sample[0])
+        return false;
+    char buffer[16];
+    if (!stream.read(buffer, sizeof(buffer)) || std::vector<std::uint8_t>(buffer, buffer + 16) !=
+                                                     std::vector<std::uint8_t>(sample.begin() + 1, sample.begin() + 17))
+        return false;
+    if (!stream.seekg(5) || stream.get() != sample[5])
+        return false;
+    if (!stream.seekg(100, std::ios_base::cur) || stream.tellg() != 106 || stream.get() != sample[106])
+        return false;
+    if (!stream.seekg(-2, std::ios_base::cur) || stream.get() != sample[105])
+        return false;
+
+    // Forward past the get area: decoded and discarded.
+    const std::streamoff far = 3 * static_cast<std::streamoff>(ring.size()) + 17;
+    if (!stream.seekg(far) || stream.tellg() != far || stream.get() != sample[static_cast<std::size_t>(far)])
+        return false;
+    if (!stream.read(buffer, 4) || static_cast<std::uint8_t>(buffer[3]) != sample[static_cast<std::size_t>(far) + 4])
+        return false;
+
+    // Large reads bypass the get area and still land on the right bytes.
+    std::vector<char> large(ring.size() + 123);
+    if (!stream.read(large.data(), static_cast<std::streamsize>(large.size())))
+        return false;
+    for (std::size_t i = 0; i < large.size(); ++i)
+    {
+        if (static_cast<std::uint8_t>(large[i]) != sample[static_cast<std::size_t>(far) + 5 + i])
+            return false;
+    }
+
+    // The end is reported as EOF.
+    if (!stream.seekg(0, std::ios_base::end) || stream.get() != std::char_traits<char>::eof())
+        return false;
+    return stream.eof();
+}
+
+bool TestInputStreamSeekBeforeGetAreaFails()
+{
+    const std::vector<std::uint8_t> sample = MakeLongSample();
+    const std::vector<std::uint8_t> encoded = yaz0::Encode(sample, yaz0::Effort::Fast);
+    std::vector<std::uint8_t> ring(2 * yaz0::WindowSize);
+    yaz0::InputStream stream(encoded, ring);
+
+    const std::streamoff middle = 2 * static_cast<std::streamoff>(ring.size()) + 9;
+    if (!stream.seekg(middle) || stream.get() != sample[static_cast<std::size_t>(middle)])
+        return false;
+    // Already decoded and dropped: the seek fails and the stream reports it.
+    stream.seekg(100);
+    return stream.fail();
+}
+
+} // namespace
+
+int main()
+{
+    int failures = 0;
+    auto run = [&](const char* name, bool (*test)()) {
+        bool passed = false;
+        try
+        {
+            passed = test();
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "[EXCEPTION] " << name << ": " << e.what() << std::endl;
+        }
+        if (!passed)
+        {
+            std::cerr << "[FAIL] " << name << std::endl;
+            ++failures;
+        }
+        else
+        {
+            std::cout << "[PASS] " << name << std::endl;
+        }
+    };
+
+    run("TestRoundTripEachEffort", TestRoundTripEachEffort);
+    run("TestCompressingEffortsShrinkSample", TestCompressingEffortsShrinkSample);
+    run("TestOverlappingMatchDistance1", TestOverlappingMatchDistance1);
+    run("TestOverlappingMatchDistance2", TestOverlappingMatchDistance2);
+    run("TestOverlappingMatchDistance7", TestOverlappingMatchDistance7);
+    run("TestTruncatedAtGroupEnd", TestTruncatedAtGroupEnd);
+    run("TestBackReferenceBeforeStart", TestBackReferenceBeforeStart);
+    run("TestStreamSmallRingAcrossLaps", TestStreamSmallRingAcrossLaps);
+    run("TestStreamRejectsUnusableRing", TestStreamRejectsUnusableRing);
+    run("TestStreamNextSmallMaxBytes", TestStreamNextSmallMaxBytes);
+    run("TestStreamErrorsMatchDecode", TestStreamErrorsMatchDecode);
+    run("TestInputStreamReadGetSeek", TestInputStreamReadGetSeek);
+    run("TestInputStreamSeekBeforeGetAreaFails", TestInputStreamSeekBeforeGetAreaFails);
+
+    if (failures != 0)
+        return 1;
+
+    return 0;
+}